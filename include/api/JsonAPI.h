@@ -170,6 +170,13 @@ private:
 	///
 	void handleSysInfoCommand(const QJsonObject &message, const JsonApiCommand& cmd);
 
+	///
+	/// Handle an incoming JSON Metrics message (processing latency histograms)
+	///
+	/// @param message the incoming message
+	///
+	void handleMetricsCommand(const QJsonObject &message, const JsonApiCommand& cmd);
+
 	///
 	/// Handle an incoming JSON Server info message
 	///
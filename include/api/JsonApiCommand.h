@@ -27,6 +27,7 @@ public:
 		LedColors,
 		LedDevice,
 		Logging,
+		Metrics,
 		Processing,
 		ServerInfo,
 		Service,
@@ -58,6 +59,7 @@ public:
 		case LedColors: return "ledcolors";
 		case LedDevice: return "leddevice";
 		case Logging: return "logging";
+		case Metrics: return "metrics";
 		case Processing: return "processing";
 		case ServerInfo: return "serverinfo";
 		case SourceSelect: return "sourceselect";
@@ -340,6 +342,7 @@ public:
 			{ {"leddevice", "identify"},                 { Command::LedDevice,      SubCommand::Identify,                Authorization::Yes,    InstanceCmd::No,           InstanceCmd::MustRun_No,     NoListenerCmd::Yes } },
 			{ {"logging", "start"},                      { Command::Logging,        SubCommand::Start,                   Authorization::Yes,    InstanceCmd::No,           InstanceCmd::MustRun_No,     NoListenerCmd::Yes } },
 			{ {"logging", "stop"},                       { Command::Logging,        SubCommand::Stop,                    Authorization::Yes,    InstanceCmd::No,           InstanceCmd::MustRun_No,     NoListenerCmd::Yes } },
+			{ {"metrics", ""},                           { Command::Metrics,        SubCommand::Empty,                   Authorization::Yes,    InstanceCmd::No,           InstanceCmd::MustRun_No,     NoListenerCmd::Yes } },
 			{ {"processing", ""},                        { Command::Processing,     SubCommand::Empty,                   Authorization::Yes,    InstanceCmd::Multi,        InstanceCmd::MustRun_Yes,    NoListenerCmd::Yes } },
 			{ {"serverinfo", ""},                        { Command::ServerInfo,     SubCommand::Empty,                   Authorization::Yes,    InstanceCmd::No_or_Single, InstanceCmd::MustRun_Yes,    NoListenerCmd::Yes } },
 			{ {"serverinfo", "getInfo"},                 { Command::ServerInfo,     SubCommand::GetInfo,                 Authorization::Yes,    InstanceCmd::No_or_Single, InstanceCmd::MustRun_No,     NoListenerCmd::Yes } },
@@ -80,13 +80,13 @@ namespace hyperion
 				return true;
 			}
 
-			if (_detectionMode == "default") {
+			if (_detectionMode == QLatin1String("default")) {
 				imageBorder = _detector->process(image);
-			} else if (_detectionMode == "classic") {
+			} else if (_detectionMode == QLatin1String("classic")) {
 				imageBorder = _detector->process_classic(image);
-			} else if (_detectionMode == "osd") {
+			} else if (_detectionMode == QLatin1String("osd")) {
 				imageBorder = _detector->process_osd(image);
-			} else if (_detectionMode == "letterbox") {
+			} else if (_detectionMode == QLatin1String("letterbox")) {
 				imageBorder = _detector->process_letterbox(image);
 			}
 			// add blur to the border
@@ -52,7 +52,8 @@ public:
 		PixelFormat pixelFormat, uint8_t* sharedData,
 		int size, int width, int height, int lineLength,
 		int cropLeft, int cropTop, int cropBottom, int cropRight,
-		VideoMode videoMode, FlipMode flipMode, int pixelDecimation);
+		VideoMode videoMode, FlipMode flipMode, int pixelDecimation,
+		qint64 captureTime_ns);
 
 	void process();
 
@@ -71,6 +72,7 @@ private:
 	int	_lineLength;
 	int	_currentFrame;
 	int	_pixelDecimation;
+	qint64 _captureTime_ns;
 	unsigned long _size;
 	int	_cropLeft;
 	int _cropTop;
@@ -119,14 +121,16 @@ public:
 		PixelFormat pixelFormat, uint8_t* sharedData,
 		int size, int width, int height, int lineLength,
 		int cropLeft, int cropTop, int cropBottom, int cropRight,
-		VideoMode videoMode, FlipMode flipMode, int pixelDecimation)
+		VideoMode videoMode, FlipMode flipMode, int pixelDecimation,
+		qint64 captureTime_ns)
 	{
 		auto encThread = qobject_cast<EncoderThread*>(_thread);
 		if (encThread != nullptr)
 			encThread->setup(pixelFormat, sharedData,
 				size, width, height, lineLength,
 				cropLeft, cropTop, cropBottom, cropRight,
-				videoMode, flipMode, pixelDecimation);
+				videoMode, flipMode, pixelDecimation,
+				captureTime_ns);
 	}
 
 	bool isBusy()
@@ -112,7 +112,7 @@ private:
 	void uninit_device();
 	void start_capturing();
 	void stop_capturing();
-	bool process_image(const void *p, int size);
+	bool process_image(const void *p, int size, qint64 captureTime_ns);
 	int xioctl(int request, void *arg);
 	int xioctl(int fileDescriptor, int request, void *arg);
 
@@ -1,11 +1,14 @@
 #pragma once
 
 #include <QLoggingCategory>
+#include <QMap>
+#include <QSharedPointer>
 
 #include <utils/Logger.h>
 #include <utils/settings.h>
 #include <utils/Components.h>
 #include <utils/Image.h>
+#include <utils/FrameMailbox.h>
 
 Q_DECLARE_LOGGING_CATEGORY(capturectl_screen_flow);
 Q_DECLARE_LOGGING_CATEGORY(capturectl_video_flow);
@@ -13,6 +16,7 @@ Q_DECLARE_LOGGING_CATEGORY(capturectl_audio_flow);
 
 class Hyperion;
 class QTimer;
+class GlobalSignals;
 
 ///
 /// @brief Capture Control class which is a interface to the HyperionDaemon native capture classes.
@@ -39,6 +43,12 @@ public:
 	///
 	void stop();
 
+	///
+	/// @brief Get the counters of the images captured per capture priority
+	/// @return The counters of the capture inputs images were received from
+	///
+	QMap<int, FrameCounters> getImageCounters() const;
+
 private slots:
 	///
 	/// @brief Handle component state change of Video- (V4L/MF) and Screen capture
@@ -89,6 +99,37 @@ private slots:
 
 
 private:
+	///
+	/// @brief A captured image and the name of its source
+	///
+	struct CapturedImage
+	{
+		QString name;
+		Image<ColorRgb> image;
+	};
+
+	/// Inbox slots of the capture inputs
+	enum CaptureSlot
+	{
+		SCREEN_CAPTURE,
+		VIDEO_CAPTURE,
+		AUDIO_CAPTURE,
+		CAPTURE_SLOTS
+	};
+
+	///
+	/// @brief Connect a capture signal to the inbox, the handler gets the latest image only
+	/// @param signal   The GlobalSignals capture signal
+	/// @param slot     The inbox slot of the capture input
+	///
+	void connectCapture(void (GlobalSignals::*signal)(const QString&, const Image<ColorRgb>&), CaptureSlot slot);
+
+	///
+	/// @brief Forward the latest image captured to its handler
+	/// @param slot     The inbox slot of the capture input
+	///
+	void deliverImage(int slot);
+
 	/// Hyperion instance pointer
 	QWeakPointer<Hyperion> _hyperionWeak;
 
@@ -109,4 +150,7 @@ private:
 	int _audioCapturePriority;
 	QString _audioCaptureName;
 	QScopedPointer<QTimer> _audioCaptureInactiveTimer;
+
+	/// latest images captured per capture input
+	QSharedPointer<FrameInbox<CapturedImage>> _imageInbox;
 };
@@ -3,12 +3,16 @@
 
 // Qt includes
 #include <QString>
+#include <QSharedPointer>
 
 // Utils includes
 #include <utils/RgbChannelAdjustment.h>
 #include <utils/RgbTransform.h>
 #include <utils/OkhsvTransform.h>
 
+// Hyperion includes
+#include <hyperion/ColorLut.h>
+
 class ColorAdjustment
 {
 public:
@@ -34,6 +38,9 @@ public:
 
 	RgbTransform _rgbTransform;
 	OkhsvTransform _okhsvTransform;
+
+	/// The adjustment baked into a lookup table, null while it is (re-)baked. The adjustment is then calculated per LED.
+	QSharedPointer<const hyperion::ColorLut> _lut;
 };
 
 #endif // COLORADJUSTMENT_H
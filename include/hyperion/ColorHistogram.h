@@ -0,0 +1,134 @@
+#ifndef COLORHISTOGRAM_H
+#define COLORHISTOGRAM_H
+
+// STL includes
+#include <cstdint>
+#include <vector>
+
+namespace hyperion
+{
+	///
+	/// Quantised 3D color histogram used to determine the dominant color of an image area.
+	///
+	/// Colors are counted in bins of 2^bitsPerChannel levels per channel. The most frequent bin
+	/// is then refined to an exact color by counting the colors inside that bin only.
+	/// Both count tables are preallocated and tagged with a generation, so a reset between LED areas
+	/// only increments the generation instead of clearing the tables.
+	///
+	class ColorHistogram
+	{
+	public:
+		static constexpr int MIN_BITS_PER_CHANNEL = 3;
+		static constexpr int MAX_BITS_PER_CHANNEL = 6;
+		static constexpr int DEFAULT_BITS_PER_CHANNEL = 5;
+
+		///
+		/// @param[in] bitsPerChannel Number of bits per color channel used for the bins
+		///
+		explicit ColorHistogram(int bitsPerChannel = DEFAULT_BITS_PER_CHANNEL);
+
+		int bitsPerChannel() const { return _bits; }
+
+		///
+		/// @return The histogram owned by the calling thread, (re-)created with the given resolution if required
+		///
+		static ColorHistogram& threadLocal(int bitsPerChannel);
+
+		///
+		/// Clears all bins (and the refinement counts)
+		///
+		void reset()
+		{
+			_bins.reset();
+			_colors.reset();
+		}
+
+		///
+		/// @return The bin a color falls into
+		///
+		uint32_t bin(uint8_t red, uint8_t green, uint8_t blue) const
+		{
+			return (static_cast<uint32_t>(red >> _shift) << (2 * _bits))
+				 | (static_cast<uint32_t>(green >> _shift) << _bits)
+				 | static_cast<uint32_t>(blue >> _shift);
+		}
+
+		///
+		/// Counts a color in the given bin
+		///
+		/// @return The updated count of the bin
+		///
+		uint32_t addToBin(uint32_t bin) { return _bins.add(bin); }
+
+		///
+		/// Starts the refinement of a bin to an exact color
+		///
+		void resetRefinement() { _colors.reset(); }
+
+		///
+		/// Counts an exact color inside the bin being refined
+		///
+		/// @return The updated count of the color
+		///
+		uint32_t addToRefinement(uint8_t red, uint8_t green, uint8_t blue)
+		{
+			const uint32_t mask = (1U << _shift) - 1;
+			return _colors.add(((red & mask) << (2 * _shift)) | ((green & mask) << _shift) | (blue & mask));
+		}
+
+	private:
+		///
+		/// Count table with generation tagged entries. Entries not tagged with the current generation count as zero.
+		///
+		class Counters
+		{
+		public:
+			explicit Counters(uint32_t size);
+
+			void reset()
+			{
+				if (++_generation == 0)
+				{
+					// Generation overflow, invalidate all entries once
+					clear();
+				}
+			}
+
+			uint32_t add(uint32_t idx)
+			{
+				Entry& entry = _entries[idx];
+				if (entry.generation != _generation)
+				{
+					entry.generation = _generation;
+					entry.count = 0;
+				}
+				return ++entry.count;
+			}
+
+		private:
+			void clear();
+
+			struct Entry
+			{
+				uint32_t generation;
+				uint32_t count;
+			};
+
+			std::vector<Entry> _entries;
+			uint32_t _generation;
+		};
+
+		/// Bits per channel of the bins
+		int _bits;
+		/// Bits per channel of the colors inside a bin
+		int _shift;
+
+		/// Counts per bin
+		Counters _bins;
+		/// Counts per exact color inside the bin being refined
+		Counters _colors;
+	};
+
+} // end namespace hyperion
+
+#endif // COLORHISTOGRAM_H
@@ -0,0 +1,161 @@
+#ifndef COLORLUT_H
+#define COLORLUT_H
+
+// STL includes
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <QSharedPointer>
+
+// hyperion-utils includes
+#include <utils/ColorRgb.h>
+
+class ColorAdjustment;
+
+namespace hyperion
+{
+	///
+	/// A ColorAdjustment baked into a 3D lookup table.
+	///
+	/// The table covers the gamma correction, the RGB/CMY/W channel adjustments, brightness and temperature.
+	/// Colors between the grid points are interpolated tetrahedrally. The backlight is not part of the table,
+	/// as it is switched per component and therefore applied per LED.
+	///
+	/// Without OkHSV transform, the table is indexed by the gamma corrected color, i.e. the gamma is applied exactly
+	/// and the nearly linear channel adjustments are interpolated on a 33³ grid. With OkHSV transform, the table is
+	/// indexed by the raw color on a 65³ grid.
+	///
+	class ColorLut
+	{
+	public:
+		///
+		/// The settings of a ColorAdjustment which are baked into a table
+		///
+		struct Settings
+		{
+			explicit Settings(const ColorAdjustment& adjustment);
+
+			bool operator==(const Settings& other) const;
+			bool operator!=(const Settings& other) const { return !(*this == other); }
+
+			/// black, white, red, green, blue, cyan, magenta, yellow
+			std::array<ColorRgb, 8> channels;
+			std::array<double, 3> gamma;
+			std::array<uint8_t, 3> brightness;
+			int temperature;
+			double saturationGain;
+			double brightnessGain;
+		};
+
+		///
+		/// Bakes the table for an adjustment, runs some milliseconds (33³) up to some hundred milliseconds (65³)
+		///
+		/// @param[in] adjustment A copy of the ColorAdjustment to be baked
+		///
+		/// @return The table
+		///
+		static QSharedPointer<const ColorLut> bake(ColorAdjustment adjustment);
+
+		///
+		/// @return The settings the table was baked for
+		///
+		const Settings& settings() const { return _settings; }
+
+		///
+		/// @return The number of grid points per dimension
+		///
+		int gridSize() const { return _gridSize; }
+
+		///
+		/// Looks up the adjusted color
+		///
+		/// @param[in,out] color The raw color, adjusted in place
+		///
+		inline void apply(ColorRgb& color) const
+		{
+			const uint32_t base = _offset[0][color.red] + _offset[1][color.green] + _offset[2][color.blue];
+			const int fr = _fraction[0][color.red];
+			const int fg = _fraction[1][color.green];
+			const int fb = _fraction[2][color.blue];
+
+			// Select the tetrahedron of the grid cell containing the color, its corners are interpolated
+			uint32_t first;
+			uint32_t second;
+			int w0, w1, w2, w3;
+			if (fr >= fg)
+			{
+				if (fg >= fb)
+				{
+					first = _strideR; second = _strideR + _strideG;
+					w0 = 256 - fr; w1 = fr - fg; w2 = fg - fb; w3 = fb;
+				}
+				else if (fr >= fb)
+				{
+					first = _strideR; second = _strideR + 1;
+					w0 = 256 - fr; w1 = fr - fb; w2 = fb - fg; w3 = fg;
+				}
+				else
+				{
+					first = 1; second = _strideR + 1;
+					w0 = 256 - fb; w1 = fb - fr; w2 = fr - fg; w3 = fg;
+				}
+			}
+			else
+			{
+				if (fb >= fg)
+				{
+					first = 1; second = _strideG + 1;
+					w0 = 256 - fb; w1 = fb - fg; w2 = fg - fr; w3 = fr;
+				}
+				else if (fb >= fr)
+				{
+					first = _strideG; second = _strideG + 1;
+					w0 = 256 - fg; w1 = fg - fb; w2 = fb - fr; w3 = fr;
+				}
+				else
+				{
+					first = _strideG; second = _strideR + _strideG;
+					w0 = 256 - fg; w1 = fg - fr; w2 = fr - fb; w3 = fb;
+				}
+			}
+
+			const ColorRgb* const cell = _table.data() + base;
+			const ColorRgb& c0 = cell[0];
+			const ColorRgb& c1 = cell[first];
+			const ColorRgb& c2 = cell[second];
+			const ColorRgb& c3 = cell[_strideR + _strideG + 1];
+			color.red = static_cast<uint8_t>((c0.red * w0 + c1.red * w1 + c2.red * w2 + c3.red * w3 + 128) >> 8);
+			color.green = static_cast<uint8_t>((c0.green * w0 + c1.green * w1 + c2.green * w2 + c3.green * w3 + 128) >> 8);
+			color.blue = static_cast<uint8_t>((c0.blue * w0 + c1.blue * w1 + c2.blue * w2 + c3.blue * w3 + 128) >> 8);
+		}
+
+	private:
+		ColorLut(const Settings& settings, int gridSize);
+
+		///
+		/// @param[in] node The index of a grid point
+		/// @return The (input) channel value of the grid point
+		///
+		uint8_t nodeValue(int node) const;
+
+		Settings _settings;
+
+		/// Grid points per dimension
+		int _gridSize;
+		/// Channel values between two grid points, the last cell is one narrower as it ends at 255
+		int _step;
+		uint32_t _strideR;
+		uint32_t _strideG;
+
+		/// Table offset of the lower grid point per channel and channel value
+		uint32_t _offset[3][256];
+		/// Position between the lower and the upper grid point (0..256) per channel and channel value
+		uint16_t _fraction[3][256];
+
+		/// The adjusted colors of the grid points, blue varying fastest
+		std::vector<ColorRgb> _table;
+	};
+} // end namespace hyperion
+
+#endif // COLORLUT_H
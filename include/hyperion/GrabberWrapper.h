@@ -17,6 +17,7 @@
 #include <utils/PixelFormat.h>
 #include <utils/settings.h>
 #include <utils/VideoStandard.h>
+#include <utils/LatencyMetrics.h>
 
 #include <grabber/GrabberType.h>
 
@@ -119,7 +120,12 @@ public:
 			_image.resize(w, h);
 		}
 
-		int ret = grabber.grabFrame(_image);
+		int ret = 0;
+		{
+			const LatencyTimer timer(_grabLatency.data());
+			_image.setCaptureTime(LatencyMetrics::monotonicTime_ns());
+			ret = grabber.grabFrame(_image);
+		}
 		if (ret >= 0)
 		{
 			emit systemImage(_grabberName, _image);
@@ -216,4 +222,7 @@ private:
 
 	/// The image used for grabbing frames
 	Image<ColorRgb> _image;
+
+	/// Duration of grabbing a frame
+	QSharedPointer<LatencyHistogram> _grabLatency;
 };
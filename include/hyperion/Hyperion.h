@@ -4,6 +4,7 @@
 #include <list>
 #include <chrono>
 #include <atomic>
+#include <functional>
 
 // QT includes
 #include <QString>
@@ -19,6 +20,7 @@
 #include <QSharedPointer>
 #include <QThread>
 #include <QTimer>
+#include <QElapsedTimer>
 #include <QLoggingCategory>
 
 // hyperion-utils includes
@@ -26,12 +28,18 @@
 #include <utils/ColorRgb.h>
 #include <utils/Components.h>
 #include <utils/VideoMode.h>
+#include <utils/LatencyMetrics.h>
+#include <utils/FrameMailbox.h>
+#include <utils/ThreadUtils.h>
 
 // Hyperion includes
 #include <hyperion/LedString.h>
 #include <hyperion/PriorityMuxer.h>
 #include <hyperion/MultiColorAdjustment.h>
+#include <hyperion/LedOutputPipeline.h>
+#include <hyperion/ColorLut.h>
 #include <hyperion/ColorAdjustment.h>
+#include <hyperion/LedColorBuffers.h>
 #include <hyperion/ComponentRegister.h>
 
 #include <hyperion/SettingsManager.h>
@@ -109,6 +117,61 @@ public:
 	///
 	QString getActiveDeviceType() const;
 
+	///
+	/// @brief Get the number of frames skipped, as they were identical to the previous frame
+	/// @return The number of skipped static frames since start
+	///
+	quint64 getStaticFramesSkipped() const { return _staticFramesSkippedTotal.load(); }
+
+	///
+	/// @brief An image posted to a priority, see postInputImage()
+	///
+	struct InputImage
+	{
+		Image<ColorRgb> image;
+		int64_t timeout_ms {PriorityMuxer::ENDLESS};
+		bool clearEffect {true};
+	};
+
+	using InputImageInbox = FrameInbox<InputImage>;
+
+	///
+	/// @brief Get the inbox of images posted to the priorities, to be shared with producers in other threads
+	/// @return The inbox
+	///
+	QSharedPointer<InputImageInbox> getInputImageInbox() const { return _inputImageInbox; }
+
+	///
+	/// @brief   Post the current image of a priority (prev registered with registerInput()), from any thread.
+	/// 		 Only the latest image posted is applied, when the instance's thread gets to it.
+	/// @param  priority     The priority to update
+	/// @param  image        The new image
+	/// @param  timeout_ms   The new timeout (defaults to -1 endless)
+	/// @param  clearEffect  Should be true when NOT called from an effect
+	///
+	void postInputImage(int priority, const Image<ColorRgb>& image, int64_t timeout_ms = PriorityMuxer::ENDLESS, bool clearEffect = true);
+
+	///
+	/// @brief   Register an input (see registerInput()) from any thread, in order with the images posted by the
+	/// 		 calling thread: an image posted before is applied ahead of the registration, images posted
+	/// 		 afterwards behind it.
+	///
+	void postRegisterInput(int priority, hyperion::Components component, const QString& origin = "System", const QString& owner = "", unsigned smooth_cfg = 0);
+
+	///
+	/// @brief   Clear a priority (see clear()) from any thread, in order with the images posted by the calling
+	/// 		 thread, i.e. an image posted before the clear does not reappear behind it.
+	/// @param[in] priority  The priority channel. -1 clears all priorities
+	/// @param[in] forceClearAll Force the clear
+	///
+	void postClear(int priority, bool forceClearAll = false);
+
+	///
+	/// @brief Get the counters of images posted per priority, including the capture inputs
+	/// @return The counters of the priorities images were posted to
+	///
+	QMap<int, FrameCounters> getInputImageCounters() const;
+
 public slots:
 
 	///
@@ -369,6 +432,12 @@ public slots:
 
 	int getLatchTime() const;
 
+	///
+	/// @brief Get the write rates and latch statistics of the LED-device
+	/// @return The write statistics
+	///
+	LedDevice::WriteStatistics getLedDeviceWriteStatistics() const;
+
 	///
 	/// @brief Set hyperion in suspend mode or resume from suspend/idle.
 	/// All instances and components will be disabled/enabled.
@@ -471,7 +540,10 @@ signals:
 	///
 	/// @brief Emits whenever new data should be pushed to the LedDeviceWrapper which forwards it to the threaded LedDevice
 	///
-	void ledDeviceData(const QVector<ColorRgb>& ledValues);
+	/// @param[in] ledValues  The RGB-color per LED
+	/// @param[in] captureTime_ns  Monotonic capture time of the input the colors were derived from, 0 if unknown
+	///
+	void ledDeviceData(const QVector<ColorRgb>& ledValues, qint64 captureTime_ns);
 
 	///
 	/// @brief Emits whenever new untransformed ledColos data is available, reflects the current visible device
@@ -515,6 +587,24 @@ private slots:
 	///
 	void handleSourceAvailability(int priority);
 
+	///
+	/// @brief Apply the latest image posted to a priority
+	///	@param priority   The priority
+	///
+	void deliverInputImage(int priority);
+
+	///
+	/// @brief Queue a call into the instance's thread behind the images pending for a priority, from any thread.
+	/// 	   The images are taken from the inbox and applied ahead of the call.
+	///	@param inbox      The inbox of the instance
+	///	@param receiver   Queues the call into the instance's thread
+	///	@param instance   The instance
+	///	@param priority   The priority, all priorities if negative
+	///	@param call       Called in the instance's thread
+	///
+	static void postInputCall(const QSharedPointer<InputImageInbox>& inbox, const QSharedPointer<QueuedReceiver>& receiver,
+							  Hyperion* instance, int priority, const std::function<void()>& call);
+
 	///
 	/// @brief Handle updates requested.
 	///
@@ -534,10 +624,25 @@ private slots:
 	/// Report image processing statistics
 	///
 	void reportImagesProcessedStatistics();
+	///
+	/// @brief Schedule the processing of the current priority input, coalescing pending requests
+	///
+	void scheduleUpdate();
+
 	///
 	/// @brief Process images for output.
 	///
-	void processUpdate();	
+	void processUpdate();
+
+	///
+	/// @brief Checks, if an image is identical to the previously processed one (static frame detection).
+	/// The check uses a hash of sampled rows. A full processing is enforced every STATIC_FRAME_REFRESH_INTERVAL.
+	///
+	/// @param[in] priority  The priority the image was provided for
+	/// @param[in] image  The image to be checked
+	/// @return True, if the image processing can be skipped
+	///
+	bool isStaticFrame(int priority, const Image<ColorRgb>& image);	
 
 signals:
 	void isSetNewComponentState(hyperion::Components component, bool state);
@@ -548,24 +653,28 @@ private:
 	void updateLedLayout(const QJsonArray& ledLayout);
 
 	///
-	/// Applies the blacklist to a vector of LED colors, setting blacklisted LEDs to black.
+	/// Assigns the color lookup tables to the adjustments. Adjustments with unchanged settings keep their table,
+	/// the tables of the others are baked in the background. Until then, their colors are calculated per LED.
 	///
-	/// @param ledColors The vector of LED colors to modify.
-	///
-	void applyBlacklist(QVector<ColorRgb>& ledColors);
+	void updateColorLuts();
 
 	///
-	/// Applies the configured color order to a vector of LED colors.
+	/// Bakes the color lookup table of an adjustment on a worker thread. The result is handed back via handleColorLutBaked().
+	///
+	void bakeColorLutInBackground(const ColorAdjustment& adjustment);
+
 	///
-	/// @param ledColors The vector of LED colors to modify.
+	/// Assigns a table baked in the background to the adjustments whose settings are still the ones baked
 	///
-	void applyColorOrder(QVector<ColorRgb>& ledColors) const;
+	void handleColorLutBaked(const QSharedPointer<const hyperion::ColorLut>& lut);
 
 	///
 	/// Writes the final LED colors to the LED device.
 	/// This involves smoothing and throttling.
 	///
-	void writeToLeds();
+	/// @param[in] captureTime_ns  Monotonic capture time of the input the colors were derived from
+	///
+	void writeToLeds(qint64 captureTime_ns);
 
 	/// instance index
 	const quint8 _instIndex;
@@ -587,6 +696,21 @@ private:
 	/// The adjustment from raw colors to led colors
 	QScopedPointer<MultiColorAdjustment> _raw2ledAdjustment;
 
+	/// Blacklist, color adjustment and color order compiled into a single pass over the LEDs
+	hyperion::LedOutputPipeline _ledOutput;
+
+	/// The color lookup tables assigned to the adjustments
+	QList<QSharedPointer<const hyperion::ColorLut>> _colorLuts;
+
+	/// The settings of the color lookup tables being baked in the background
+	QList<hyperion::ColorLut::Settings> _colorLutsInBake;
+
+	/// Hands the color lookup tables baked in the background over to the instance, shared with the workers
+	QSharedPointer<QueuedReceiver> _colorLutReceiver;
+
+	/// Queues registrations and clears behind the images posted before, shared with the producers
+	QSharedPointer<QueuedReceiver> _inputCallReceiver;
+
 	/// The priority muxer
 	QSharedPointer<PriorityMuxer> _muxer;
 
@@ -625,11 +749,37 @@ private:
 	std::atomic<bool> _isUpdatePending{ false };
 	std::atomic<bool> _isUpdateQueued{ false };
 	
-	// buffer for leds (with adjustment)
-	QVector<ColorRgb> _ledBuffer;
+	// double buffered LED colors as mapped from the image (without adjustment)
+	hyperion::LedColorBuffers _rawLedColors;
+	// double buffered LED colors for the device (with adjustment)
+	hyperion::LedColorBuffers _ledBuffer;
 
 	/// statistics timer
 	QScopedPointer<QTimer> _statisticsTimer;
 	std::atomic<int> _totalImagesProcessed{ 0 };
 	std::atomic<int> _imagesSkipped{ 0 };
+
+	/// static frame detection
+	std::atomic<bool> _isFullUpdateRequired{ true };
+	int _lastFramePriority{ -1 };
+	QSize _lastFrameSize;
+	quint64 _lastFrameHash{ 0 };
+	QElapsedTimer _lastFullUpdateTimer;
+	std::atomic<int> _staticFramesSkipped{ 0 };
+	std::atomic<quint64> _staticFramesSkippedTotal{ 0 };
+
+	/// latest images posted per priority
+	QSharedPointer<InputImageInbox> _inputImageInbox;
+
+	/// processing latencies
+	QSharedPointer<LatencyHistogram> _mappingLatency;
+	QSharedPointer<LatencyHistogram> _adjustmentLatency;
+	QSharedPointer<LatencyHistogram> _endToEndLatency;
+	/// steady clock time the visible input was last updated, 0 if it was processed already
+	std::atomic<int64_t> _inputReceivedTime_ns{ 0 };
+
+	///
+	/// @brief Remembers the time the visible input was updated to determine the end-to-end latency
+	///
+	void markInputReceived();
 };
@@ -1,16 +1,24 @@
 #pragma once
 
+// STL includes
+#include <algorithm>
+#include <optional>
+#include <type_traits>
+
 #include <QString>
 #include <QVector>
+#include <QList>
 #include <QSharedPointer>
 #include <QLoggingCategory>
 
 // Utils includes
 #include <utils/Image.h>
+#include <utils/ThreadUtils.h>
 
 // Hyperion includes
 #include <hyperion/LedString.h>
 #include <hyperion/ImageToLedsMap.h>
+#include <hyperion/ImageToLedsMapCache.h>
 #include <utils/Logger.h>
 
 // settings
@@ -73,6 +81,18 @@ public:
 	/// @param[in] level  The accuracy level (0-4)
 	void setAccuracyLevel(int level);
 
+	///
+	/// Set the number of threads used to determine the LED colors
+	///
+	/// @param[in] threadCount  Number of threads (1 = sequential processing)
+	void setProcessingThreads(int threadCount);
+
+	///
+	/// Set the resolution of the color histogram used for dominant color mappings
+	///
+	/// @param[in] bitsPerChannel  Number of bits per color channel (3-6)
+	void setDominantColorBits(int bitsPerChannel);
+
 	/// Returns the current _userMappingType, this may not be the current applied type!
 	int getUserLedMappingType() const { return _userMappingType; }
 
@@ -138,14 +158,21 @@ public:
 			// Check black border detection
 			verifyBorder(image);
 
+			if (_requestedMapKey.has_value())
+			{
+				colors = QVector<ColorRgb>(_ledString.leds().size(), ColorRgb::BLACK);
+				processWithCurrentMap(image, colors);
+				return colors;
+			}
+
 			// Create a result vector and call the 'in place' function
 			switch (_mappingType)
 			{
 			case 1:
-				colors = _imageToLedColors->getUniLedColor(image);
+				colors = _imageToLedColors->getMeanSqrtLedColor(image);
 				break;
 			case 2:
-				colors = _imageToLedColors->getMeanSqrtLedColor(image);
+				colors = _imageToLedColors->getUniLedColor(image);
 				break;
 			case 3:
 				colors = _imageToLedColors->getDominantLedColor(image);
@@ -159,6 +186,9 @@ public:
 			case 6:
 				colors = _imageToLedColors->getDominantAdvUniLedColor(image);
 				break;
+			case 7:
+				colors = _imageToLedColors->getMeanLedColorIntegral(image);
+				break;
 			default:
 				colors = _imageToLedColors->getMeanLedColor(image);
 			}
@@ -191,30 +221,14 @@ public:
 			// Check black border detection
 			verifyBorder(image);
 
-			// Determine the mean or uni colors of each led (using the existing mapping)
-			switch (_mappingType)
+			if (_requestedMapKey.has_value())
 			{
-			case 1:
-				_imageToLedColors->getUniLedColor(image, ledColors);
-				break;
-			case 2:
-				_imageToLedColors->getMeanSqrtLedColor(image, ledColors);
-				break;
-			case 3:
-				_imageToLedColors->getDominantLedColor(image, ledColors);
-				break;
-			case 4:
-				_imageToLedColors->getDominantUniLedColor(image, ledColors);
-				break;
-			case 5:
-				_imageToLedColors->getDominantAdvLedColor(image, ledColors);
-				break;
-			case 6:
-				_imageToLedColors->getDominantAdvUniLedColor(image, ledColors);
-				break;
-
-			default:
-				_imageToLedColors->getMeanLedColor(image, ledColors);
+				processWithCurrentMap(image, ledColors);
+			}
+			else
+			{
+				// Determine the mean or uni colors of each led (using the existing mapping)
+				mapImage(image, ledColors);
 			}
 		}
 		else
@@ -242,6 +256,122 @@ private:
 		int horizontalBorder,
 		int verticalBorder);
 
+	///
+	/// Requests a mapping for the current LED layout, pixel set factor and accuracy level.
+	/// The size and borders of the pending or current mapping are kept.
+	///
+	void updateProcessingUnit();
+
+	///
+	/// Makes the given mapping the current one
+	///
+	void activateMap(const QSharedPointer<hyperion::ImageToLedsMap>& map);
+
+	///
+	/// Builds the mapping for the given parameters on a worker thread. The result is handed back via handleMapBuilt().
+	///
+	void buildMapInBackground(const hyperion::ImageToLedsMapCache::Key& key);
+
+	///
+	/// Caches a mapping built in the background and swaps it in, if it is still the requested one
+	///
+	void handleMapBuilt(const hyperion::ImageToLedsMapCache::Key& key, const QSharedPointer<hyperion::ImageToLedsMap>& map);
+
+	///
+	/// Determines the led colors of the image with the current mapping (in place)
+	///
+	template <typename Pixel_T>
+	void mapImage(const Image<Pixel_T>& image, QVector<ColorRgb>& ledColors) const
+	{
+		switch (_mappingType)
+		{
+		case 1:
+			_imageToLedColors->getMeanSqrtLedColor(image, ledColors);
+			break;
+		case 2:
+			_imageToLedColors->getUniLedColor(image, ledColors);
+			break;
+		case 3:
+			_imageToLedColors->getDominantLedColor(image, ledColors);
+			break;
+		case 4:
+			_imageToLedColors->getDominantUniLedColor(image, ledColors);
+			break;
+		case 5:
+			_imageToLedColors->getDominantAdvLedColor(image, ledColors);
+			break;
+		case 6:
+			_imageToLedColors->getDominantAdvUniLedColor(image, ledColors);
+			break;
+		case 7:
+			_imageToLedColors->getMeanLedColorIntegral(image, ledColors);
+			break;
+
+		default:
+			_imageToLedColors->getMeanLedColor(image, ledColors);
+		}
+	}
+
+	///
+	/// Determines the led colors with the current mapping while the requested mapping is built in the background.
+	/// The image is scaled (nearest neighbour) to the size of the current mapping and the number of LEDs is clamped,
+	/// LEDs not covered by the current mapping are black.
+	///
+	/// @param[in] image  The image to translate to LED values
+	/// @param[out] ledColors  The color value per LED
+	///
+	template <typename Pixel_T>
+	void processWithCurrentMap(const Image<Pixel_T>& image, QVector<ColorRgb>& ledColors)
+	{
+		static_assert(std::is_same<Pixel_T, ColorRgb>::value, "The scaled image buffer holds RGB pixels only");
+
+		const int mapWidth = _imageToLedColors->width();
+		const int mapHeight = _imageToLedColors->height();
+
+		const Image<Pixel_T>* source = &image;
+		if (image.width() != mapWidth || image.height() != mapHeight)
+		{
+			// The buffer is reused for all frames until the new mapping is swapped in
+			if (_scaledImage.width() != mapWidth || _scaledImage.height() != mapHeight)
+			{
+				_scaledImage.resize(mapWidth, mapHeight);
+			}
+			for (int y = 0; y < mapHeight; ++y)
+			{
+				const int ySource = static_cast<int>(static_cast<int64_t>(y) * image.height() / mapHeight);
+				for (int x = 0; x < mapWidth; ++x)
+				{
+					_scaledImage(x, y) = image(static_cast<int>(static_cast<int64_t>(x) * image.width() / mapWidth), ySource);
+				}
+			}
+			source = &_scaledImage;
+		}
+
+		if (_imageToLedColors->ledCount() == ledColors.size())
+		{
+			mapImage(*source, ledColors);
+		}
+		else
+		{
+			_mappedColors.fill(ColorRgb::BLACK, _imageToLedColors->ledCount());
+			mapImage(*source, _mappedColors);
+			const auto copied = std::copy_n(_mappedColors.cbegin(), qMin(_mappedColors.size(), ledColors.size()), ledColors.begin());
+			std::fill(copied, ledColors.end(), ColorRgb::BLACK);
+		}
+	}
+
+	///
+	/// @return The borders of the requested mapping, which may still be built in the background
+	///
+	int mappedHorizontalBorder() const
+	{
+		return _requestedMapKey.has_value() ? _requestedMapKey->horizontalBorder : _imageToLedColors->horizontalBorder();
+	}
+	int mappedVerticalBorder() const
+	{
+		return _requestedMapKey.has_value() ? _requestedMapKey->verticalBorder : _imageToLedColors->verticalBorder();
+	}
+
 	///
 	/// Performs black-border detection (if enabled) on the given image
 	///
@@ -250,7 +380,7 @@ private:
 	template <typename Pixel_T>
 	void verifyBorder(const Image<Pixel_T> & image)
 	{
-		if (!_borderProcessor->enabled() && ( _imageToLedColors->horizontalBorder()!=0 || _imageToLedColors->verticalBorder()!=0 ))
+		if (!_borderProcessor->enabled() && ( mappedHorizontalBorder()!=0 || mappedVerticalBorder()!=0 ))
 		{
 			Debug(_log, "Black border disabled; resetting to no border");
 			_borderProcessor->process(image);
@@ -268,7 +398,7 @@ private:
 			}
 			else
 			{
-				if (border.horizontalSize != _imageToLedColors->horizontalBorder() || border.verticalSize != _imageToLedColors->verticalBorder())
+				if (border.horizontalSize != mappedHorizontalBorder() || border.verticalSize != mappedVerticalBorder())
 				{
 					qCDebug(imageProcessor_track) << "Detected change in black border setup - horizontal:" << border.horizontalSize << " vertical:" << border.verticalSize;
 					registerProcessingUnit(image.width(), image.height(), border.horizontalSize, border.verticalSize);
@@ -291,12 +421,33 @@ private:
 	/// The Led-string specification
 	LedString _ledString;
 
+	/// Hash of the LED areas of the Led-string
+	size_t _layoutHash;
+
 	/// The processor for black border detection
 	QScopedPointer <hyperion::BlackBorderProcessor> _borderProcessor;
 
 	/// The mapping of image-pixels to LEDs
 	QSharedPointer<hyperion::ImageToLedsMap> _imageToLedColors;
 
+	/// Recently used mappings, reused when returning to a previous image size or border
+	hyperion::ImageToLedsMapCache _imageToLedsMapCache;
+
+	/// Parameters of the mapping being built in the background to replace the current one
+	std::optional<hyperion::ImageToLedsMapCache::Key> _requestedMapKey;
+
+	/// Parameters of the mappings currently built in the background
+	QList<hyperion::ImageToLedsMapCache::Key> _mapKeysInBuild;
+
+	/// Hands the mappings built in the background over to this processor, shared with the workers
+	QSharedPointer<QueuedReceiver> _mapBuildReceiver;
+
+	/// The image scaled to the size of the current mapping, while the requested one is built
+	Image<ColorRgb> _scaledImage;
+
+	/// The LED colors of the current mapping, while the LED count of the requested one differs
+	QVector<ColorRgb> _mappedColors;
+
 	/// Type of image to LED mapping
 	int _mappingType;
 	/// Type of last requested user type
@@ -306,6 +457,8 @@ private:
 
 	int _accuracyLevel;
 	int _reducedPixelSetFactorFactor;
+	int _processingThreads;
+	int _dominantColorBits;
 
 	/// Hyperion instance pointer
 	QWeakPointer<Hyperion> _hyperionWeak;
@@ -7,9 +7,15 @@
 #include <sstream>
 #include <cmath>
 #include <array>
+#include <algorithm>
+#include <type_traits>
+#include <functional>
+#include <chrono>
 
 #include <QVector>
 
+class QThreadPool;
+
 // hyperion-utils includes
 #include <utils/Image.h>
 #include <utils/Logger.h>
@@ -19,8 +25,10 @@
 
 // hyperion includes
 #include <hyperion/LedString.h>
+#include <hyperion/ImageToLedsMapKernels.h>
+#include <hyperion/ColorHistogram.h>
 
-Q_DECLARE_LOGGING_CATEGORY(imageToLedsMap_calc);
+Q_DECLARE_LOGGING_CATEGORY(imageToLedsMap_track);
 Q_DECLARE_LOGGING_CATEGORY(imageToLedsMap_calc);
 
 namespace hyperion
@@ -29,6 +37,10 @@ namespace hyperion
 	/// The ImageToLedsMap holds a mapping of indices into an image to LEDs. It can be used to
 	/// calculate the average (aka mean) or dominant color per LED for a given region.
 	///
+	/// The mapping is stored in a compressed sparse row layout: all LED areas are kept as
+	/// packed pixel spans (row, xBegin, xEnd) in a single array, and each LED references
+	/// its range of spans. This keeps the per frame evaluation on contiguous memory.
+	///
 	class ImageToLedsMap : public QObject
 	{
 		Q_OBJECT
@@ -76,6 +88,11 @@ namespace hyperion
 		///
 		int height() const;
 
+		///
+		/// @return The number of LEDs mapped
+		///
+		int ledCount() const { return static_cast<int>(_ledAreas.size()); }
+
 		int horizontalBorder() const { return _horizontalBorder; }
 		int verticalBorder() const { return _verticalBorder; }
 
@@ -86,6 +103,48 @@ namespace hyperion
 		/// @param[in] level  The accuracy level (0-4)
 		void setAccuracyLevel(int level);
 
+		///
+		/// Set the resolution of the color histogram used during dominant color processing
+		///
+		/// @param[in] bitsPerChannel  Number of bits per color channel (3-6)
+		///
+		void setDominantColorBits(int bitsPerChannel);
+
+		///
+		/// Set the time budget per frame of the dominant color advanced processing.
+		/// When the budget is exceeded, the remaining LEDs are evaluated with a single k-means iteration.
+		/// The budget is disabled per default, the iterations are then only bounded by MAX_KMEANS_ITERATIONS
+		/// and the result depends on the frames processed only. With a budget, it depends on the processing time.
+		///
+		/// @param[in] timeBudget  The time budget (0 = disabled)
+		///
+		void setKMeansTimeBudget(std::chrono::microseconds timeBudget) { _kMeansTimeBudget = timeBudget; }
+
+		///
+		/// Set the kernels used to accumulate contiguous pixel spans during mean color processing.
+		/// Per default the fastest kernels supported by the CPU are used.
+		///
+		/// @param[in] accumulateKernels  The kernels to be used
+		///
+		void setAccumulateKernels(const kernels::AccumulateKernels& accumulateKernels) { _kernels = &accumulateKernels; }
+
+		///
+		/// Set the number of threads used to determine the per LED colors.
+		/// The LEDs are split into chunks of about the same number of pixels, which are processed
+		/// in parallel on the worker pool shared by all instances. Results do not depend on the number of threads.
+		///
+		/// @param[in] threadCount  Number of threads (1 = process sequentially on the calling thread)
+		///
+		void setThreadCount(int threadCount);
+
+		/// @return The number of threads used to determine the per LED colors
+		int threadCount() const { return static_cast<int>(_chunkBounds.size()) - 1; }
+
+		///
+		/// @return The worker pool shared by all LED mappings
+		///
+		static QThreadPool& workerPool();
+
 		///
 		/// Determines the mean color for each LED using the LED area mapping given
 		/// at construction.
@@ -98,7 +157,7 @@ namespace hyperion
 		QVector<ColorRgb> getMeanLedColor(const Image<Pixel_T> &image) const
 		{
 			qCDebug(imageToLedsMap_calc) << "Get Mean Color for image sized" << image.width() << "x" << image.height();
-			QVector<ColorRgb> colors(_colorsMap.size(), ColorRgb{0, 0, 0});
+			QVector<ColorRgb> colors(_ledAreas.size(), ColorRgb{0, 0, 0});
 			getMeanLedColor(image, colors);
 			return colors;
 		}
@@ -114,19 +173,14 @@ namespace hyperion
 		void getMeanLedColor(const Image<Pixel_T> &image, QVector<ColorRgb> &ledColors) const
 		{
 			qCDebug(imageToLedsMap_calc) << "Get Mean Color for image sized" << image.width() << "x" << image.height() << "and #ledColors" << ledColors.size();
-			if (_colorsMap.size() != ledColors.size())
+			if (_ledAreas.size() != ledColors.size())
 			{
-				Debug(_log, "ImageToLedsMap: colorsMap.size != ledColors.size -> %d != %d", _colorsMap.size(), ledColors.size());
+				Debug(_log, "ImageToLedsMap: colorsMap.size != ledColors.size -> %d != %d", _ledAreas.size(), ledColors.size());
 				return;
 			}
 
-			// Iterate each led and compute the mean
-			auto led = ledColors.begin();
-			for (auto colors = _colorsMap.begin(); colors != _colorsMap.end(); ++colors, ++led)
-			{
-				const ColorRgb color = calcMeanColor(image, *colors);
-				*led = color;
-			}
+			// Compute the mean of each led
+			processLeds(ledColors, [&](const LedArea &area) { return calcMeanColor(image, area); });
 
 			qCDebug(imageToLedsMap_calc) << "Get Mean Color completed" << ledColors;
 		}
@@ -143,7 +197,7 @@ namespace hyperion
 		QVector<ColorRgb> getMeanSqrtLedColor(const Image<Pixel_T> &image) const
 		{
 			qCDebug(imageToLedsMap_calc) << "Get Mean Sqrt Color for image sized" << image.width() << "x" << image.height();
-			QVector<ColorRgb> colors(_colorsMap.size(), ColorRgb{0, 0, 0});
+			QVector<ColorRgb> colors(_ledAreas.size(), ColorRgb{0, 0, 0});
 			getMeanSqrtLedColor(image, colors);
 			return colors;
 		}
@@ -159,18 +213,64 @@ namespace hyperion
 		void getMeanSqrtLedColor(const Image<Pixel_T> &image, QVector<ColorRgb> &ledColors) const
 		{
 			qCDebug(imageToLedsMap_calc) << "Get Mean Sqrt Color for image sized" << image.width() << "x" << image.height() << "and #ledColors" << ledColors.size();
-			if (_colorsMap.size() != ledColors.size())
+			if (_ledAreas.size() != ledColors.size())
 			{
-				Debug(_log, "Get Mean Sqrt Color failed. colorsMap.size != ledColors.size -> %d != %d", _colorsMap.size(), ledColors.size());
+				Debug(_log, "Get Mean Sqrt Color failed. colorsMap.size != ledColors.size -> %d != %d", _ledAreas.size(), ledColors.size());
 				return;
 			}
 
-			// Iterate each led and compute the mean
+			// Compute the mean of each led
+			processLeds(ledColors, [&](const LedArea &area) { return calcMeanColorSqrt(image, area); });
+		}
+
+		///
+		/// Determines the mean color for each LED using a summed-area table (integral image) of the given image.
+		/// The integral image is built once per frame, afterwards every LED area is evaluated by four lookups,
+		/// i.e. the processing time depends on the image size and not on the size of the LED areas.
+		/// All pixels of an area are evaluated, the reduced pixel set and the pixels skipped for large areas
+		/// do not apply. The result equals getMeanLedColor() only if no pixels are skipped there.
+		///
+		/// @param[in] image  The image from which to extract the led colors
+		///
+		/// @return The vector containing the output
+		///
+		template <typename Pixel_T>
+		QVector<ColorRgb> getMeanLedColorIntegral(const Image<Pixel_T> &image) const
+		{
+			qCDebug(imageToLedsMap_calc) << "Get Mean Color (integral image) for image sized" << image.width() << "x" << image.height();
+			QVector<ColorRgb> colors(_ledAreas.size(), ColorRgb{0, 0, 0});
+			getMeanLedColorIntegral(image, colors);
+			return colors;
+		}
+
+		///
+		/// Determines the mean color for each LED using a summed-area table (integral image) of the given image.
+		///
+		/// @param[in] image  The image from which to extract the LED colors
+		/// @param[out] ledColors  The vector containing the output
+		///
+		template <typename Pixel_T>
+		void getMeanLedColorIntegral(const Image<Pixel_T> &image, QVector<ColorRgb> &ledColors) const
+		{
+			qCDebug(imageToLedsMap_calc) << "Get Mean Color (integral image) for image sized" << image.width() << "x" << image.height() << "and #ledColors" << ledColors.size();
+			if (_ledRects.size() != ledColors.size())
+			{
+				Debug(_log, "Get Mean Color (integral image) failed. colorsMap.size != ledColors.size -> %d != %d", _ledRects.size(), ledColors.size());
+				return;
+			}
+			if (image.width() != _width || image.height() != _height)
+			{
+				Debug(_log, "Get Mean Color (integral image) failed. Image size %dx%d != mapping size %dx%d", image.width(), image.height(), _width, _height);
+				return;
+			}
+
+			buildIntegralImage(image);
+
 			auto led = ledColors.begin();
-			for (auto colors = _colorsMap.begin(); colors != _colorsMap.end(); ++colors, ++led)
+			for (const LedRect &rect : _ledRects)
 			{
-				const ColorRgb color = calcMeanColorSqrt(image, *colors);
-				*led = color;
+				*led = calcMeanColorIntegral(rect);
+				++led;
 			}
 		}
 
@@ -185,7 +285,7 @@ namespace hyperion
 		QVector<ColorRgb> getUniLedColor(const Image<Pixel_T> &image) const
 		{
 			qCDebug(imageToLedsMap_calc) << "Get Uniform Color for image sized" << image.width() << "x" << image.height();
-			QVector<ColorRgb> colors(_colorsMap.size(), ColorRgb{0, 0, 0});
+			QVector<ColorRgb> colors(_ledAreas.size(), ColorRgb{0, 0, 0});
 			getUniLedColor(image, colors);
 			return colors;
 		}
@@ -200,9 +300,9 @@ namespace hyperion
 		void getUniLedColor(const Image<Pixel_T> &image, QVector<ColorRgb> &ledColors) const
 		{
 			qCDebug(imageToLedsMap_calc) << "Get Uniform Color for image sized" << image.width() << "x" << image.height() << "and #ledColors" << ledColors.size();
-			if (_colorsMap.size() != ledColors.size())
+			if (_ledAreas.size() != ledColors.size())
 			{
-				Debug(_log, "Get Uniform Color failed. colorsMap.size != ledColors.size -> %d != %d", _colorsMap.size(), ledColors.size());
+				Debug(_log, "Get Uniform Color failed. colorsMap.size != ledColors.size -> %d != %d", _ledAreas.size(), ledColors.size());
 				return;
 			}
 
@@ -224,7 +324,7 @@ namespace hyperion
 		QVector<ColorRgb> getDominantLedColor(const Image<Pixel_T> &image) const
 		{
 			qCDebug(imageToLedsMap_calc) << "Get Dominant Color for image sized" << image.width() << "x" << image.height();
-			QVector<ColorRgb> colors(_colorsMap.size(), ColorRgb{0, 0, 0});
+			QVector<ColorRgb> colors(_ledAreas.size(), ColorRgb{0, 0, 0});
 			getDominantLedColor(image, colors);
 			return colors;
 		}
@@ -241,19 +341,14 @@ namespace hyperion
 		{
 			qCDebug(imageToLedsMap_calc) << "Get Dominant Color for image sized" << image.width() << "x" << image.height() << "and #ledColors" << ledColors.size();
 			// Sanity check for the number of LEDs
-			if (_colorsMap.size() != ledColors.size())
+			if (_ledAreas.size() != ledColors.size())
 			{
-				Debug(_log, "Get Dominant Color failed. colorsMap.size != ledColors.size -> %d != %d", _colorsMap.size(), ledColors.size());
+				Debug(_log, "Get Dominant Color failed. colorsMap.size != ledColors.size -> %d != %d", _ledAreas.size(), ledColors.size());
 				return;
 			}
 
-			// Iterate each led and compute the dominant color
-			auto led = ledColors.begin();
-			for (auto colors = _colorsMap.begin(); colors != _colorsMap.end(); ++colors, ++led)
-			{
-				const ColorRgb color = calculateDominantColor(image, *colors);
-				*led = color;
-			}
+			// Compute the dominant color of each led
+			processLeds(ledColors, [&](const LedArea &area) { return calculateDominantColor(image, area); });
 		}
 
 		///
@@ -267,7 +362,7 @@ namespace hyperion
 		QVector<ColorRgb> getDominantUniLedColor(const Image<Pixel_T> &image) const
 		{
 			qCDebug(imageToLedsMap_calc) << "Get Dominant Color Uniform for image sized" << image.width() << "x" << image.height();
-			QVector<ColorRgb> colors(_colorsMap.size(), ColorRgb{0, 0, 0});
+			QVector<ColorRgb> colors(_ledAreas.size(), ColorRgb{0, 0, 0});
 			getDominantUniLedColor(image, colors);
 			return colors;
 		}
@@ -282,9 +377,9 @@ namespace hyperion
 		void getDominantUniLedColor(const Image<Pixel_T> &image, QVector<ColorRgb> &ledColors) const
 		{
 			qCDebug(imageToLedsMap_calc) << "Get Dominant Color Uniform for image sized" << image.width() << "x" << image.height() << "and #ledColors" << ledColors.size();
-			if (_colorsMap.size() != ledColors.size())
+			if (_ledAreas.size() != ledColors.size())
 			{
-				Debug(_log, "Get Dominant Color Uniform failed. colorsMap.size != ledColors.size -> %d != %d", _colorsMap.size(), ledColors.size());
+				Debug(_log, "Get Dominant Color Uniform failed. colorsMap.size != ledColors.size -> %d != %d", _ledAreas.size(), ledColors.size());
 				return;
 			}
 
@@ -306,7 +401,7 @@ namespace hyperion
 		QVector<ColorRgb> getDominantAdvLedColor(const Image<Pixel_T> &image) const
 		{
 			qCDebug(imageToLedsMap_calc) << "Get Dominant Color Advanced for image size" << image.width() << "x" << image.height();
-			QVector<ColorRgb> colors(_colorsMap.size(), ColorRgb{0, 0, 0});
+			QVector<ColorRgb> colors(_ledAreas.size(), ColorRgb{0, 0, 0});
 			getDominantAdvLedColor(image, colors);
 			return colors;
 		}
@@ -323,19 +418,17 @@ namespace hyperion
 		{
 			qCDebug(imageToLedsMap_calc) << "Get Dominant Color Advanced for image sized" << image.width() << "x" << image.height() << "and #ledColors" << ledColors.size();
 			// Sanity check for the number of LEDs
-			if (_colorsMap.size() != ledColors.size())
+			if (_ledAreas.size() != ledColors.size())
 			{
-				Debug(_log, "Get Dominant Color Advanced failed. colorsMap.size != ledColors.size -> %d != %d", _colorsMap.size(), ledColors.size());
+				Debug(_log, "Get Dominant Color Advanced failed. colorsMap.size != ledColors.size -> %d != %d", _ledAreas.size(), ledColors.size());
 				return;
 			}
 
-			// Iterate each led and compute the dominant color
-			auto led = ledColors.begin();
-			for (auto colors = _colorsMap.begin(); colors != _colorsMap.end(); ++colors, ++led)
-			{
-				const ColorRgb color = calculateDominantColorAdv(image, *colors);
-				*led = color;
-			}
+			// Compute the dominant color of each led, the centroids of a LED are at the same index as its area
+			ClusterCentroids *centroids = _clusterCentroids.data();
+			const LedArea *areas = _ledAreas.constData();
+			const auto deadline = kMeansDeadline();
+			processLeds(ledColors, [&](const LedArea &area) { return calculateDominantColorAdv(image, area, centroids[&area - areas], deadline); });
 		}
 
 		///
@@ -349,7 +442,7 @@ namespace hyperion
 		QVector<ColorRgb> getDominantAdvUniLedColor(const Image<Pixel_T> &image) const
 		{
 			qCDebug(imageToLedsMap_calc) << "Get Dominant Color Advanced Uniform for image size" << image.width() << "x" << image.height();
-			QVector<ColorRgb> colors(_colorsMap.size(), ColorRgb{0, 0, 0});
+			QVector<ColorRgb> colors(_ledAreas.size(), ColorRgb{0, 0, 0});
 			getDominantAdvUniLedColor(image, colors);
 			return colors;
 		}
@@ -364,9 +457,9 @@ namespace hyperion
 		void getDominantAdvUniLedColor(const Image<Pixel_T> &image, QVector<ColorRgb> &ledColors) const
 		{
 			qCDebug(imageToLedsMap_calc) << "Get Dominant Color Advanced Uniform for image sized" << image.width() << "x" << image.height() << "and #ledColors" << ledColors.size();
-			if (_colorsMap.size() != ledColors.size())
+			if (_ledAreas.size() != ledColors.size())
 			{
-				Debug(_log, "Get Dominant Color Advanced Uniform failed. colorsMap.size != ledColors.size -> %d != %d", _colorsMap.size(), ledColors.size());
+				Debug(_log, "Get Dominant Color Advanced Uniform failed. colorsMap.size != ledColors.size -> %d != %d", _ledAreas.size(), ledColors.size());
 				return;
 			}
 
@@ -377,6 +470,22 @@ namespace hyperion
 		}
 
 	private:
+		///
+		/// The row entry of a LED in the compressed sparse row layout.
+		/// It references the LED's spans in the packed span array.
+		///
+		struct LedArea
+		{
+			/// Index of the first span of the LED
+			int32_t spanBegin;
+			/// Index after the last span of the LED
+			int32_t spanEnd;
+			/// Evaluate every "step" pixel in a row
+			int32_t step;
+			/// Number of pixels evaluated for the LED
+			int32_t pixelCount;
+		};
+
 		QSharedPointer<Logger> _log;
 
 		/// The width of the indexed image
@@ -393,41 +502,208 @@ namespace hyperion
 		/// Number of clusters used during dominant color advanced processing (k-means)
 		int _clusterCount;
 
-		/// The absolute indices into the image for each led
-		QVector<QVector<int>> _colorsMap;
+		/// Number of lanes the k-means distances are evaluated in, unused lanes hold unreachable centroids
+		static constexpr int KMEANS_LANES = 8;
+		/// Maximum number of k-means iterations per LED and frame
+		static constexpr int MAX_KMEANS_ITERATIONS = 8;
+
+		///
+		/// The centroids of the k-means clusters of a LED area (structure of arrays)
+		///
+		struct ClusterCentroids
+		{
+			std::array<int32_t, KMEANS_LANES> red;
+			std::array<int32_t, KMEANS_LANES> green;
+			std::array<int32_t, KMEANS_LANES> blue;
+		};
+
+		/// The centroids per LED (and of the whole image as last entry), used to warm-start the next frame's k-means
+		mutable QVector<ClusterCentroids> _clusterCentroids;
+
+		/// Time budget of the k-means processing per frame (0 = disabled)
+		std::chrono::microseconds _kMeansTimeBudget;
+
+		///
+		/// Sets the centroids of all LED areas to the default cluster colors
+		///
+		void resetClusterCentroids();
+
+		///
+		/// @return The point in time after which no further k-means iterations are started for the current frame
+		///
+		std::chrono::steady_clock::time_point kMeansDeadline() const
+		{
+			return _kMeansTimeBudget.count() > 0 ? std::chrono::steady_clock::now() + _kMeansTimeBudget : std::chrono::steady_clock::time_point::max();
+		}
+
+		/// Bits per channel of the histogram used during dominant color processing
+		int _dominantColorBits;
+
+		/// Kernels used to accumulate contiguous pixel spans
+		const kernels::AccumulateKernels* _kernels;
+
+		/// The span ranges of each LED (row offsets into _spans)
+		QVector<LedArea> _ledAreas;
+
+		/// The packed pixel spans of all LEDs
+		QVector<PixelSpan> _spans;
+
+		/// The area covering the complete image (its single span is stored after the LEDs' spans)
+		LedArea _imageArea;
+
+		///
+		/// The full resolution rectangle of a LED area, used for summed-area table lookups.
+		/// The pixels from (xBegin, yBegin) up to (excluding) (xEnd, yEnd) are covered.
+		///
+		struct LedRect
+		{
+			int32_t xBegin;
+			int32_t yBegin;
+			int32_t xEnd;
+			int32_t yEnd;
+		};
+
+		/// The rectangles of each LED
+		QVector<LedRect> _ledRects;
+
+		///
+		/// Summed-area table with interleaved red, green and blue sums, (width+1) x (height+1) entries.
+		/// Sums are unsigned 32bit and may wrap around; differences of the table entries are still exact
+		/// as long as the sum of an area fits into 32bit (i.e. for images up to 16.8M pixels).
+		///
+		mutable QVector<uint32_t> _integralImage;
+
+		/// LED index boundaries of the chunks processed in parallel (#chunks + 1 entries)
+		QVector<int> _chunkBounds;
+
+		///
+		/// Runs the evaluation of the LED chunks. The first chunk is processed on the calling thread,
+		/// the other ones on the shared worker pool. Returns when all chunks are processed.
+		///
+		/// @param[in] evaluate Function evaluating the LEDs in the range [ledBegin, ledEnd)
+		///
+		void runChunks(const std::function<void(int ledBegin, int ledEnd)> &evaluate) const;
+
+		///
+		/// Determines the color of every LED by the given function, processing the LED chunks in parallel if configured.
+		///
+		/// @param[out] ledColors The vector containing the output
+		/// @param[in] calcColor Function returning the color for a LED area
+		///
+		template <typename Func>
+		void processLeds(QVector<ColorRgb> &ledColors, Func &&calcColor) const
+		{
+			// Detach once upfront, the chunks write to disjoint ranges of the output
+			ColorRgb *output = ledColors.data();
+			const LedArea *areas = _ledAreas.constData();
+			const auto evaluate = [&](int ledBegin, int ledEnd) {
+				for (int led = ledBegin; led < ledEnd; ++led)
+				{
+					output[led] = calcColor(areas[led]);
+				}
+			};
+			// Pass by reference, the std::function does not need to allocate for the captures then
+			runChunks(std::cref(evaluate));
+		}
+
+		///
+		/// Calls the given function for every pixel of a LED area
+		///
+		/// @param[in] image The image the pixels are taken from
+		/// @param[in] area The LED area to be evaluated
+		/// @param[in] func Function called for every pixel
+		///
+		template <typename Pixel_T, typename Func>
+		void forEachPixel(const Image<Pixel_T> &image, const LedArea &area, Func &&func) const
+		{
+			const Pixel_T *imgData = image.memptr();
+			const int step = area.step;
+
+			const PixelSpan *span = _spans.constData() + area.spanBegin;
+			const PixelSpan *const spanEnd = _spans.constData() + area.spanEnd;
+			for (; span != spanEnd; ++span)
+			{
+				const Pixel_T *rowData = imgData + static_cast<ptrdiff_t>(span->row) * _width;
+				for (int x = span->xBegin; x < span->xEnd; x += step)
+				{
+					func(rowData[x]);
+				}
+			}
+		}
+
+		///
+		/// Sums up each color channel over a LED area (scalar reference used for all pixel types and steps)
+		///
+		/// @param[in] image The image the pixels are taken from
+		/// @param[in] area The LED area to be evaluated
+		/// @param[in,out] sums The sums to be updated
+		///
+		template <typename Pixel_T>
+		void accumulate(const Image<Pixel_T> &image, const LedArea &area, kernels::ChannelSums &sums) const
+		{
+			forEachPixel(image, area, [&sums](const Pixel_T &pixel) {
+				sums.red += pixel.red;
+				sums.green += pixel.green;
+				sums.blue += pixel.blue;
+			});
+		}
+
+		///
+		/// Sums up each squared color channel over a LED area (scalar reference used for all pixel types and steps)
+		///
+		/// @param[in] image The image the pixels are taken from
+		/// @param[in] area The LED area to be evaluated
+		/// @param[in,out] sums The sums to be updated
+		///
+		template <typename Pixel_T>
+		void accumulateSquared(const Image<Pixel_T> &image, const LedArea &area, kernels::ChannelSums &sums) const
+		{
+			forEachPixel(image, area, [&sums](const Pixel_T &pixel) {
+				sums.red += static_cast<uint32_t>(pixel.red * pixel.red);
+				sums.green += static_cast<uint32_t>(pixel.green * pixel.green);
+				sums.blue += static_cast<uint32_t>(pixel.blue * pixel.blue);
+			});
+		}
 
 		///
 		/// Calculates the 'mean color' over the given image. This is the mean over each color-channel
 		/// (red, green, blue)
 		///
 		/// @param[in] image The image a section from which an average color must be computed
-		/// @param[in] pixels The list of pixel indices for the given image to be evaluated///
+		/// @param[in] area The LED area of the given image to be evaluated
 		///
 		/// @return The mean of the given list of colors (or black when empty)
 		///
 		template <typename Pixel_T>
-		ColorRgb calcMeanColor(const Image<Pixel_T> &image, const QVector<int32_t> &pixels) const
+		ColorRgb calcMeanColor(const Image<Pixel_T> &image, const LedArea &area) const
 		{
-			qCDebug(imageToLedsMap_calc) << "Calculate Mean Color on image sized" << image.width() << "x" << image.height() << "and #pixels" << pixels.size();
-			const auto pixelNum = pixels.size();
+			qCDebug(imageToLedsMap_calc) << "Calculate Mean Color on image sized" << image.width() << "x" << image.height() << "and #pixels" << area.pixelCount;
+			const auto pixelNum = static_cast<uint_fast32_t>(area.pixelCount);
 			if (pixelNum == 0)
 			{
 				return ColorRgb::BLACK;
 			}
 
 			// Accumulate the sum of each separate color channel
-			uint_fast32_t cummRed = 0;
-			uint_fast32_t cummGreen = 0;
-			uint_fast32_t cummBlue = 0;
-
-			const auto &imgData = image.memptr();
-			for (const int pixelOffset : pixels)
+			kernels::ChannelSums cumm;
+			if constexpr (std::is_same_v<Pixel_T, ColorRgb>)
+			{
+				if (area.step == 1)
+				{
+					_kernels->sum(image.memptr(), _width, _spans.constData() + area.spanBegin, area.spanEnd - area.spanBegin, cumm);
+				}
+				else
+				{
+					accumulate(image, area, cumm);
+				}
+			}
+			else
 			{
-				const auto &pixel = imgData[pixelOffset];
-				cummRed += pixel.red;
-				cummGreen += pixel.green;
-				cummBlue += pixel.blue;
+				accumulate(image, area, cumm);
 			}
+			const uint64_t cummRed = cumm.red;
+			const uint64_t cummGreen = cumm.green;
+			const uint64_t cummBlue = cumm.blue;
 
 			// Compute the average of each color channel
 			const auto avgRed = uint8_t(cummRed / pixelNum);
@@ -449,30 +725,79 @@ namespace hyperion
 		template <typename Pixel_T>
 		ColorRgb calcMeanColor(const Image<Pixel_T> &image) const
 		{
-			qCDebug(imageToLedsMap_calc) << "Calculate Mean Color on image sized" << image.width() << "x" << image.height();
-			// Accumulate the sum of each separate color channel
-			uint_fast32_t cummRed = 0;
-			uint_fast32_t cummGreen = 0;
-			uint_fast32_t cummBlue = 0;
+			return calcMeanColor(image, _imageArea);
+		}
+
+		///
+		/// Builds the summed-area table of the given image in a single pass.
+		/// Each row is prefix-summed, then the row above is added, which allows the compiler to vectorise the latter.
+		///
+		/// @param[in] image The image the table is built for
+		///
+		template <typename Pixel_T>
+		void buildIntegralImage(const Image<Pixel_T> &image) const
+		{
+			const int tableWidth = (_width + 1) * 3;
+			_integralImage.resize(static_cast<qsizetype>(tableWidth) * (_height + 1));
 
-			const unsigned pixelNum = image.width() * image.height();
-			const auto &imgData = image.memptr();
+			uint32_t *table = _integralImage.data();
+			std::fill(table, table + tableWidth, 0U);
 
-			for (unsigned idx = 0; idx < pixelNum; idx++)
+			const Pixel_T *pixel = image.memptr();
+			for (int y = 0; y < _height; ++y)
 			{
-				const auto &pixel = imgData[idx];
-				cummRed += pixel.red;
-				cummGreen += pixel.green;
-				cummBlue += pixel.blue;
+				const uint32_t *previous = table + static_cast<ptrdiff_t>(y) * tableWidth;
+				uint32_t *current = table + static_cast<ptrdiff_t>(y + 1) * tableWidth;
+
+				uint32_t red = 0;
+				uint32_t green = 0;
+				uint32_t blue = 0;
+				current[0] = 0;
+				current[1] = 0;
+				current[2] = 0;
+				for (int x = 0; x < _width; ++x, ++pixel)
+				{
+					red += pixel->red;
+					green += pixel->green;
+					blue += pixel->blue;
+					current[3 * x + 3] = red;
+					current[3 * x + 4] = green;
+					current[3 * x + 5] = blue;
+				}
+
+				for (int idx = 3; idx < tableWidth; ++idx)
+				{
+					current[idx] += previous[idx];
+				}
 			}
+		}
 
-			// Compute the average of each color channel
-			const auto avgRed = uint8_t(cummRed / pixelNum);
-			const auto avgGreen = uint8_t(cummGreen / pixelNum);
-			const auto avgBlue = uint8_t(cummBlue / pixelNum);
+		///
+		/// Calculates the 'mean color' of a LED rectangle by four lookups in the summed-area table
+		///
+		/// @param[in] rect The LED rectangle to be evaluated
+		///
+		/// @return The mean color of the rectangle (or black when empty)
+		///
+		ColorRgb calcMeanColorIntegral(const LedRect &rect) const
+		{
+			const uint32_t pixelNum = static_cast<uint32_t>((rect.xEnd - rect.xBegin) * (rect.yEnd - rect.yBegin));
+			if (pixelNum == 0)
+			{
+				return ColorRgb::BLACK;
+			}
 
-			// Return the computed color
-			return {avgRed, avgGreen, avgBlue};
+			const ptrdiff_t tableWidth = static_cast<ptrdiff_t>(_width + 1) * 3;
+			const uint32_t *top = _integralImage.constData() + rect.yBegin * tableWidth;
+			const uint32_t *bottom = _integralImage.constData() + rect.yEnd * tableWidth;
+			const int left = 3 * rect.xBegin;
+			const int right = 3 * rect.xEnd;
+
+			const uint32_t cummRed = bottom[right] - bottom[left] - top[right] + top[left];
+			const uint32_t cummGreen = bottom[right + 1] - bottom[left + 1] - top[right + 1] + top[left + 1];
+			const uint32_t cummBlue = bottom[right + 2] - bottom[left + 2] - top[right + 2] + top[left + 2];
+
+			return {uint8_t(cummRed / pixelNum), uint8_t(cummGreen / pixelNum), uint8_t(cummBlue / pixelNum)};
 		}
 
 		///
@@ -480,35 +805,40 @@ namespace hyperion
 		/// (red, green, blue)
 		///
 		/// @param[in] image The image a section from which an average color must be computed
-		/// @param[in] pixels The list of pixel indices for the given image to be evaluated
+		/// @param[in] area The LED area of the given image to be evaluated
 		///
 		/// @return The mean of the given list of colors (or black when empty)
 		///
 		template <typename Pixel_T>
-		ColorRgb calcMeanColorSqrt(const Image<Pixel_T> &image, const QVector<int32_t> &pixels) const
+		ColorRgb calcMeanColorSqrt(const Image<Pixel_T> &image, const LedArea &area) const
 		{
-			qCDebug(imageToLedsMap_calc) << "Calculate Mean Color Squared on image sized" << image.width() << "x" << image.height() << "and #pixels" << pixels.size();
-			const auto pixelNum = pixels.size();
+			qCDebug(imageToLedsMap_calc) << "Calculate Mean Color Squared on image sized" << image.width() << "x" << image.height() << "and #pixels" << area.pixelCount;
+			const auto pixelNum = static_cast<uint_fast32_t>(area.pixelCount);
 			if (pixelNum == 0)
 			{
 				return ColorRgb::BLACK;
 			}
 
 			// Accumulate the squared sum of each separate color channel
-			uint_fast32_t cummRed = 0;
-			uint_fast32_t cummGreen = 0;
-			uint_fast32_t cummBlue = 0;
-
-			const auto &imgData = image.memptr();
-
-			for (const int colorOffset : pixels)
+			kernels::ChannelSums cumm;
+			if constexpr (std::is_same_v<Pixel_T, ColorRgb>)
 			{
-				const auto &pixel = imgData[colorOffset];
-
-				cummRed += pixel.red * pixel.red;
-				cummGreen += pixel.green * pixel.green;
-				cummBlue += pixel.blue * pixel.blue;
+				if (area.step == 1)
+				{
+					_kernels->sumSquared(image.memptr(), _width, _spans.constData() + area.spanBegin, area.spanEnd - area.spanBegin, cumm);
+				}
+				else
+				{
+					accumulateSquared(image, area, cumm);
+				}
+			}
+			else
+			{
+				accumulateSquared(image, area, cumm);
 			}
+			const uint64_t cummRed = cumm.red;
+			const uint64_t cummGreen = cumm.green;
+			const uint64_t cummBlue = cumm.blue;
 
 			// Compute the average of each color channel
 
@@ -534,72 +864,56 @@ namespace hyperion
 		template <typename Pixel_T>
 		ColorRgb calcMeanColorSqrt(const Image<Pixel_T> &image) const
 		{
-			qCDebug(imageToLedsMap_calc) << "Calculate Mean Color Squared on image sized" << image.width() << "x" << image.height();
-			// Accumulate the squared sum of each separate color channel
-			uint_fast32_t cummRed = 0;
-			uint_fast32_t cummGreen = 0;
-			uint_fast32_t cummBlue = 0;
-
-			const unsigned pixelNum = image.width() * image.height();
-			const auto &imgData = image.memptr();
-
-			for (int idx = 0; idx < pixelNum; ++idx)
-			{
-				const auto &pixel = imgData[idx];
-				cummRed += pixel.red * pixel.red;
-				cummGreen += pixel.green * pixel.green;
-				cummBlue += pixel.blue * pixel.blue;
-			}
-
-			// Compute the average of each color channel
-			const auto avgRed = uint8_t(std::lround(sqrt(static_cast<double>(cummRed / pixelNum))));
-			const auto avgGreen = uint8_t(std::lround(sqrt(static_cast<double>(cummGreen / pixelNum))));
-			const auto avgBlue = uint8_t(std::lround(sqrt(static_cast<double>(cummBlue / pixelNum))));
-
-			// Return the computed color
-			return {avgRed, avgGreen, avgBlue};
+			return calcMeanColorSqrt(image, _imageArea);
 		}
 
 		///
-		/// Calculates the 'dominant color' of an image area defined by a list of pixel indices
+		/// Calculates the 'dominant color' of an image area defined by a LED area.
+		/// The colors are counted in a quantised histogram, the most frequent bin is refined to its most frequent exact color.
 		///
 		/// @param[in] image The image for which a dominant color is to be computed
-		/// @param[in] pixels The list of pixel indices for the given image to be evaluated
+		/// @param[in] area The LED area of the given image to be evaluated
 		///
-		/// @return The image area's dominant color or black, if no pixel indices provided
+		/// @return The image area's dominant color or black, if the area has no pixels
 		///
 		template <typename Pixel_T>
-		ColorRgb calculateDominantColor(const Image<Pixel_T> &image, const QVector<int> &pixels) const
+		ColorRgb calculateDominantColor(const Image<Pixel_T> &image, const LedArea &area) const
 		{
-			qCDebug(imageToLedsMap_calc) << "Calculate Dominant Color on image sized" << image.width() << "x" << image.height() << "and #pixels" << pixels.size();
+			qCDebug(imageToLedsMap_calc) << "Calculate Dominant Color on image sized" << image.width() << "x" << image.height() << "and #pixels" << area.pixelCount;
 			ColorRgb dominantColor{ColorRgb::BLACK};
 
-			const auto pixelNum = pixels.size();
-			if (pixelNum > 0)
+			if (area.pixelCount > 0)
 			{
-				const auto &imgData = image.memptr();
-
-				QMap<QRgb, int> colorDistributionMap;
-				int count = 0;
-				for (const int pixelOffset : pixels)
-				{
-					QRgb color = imgData[pixelOffset].rgb();
-					if (colorDistributionMap.contains(color))
-					{
-						colorDistributionMap[color] = colorDistributionMap[color] + 1;
-					}
-					else
+				ColorHistogram &histogram = ColorHistogram::threadLocal(_dominantColorBits);
+
+				// Find the most frequent bin of the quantised colors
+				histogram.reset();
+				uint32_t dominantBin = 0;
+				uint32_t count = 0;
+				forEachPixel(image, area, [&](const Pixel_T &pixel) {
+					const uint32_t bin = histogram.bin(pixel.red, pixel.green, pixel.blue);
+					const uint32_t colorsFound = histogram.addToBin(bin);
+					if (colorsFound > count)
 					{
-						colorDistributionMap[color] = 1;
+						dominantBin = bin;
+						count = colorsFound;
 					}
+				});
 
-					int colorsFound = colorDistributionMap[color];
-					if (colorsFound > count)
+				// Refine the bin to the most frequent exact color inside of it
+				histogram.resetRefinement();
+				count = 0;
+				forEachPixel(image, area, [&](const Pixel_T &pixel) {
+					if (histogram.bin(pixel.red, pixel.green, pixel.blue) == dominantBin)
 					{
-						dominantColor.setRgb(color);
-						count = colorsFound;
+						const uint32_t colorsFound = histogram.addToRefinement(pixel.red, pixel.green, pixel.blue);
+						if (colorsFound > count)
+						{
+							dominantColor = ColorRgb{pixel.red, pixel.green, pixel.blue};
+							count = colorsFound;
+						}
 					}
-				}
+				});
 			}
 			return dominantColor;
 		}
@@ -614,26 +928,9 @@ namespace hyperion
 		template <typename Pixel_T>
 		ColorRgb calculateDominantColor(const Image<Pixel_T> &image) const
 		{
-			qCDebug(imageToLedsMap_calc) << "Calculate Dominant Color on image sized" << image.width() << "x" << image.height();
-			const unsigned pixelNum = image.width() * image.height();
-
-			QVector<int> pixels(pixelNum);
-			std::iota(pixels.begin(), pixels.end(), 0);
-
-			return calculateDominantColor(image, pixels);
+			return calculateDominantColor(image, _imageArea);
 		}
 
-		template <typename Pixel_T>
-		struct ColorCluster
-		{
-
-			ColorCluster() = default;
-			explicit ColorCluster(Pixel_T color) : color(color) {}
-
-			Pixel_T color;
-			Pixel_T newColor;
-			int count{0};
-		};
 		const std::array<ColorRgb, 5> DEFAULT_CLUSTER_COLORS{{{ColorRgb::BLACK},
 															  {ColorRgb::GREEN},
 															  {ColorRgb::WHITE},
@@ -641,111 +938,107 @@ namespace hyperion
 															  {ColorRgb::YELLOW}}};
 
 		///
-		/// Calculates the 'dominant color' of an image area defined by a list of pixel indices
+		/// Calculates the 'dominant color' of an image area defined by a LED area
 		/// using a k-means algorithm (https://robocraft.ru/computervision/1063)
 		///
+		/// The clustering is warm-started from the centroids of the previous frame and uses integer squared distances,
+		/// evaluated for all lanes at once. It stops when no centroid moves, after MAX_KMEANS_ITERATIONS
+		/// or when the deadline of the frame has passed (only with a time budget set).
+		///
 		/// @param[in] image The image for which a dominant color is to be computed
-		/// @param[in] pixels The list of pixel indices for the given image to be evaluated
+		/// @param[in] area The LED area of the given image to be evaluated
+		/// @param[in,out] centroids The centroids of the previous frame, updated for the next one
+		/// @param[in] deadline Point in time after which no further iterations are started
 		///
-		/// @return The image area's dominant color or black, if no pixel indices provided
+		/// @return The image area's dominant color or black, if the area has no pixels
 		///
 		template <typename Pixel_T>
-		ColorRgb calculateDominantColorAdv(const Image<Pixel_T> &image, const QVector<int> &pixels) const
+		ColorRgb calculateDominantColorAdv(const Image<Pixel_T> &image, const LedArea &area, ClusterCentroids &centroids,
+										   std::chrono::steady_clock::time_point deadline) const
 		{
-			qCDebug(imageToLedsMap_calc) << "Calculate Dominant Color Advanced on image sized" << image.width() << "x" << image.height() << "and #pixels" << pixels.size();
+			qCDebug(imageToLedsMap_calc) << "Calculate Dominant Color Advanced on image sized" << image.width() << "x" << image.height() << "and #pixels" << area.pixelCount;
 			ColorRgb dominantColor{ColorRgb::BLACK};
-			const auto pixelNum = pixels.size();
-			if (pixelNum > 0)
+			if (area.pixelCount > 0)
 			{
-				// initial cluster with different colors
-				auto clusters(std::make_unique<ColorCluster<ColorRgbScalar>[]>(_clusterCount));
-				for (int k = 0; k < _clusterCount; ++k)
+				std::array<uint32_t, KMEANS_LANES> counts{};
+				for (int iteration = 1; ; ++iteration)
 				{
-					clusters.get()[k].newColor = DEFAULT_CLUSTER_COLORS[k];
-				}
-
-				// k-means
-				double min_rgb_euclidean{0};
-				double old_rgb_euclidean{0};
-
-				while (true)
-				{
-					for (int k = 0; k < _clusterCount; ++k)
-					{
-						clusters.get()[k].count = 0;
-						clusters.get()[k].color = clusters.get()[k].newColor;
-						clusters.get()[k].newColor.setRgb(ColorRgb::BLACK);
-					}
-
-					const auto &imgData = image.memptr();
-					for (const int pixelOffset : pixels)
-					{
-						const auto &pixel = imgData[pixelOffset];
-
-						min_rgb_euclidean = 255 * 255 * 255;
-						int clusterIndex = -1;
-						for (int k = 0; k < _clusterCount; ++k)
+					std::array<uint32_t, KMEANS_LANES> sumRed{};
+					std::array<uint32_t, KMEANS_LANES> sumGreen{};
+					std::array<uint32_t, KMEANS_LANES> sumBlue{};
+					counts.fill(0);
+
+					forEachPixel(image, area, [&](const Pixel_T &pixel) {
+						const int32_t red = pixel.red;
+						const int32_t green = pixel.green;
+						const int32_t blue = pixel.blue;
+
+						std::array<int32_t, KMEANS_LANES> distances;
+						for (int k = 0; k < KMEANS_LANES; ++k)
 						{
-							double euclid = ColorSys::rgb_euclidean(ColorRgbScalar(pixel), clusters.get()[k].color);
+							const int32_t dRed = red - centroids.red[k];
+							const int32_t dGreen = green - centroids.green[k];
+							const int32_t dBlue = blue - centroids.blue[k];
+							distances[k] = dRed * dRed + dGreen * dGreen + dBlue * dBlue;
+						}
 
-							if (euclid < min_rgb_euclidean)
+						int clusterIndex = 0;
+						for (int k = 1; k < KMEANS_LANES; ++k)
+						{
+							if (distances[k] < distances[clusterIndex])
 							{
-								min_rgb_euclidean = euclid;
 								clusterIndex = k;
 							}
 						}
 
-						clusters.get()[clusterIndex].count++;
-						clusters.get()[clusterIndex].newColor += ColorRgbScalar(pixel);
-					}
+						++counts[clusterIndex];
+						sumRed[clusterIndex] += pixel.red;
+						sumGreen[clusterIndex] += pixel.green;
+						sumBlue[clusterIndex] += pixel.blue;
+					});
 
-					min_rgb_euclidean = 0;
+					// Move the centroids to the mean of their pixels, empty clusters keep their position
+					bool isMoved = false;
 					for (int k = 0; k < _clusterCount; ++k)
 					{
-						if (clusters.get()[k].count > 0)
+						if (counts[k] > 0)
 						{
-							// new color
-							clusters.get()[k].newColor /= clusters.get()[k].count;
-							double ecli = ColorSys::rgb_euclidean(clusters.get()[k].newColor, clusters.get()[k].color);
-							if (ecli > min_rgb_euclidean)
-							{
-								min_rgb_euclidean = ecli;
-							}
+							const auto red = static_cast<int32_t>(sumRed[k] / counts[k]);
+							const auto green = static_cast<int32_t>(sumGreen[k] / counts[k]);
+							const auto blue = static_cast<int32_t>(sumBlue[k] / counts[k]);
+							isMoved = isMoved || red != centroids.red[k] || green != centroids.green[k] || blue != centroids.blue[k];
+							centroids.red[k] = red;
+							centroids.green[k] = green;
+							centroids.blue[k] = blue;
 						}
 					}
 
-					if (fabs(min_rgb_euclidean - old_rgb_euclidean) < 1)
+					if (!isMoved || iteration >= MAX_KMEANS_ITERATIONS || std::chrono::steady_clock::now() > deadline)
 					{
 						break;
 					}
-
-					old_rgb_euclidean = min_rgb_euclidean;
 				}
 
-				int colorsFoundMax = 0;
 				int dominantClusterIdx{0};
-
-				for (int clusterIdx = 0; clusterIdx < _clusterCount; ++clusterIdx)
+				for (int clusterIdx = 1; clusterIdx < _clusterCount; ++clusterIdx)
 				{
-					int colorsFoundinCluster = clusters.get()[clusterIdx].count;
-					if (colorsFoundinCluster > colorsFoundMax)
+					if (counts[clusterIdx] > counts[dominantClusterIdx])
 					{
-						colorsFoundMax = colorsFoundinCluster;
 						dominantClusterIdx = clusterIdx;
 					}
 				}
 
-				dominantColor.red = static_cast<uint8_t>(clusters.get()[dominantClusterIdx].newColor.red);
-				dominantColor.green = static_cast<uint8_t>(clusters.get()[dominantClusterIdx].newColor.green);
-				dominantColor.blue = static_cast<uint8_t>(clusters.get()[dominantClusterIdx].newColor.blue);
+				dominantColor.red = static_cast<uint8_t>(centroids.red[dominantClusterIdx]);
+				dominantColor.green = static_cast<uint8_t>(centroids.green[dominantClusterIdx]);
+				dominantColor.blue = static_cast<uint8_t>(centroids.blue[dominantClusterIdx]);
 			}
 
 			return dominantColor;
 		}
 
 		///
-		/// Calculates the 'dominant color' of an image area defined by a list of pixel indices
-		/// using a k-means algorithm (https://robocraft.ru/computervision/1063)
+		/// Calculates the 'dominant color' of an image using a k-means algorithm
+		/// (https://robocraft.ru/computervision/1063)
 		///
 		/// @param[in] image The image for which a dominant color is to be computed
 		///
@@ -754,13 +1047,7 @@ namespace hyperion
 		template <typename Pixel_T>
 		ColorRgb calculateDominantColorAdv(const Image<Pixel_T> &image) const
 		{
-			qCDebug(imageToLedsMap_calc) << "Calculate Dominant Color Advanced on image sized" << image.width() << "x" << image.height();
-			const unsigned pixelNum = image.width() * image.height();
-
-			QVector<int> pixels(pixelNum);
-			std::iota(pixels.begin(), pixels.end(), 0);
-
-			return calculateDominantColorAdv(image, pixels);
+			return calculateDominantColorAdv(image, _imageArea, _clusterCentroids.last(), kMeansDeadline());
 		}
 	};
 
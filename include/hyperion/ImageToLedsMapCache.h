@@ -0,0 +1,99 @@
+#ifndef IMAGETOLEDSMAPCACHE_H
+#define IMAGETOLEDSMAPCACHE_H
+
+// STL includes
+#include <cstddef>
+#include <functional>
+
+#include <QList>
+#include <QPair>
+#include <QSharedPointer>
+
+// hyperion includes
+#include <hyperion/LedString.h>
+
+namespace hyperion
+{
+	class ImageToLedsMap;
+
+	///
+	/// Least recently used cache of built LED mappings, keyed by the mapping geometry.
+	/// Sources toggling black borders or switching resolution get a previously built mapping back
+	/// instead of recalculating all LED areas.
+	///
+	class ImageToLedsMapCache
+	{
+	public:
+		static constexpr int DEFAULT_CAPACITY = 4;
+
+		///
+		/// The parameters a mapping is built for
+		///
+		struct Key
+		{
+			int width;
+			int height;
+			int horizontalBorder;
+			int verticalBorder;
+			size_t layoutHash;
+			int reducedPixelSetFactor;
+			int accuracyLevel;
+
+			bool operator==(const Key& other) const
+			{
+				return width == other.width && height == other.height
+					&& horizontalBorder == other.horizontalBorder && verticalBorder == other.verticalBorder
+					&& layoutHash == other.layoutHash
+					&& reducedPixelSetFactor == other.reducedPixelSetFactor && accuracyLevel == other.accuracyLevel;
+			}
+		};
+
+		///
+		/// @param[in] capacity  Maximum number of mappings kept
+		///
+		explicit ImageToLedsMapCache(int capacity = DEFAULT_CAPACITY);
+
+		///
+		/// Returns the mapping for the given key. On a cache miss the mapping is built by the given function
+		/// and the least recently used mapping is dropped, if the cache is full.
+		///
+		/// @param[in] key  The parameters of the mapping
+		/// @param[in] create  Function building the mapping
+		///
+		/// @return The mapping
+		///
+		QSharedPointer<ImageToLedsMap> get(const Key& key, const std::function<QSharedPointer<ImageToLedsMap>()>& create);
+
+		///
+		/// @return The mapping for the given key or a null pointer, if it is not cached
+		///
+		QSharedPointer<ImageToLedsMap> find(const Key& key);
+
+		///
+		/// Adds a mapping built elsewhere (e.g. in the background) as the most recently used one
+		///
+		void insert(const Key& key, const QSharedPointer<ImageToLedsMap>& map);
+
+		///
+		/// Drops all mappings
+		///
+		void clear();
+
+		///
+		/// @return A hash of the LED areas of a layout
+		///
+		static size_t layoutHash(const QVector<Led>& leds);
+
+	private:
+		/// Mappings, the most recently used one first
+		QList<QPair<Key, QSharedPointer<ImageToLedsMap>>> _entries;
+
+		int _capacity;
+
+		int _hits;
+		int _misses;
+	};
+
+} // end namespace hyperion
+
+#endif // IMAGETOLEDSMAPCACHE_H
@@ -0,0 +1,80 @@
+#ifndef IMAGETOLEDSMAPKERNELS_H
+#define IMAGETOLEDSMAPKERNELS_H
+
+// STL includes
+#include <cstdint>
+
+#include <QVector>
+
+// hyperion-utils includes
+#include <utils/ColorRgb.h>
+
+namespace hyperion
+{
+	///
+	/// A run of pixels in a single image row which is evaluated for a LED.
+	/// The pixels from xBegin up to (excluding) xEnd are evaluated.
+	///
+	struct PixelSpan
+	{
+		int32_t row;
+		int32_t xBegin;
+		int32_t xEnd;
+	};
+
+	///
+	/// Accumulation kernels used by the ImageToLedsMap to sum up contiguous pixel spans.
+	/// The scalar kernels are the reference implementation; vectorised variants (SSE2, AVX2, NEON)
+	/// are selected at runtime depending on the CPU features available.
+	/// All kernels are integer based and therefore give bit-exact results.
+	///
+	namespace kernels
+	{
+		/// Sum per color channel
+		struct ChannelSums
+		{
+			uint64_t red {0};
+			uint64_t green {0};
+			uint64_t blue {0};
+		};
+
+		///
+		/// Adds the channel values (or their squares) of all pixels of the given spans to the sums.
+		/// Every pixel of a span is evaluated, i.e. spans are expected to be contiguous.
+		///
+		/// @param[in] image Pointer to the first pixel of the image
+		/// @param[in] width The width of the image (row stride in pixels)
+		/// @param[in] spans Pointer to the first span
+		/// @param[in] spanCount Number of spans
+		/// @param[in,out] sums The sums to be updated
+		///
+		using AccumulateFunc = void (*)(const ColorRgb* image, int width, const PixelSpan* spans, int spanCount, ChannelSums& sums);
+
+		struct AccumulateKernels
+		{
+			/// Name of the instruction set used
+			const char* name;
+			/// Sums up the channel values
+			AccumulateFunc sum;
+			/// Sums up the squared channel values
+			AccumulateFunc sumSquared;
+		};
+
+		///
+		/// @return The scalar reference kernels
+		///
+		const AccumulateKernels& scalarKernels();
+
+		///
+		/// @return The fastest kernels supported by the CPU (determined once at first call)
+		///
+		const AccumulateKernels& accumulateKernels();
+
+		///
+		/// @return All kernels supported by the CPU, the scalar reference kernels first
+		///
+		QVector<const AccumulateKernels*> availableKernels();
+	}
+} // end namespace hyperion
+
+#endif // IMAGETOLEDSMAPKERNELS_H
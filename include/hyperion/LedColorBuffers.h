@@ -0,0 +1,107 @@
+#ifndef LEDCOLORBUFFERS_H
+#define LEDCOLORBUFFERS_H
+
+// STL includes
+#include <algorithm>
+#include <array>
+
+#include <QVector>
+
+// Utils includes
+#include <utils/ColorRgb.h>
+
+namespace hyperion
+{
+	///
+	/// Pair of preallocated LED color buffers used alternately for consecutive frames.
+	///
+	/// A frame handed out via a (queued) signal is implicitly shared with its receivers. Writing the next frame
+	/// into the other buffer leaves the shared one untouched, i.e. no copy is required as long as the receivers
+	/// released a frame before the frame after next is written.
+	///
+	class LedColorBuffers
+	{
+	public:
+		///
+		/// @param[in] ledCount  Number of LEDs per buffer
+		///
+		explicit LedColorBuffers(int ledCount = 0)
+			: _index(0)
+			, _detachCount(0)
+		{
+			resize(ledCount);
+		}
+
+		///
+		/// Resizes both buffers and sets all LEDs to black
+		///
+		/// @param[in] ledCount  Number of LEDs per buffer
+		///
+		void resize(int ledCount)
+		{
+			for (QVector<ColorRgb>& buffer : _buffers)
+			{
+				buffer.fill(ColorRgb::BLACK, ledCount);
+			}
+		}
+
+		///
+		/// @return Number of LEDs per buffer
+		///
+		int size() const { return static_cast<int>(_buffers[0].size()); }
+
+		///
+		/// Sets the LEDs from the given index onwards to the given color in both buffers
+		///
+		/// @param[in] color  The color
+		/// @param[in] from   Index of the first LED to be set
+		///
+		void fillFrom(const ColorRgb& color, int from)
+		{
+			for (QVector<ColorRgb>& buffer : _buffers)
+			{
+				if (from < buffer.size())
+				{
+					std::fill(buffer.begin() + from, buffer.end(), color);
+				}
+			}
+		}
+
+		///
+		/// Switches to the other buffer, which is filled for the next frame.
+		/// If receivers still hold that buffer, it is detached (copied) once.
+		///
+		/// @return The buffer for the next frame
+		///
+		QVector<ColorRgb>& next()
+		{
+			_index ^= 1;
+			QVector<ColorRgb>& buffer = _buffers[_index];
+			if (!buffer.isDetached())
+			{
+				++_detachCount;
+				buffer.detach();
+			}
+			return buffer;
+		}
+
+		///
+		/// @return The buffer of the current frame
+		///
+		QVector<ColorRgb>& current() { return _buffers[_index]; }
+		const QVector<ColorRgb>& current() const { return _buffers[_index]; }
+
+		///
+		/// @return Number of times a buffer was still held by receivers and had to be copied
+		///
+		int detachCount() const { return _detachCount; }
+
+	private:
+		std::array<QVector<ColorRgb>, 2> _buffers;
+		int _index;
+		int _detachCount;
+	};
+
+} // end namespace hyperion
+
+#endif // LEDCOLORBUFFERS_H
@@ -0,0 +1,144 @@
+#ifndef LEDOUTPUTPIPELINE_H
+#define LEDOUTPUTPIPELINE_H
+
+// STL includes
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <QVector>
+
+// hyperion-utils includes
+#include <utils/ColorRgb.h>
+
+// Hyperion includes
+#include <hyperion/LedString.h>
+
+class ColorAdjustment;
+class MultiColorAdjustment;
+
+namespace hyperion
+{
+	namespace kernels
+	{
+		/// Source byte per output byte of a pixel, i.e. output byte k is taken from byte indices[k]
+		using ShuffleIndices = std::array<uint8_t, 3>;
+
+		///
+		/// Reorders the bytes of all given pixels in place.
+		///
+		/// @param[in,out] pixels Pointer to the first pixel
+		/// @param[in] count Number of pixels
+		/// @param[in] indices The byte order to be applied
+		///
+		using ShuffleFunc = void (*)(ColorRgb* pixels, int count, const ShuffleIndices& indices);
+
+		struct ShuffleKernel
+		{
+			/// Name of the instruction set used
+			const char* name;
+			/// Reorders the bytes of the pixels
+			ShuffleFunc shuffle;
+		};
+
+		///
+		/// @return The scalar reference shuffle kernel
+		///
+		const ShuffleKernel& scalarShuffleKernel();
+
+		///
+		/// @return The fastest shuffle kernel supported by the CPU (determined once at first call)
+		///
+		const ShuffleKernel& shuffleKernel();
+
+		///
+		/// @return All shuffle kernels supported by the CPU, the scalar reference kernel first
+		///
+		QVector<const ShuffleKernel*> availableShuffleKernels();
+	}
+
+	///
+	/// The final per LED processing of the device colors, compiled into a single pass over the LEDs:
+	/// blacklisted LEDs are switched off, the LED's color adjustment is applied and the color
+	/// channels are reordered to the LED's color order.
+	///
+	/// The pipeline is compiled from the layout and the adjustments whenever one of them changes.
+	/// LEDs are processed in blocks which stay in the L1 cache. Within a block, the color adjustment
+	/// is applied per run of LEDs sharing an adjustment and the channel reordering is done by a (SIMD)
+	/// byte shuffle over runs of LEDs sharing the same color order.
+	///
+	class LedOutputPipeline
+	{
+	public:
+		LedOutputPipeline();
+
+		///
+		/// Compiles the pipeline for a LED layout
+		///
+		/// @param[in] colorOrders The color order per LED of the layout
+		/// @param[in] blacklistedLedIds The LEDs to be switched off
+		/// @param[in] adjustment The color adjustment per LED, nullptr for none. The adjustments
+		///                       are referenced, i.e. updates of an existing adjustment do not
+		///                       require recompiling, but it must outlive the pipeline's use.
+		///
+		void compile(const QVector<ColorOrder>& colorOrders, const QVector<int>& blacklistedLedIds, const MultiColorAdjustment* adjustment);
+
+		///
+		/// Processes the colors of the LEDs of the layout in place, any further LEDs are left untouched
+		///
+		/// @param[in,out] ledColors The raw LED colors
+		///
+		void apply(QVector<ColorRgb>& ledColors) const;
+
+		///
+		/// @return The number of LEDs the pipeline was compiled for
+		///
+		int size() const { return static_cast<int>(_keepMask.size()); }
+
+		///
+		/// Overrides the shuffle kernel selected for the CPU, e.g. to compare kernels
+		///
+		/// @param[in] kernel The shuffle kernel to be used
+		///
+		void setShuffleKernel(const kernels::ShuffleKernel& kernel) { _shuffleKernel = &kernel; }
+
+		///
+		/// @return The shuffle kernel in use
+		///
+		const kernels::ShuffleKernel& shuffleKernel() const { return *_shuffleKernel; }
+
+		///
+		/// @param[in] order The color order
+		/// @return The byte shuffle converting an RGB color into the given color order
+		///
+		static kernels::ShuffleIndices shuffleIndices(ColorOrder order);
+
+	private:
+		/// Consecutive LEDs from begin up to (excluding) end which share a color adjustment
+		struct AdjustmentRun
+		{
+			int begin;
+			int end;
+			ColorAdjustment* adjustment;
+		};
+
+		/// Consecutive LEDs from begin up to (excluding) end which share a color order other than RGB
+		struct ShuffleRun
+		{
+			int begin;
+			int end;
+			kernels::ShuffleIndices indices;
+		};
+
+		/// The color adjustment runs in ascending LED order, LEDs without adjustment are not covered
+		std::vector<AdjustmentRun> _adjustmentRuns;
+		/// Channel mask per LED, 0x00 for blacklisted LEDs and 0xFF for all others
+		std::vector<uint8_t> _keepMask;
+		/// The color order runs in ascending LED order
+		std::vector<ShuffleRun> _shuffleRuns;
+
+		const kernels::ShuffleKernel* _shuffleKernel;
+	};
+} // end namespace hyperion
+
+#endif // LEDOUTPUTPIPELINE_H
@@ -3,7 +3,6 @@
 
 // STL includes
 #include <vector>
-#include <deque>
 
 // Qt includes
 #include <QVector>
@@ -14,6 +13,8 @@
 // hyperion includes
 #include <leddevice/LedDevice.h>
 #include <utils/Components.h>
+#include <utils/FrameRing.h>
+#include <utils/LatencyMetrics.h>
 #include <hyperion/PriorityMuxer.h>
 
 // settings
@@ -28,6 +29,11 @@ class QTimer;
 class Logger;
 class Hyperion;
 
+namespace hyperion
+{
+	class OutputPacer;
+}
+
 enum SmoothingConfigID
 {
 	SYSTEM = 0,
@@ -91,9 +97,10 @@ public:
 	/// LED values as input for the smoothing filter
 	///
 	/// @param ledValues The color-value per led
+	/// @param captureTime_ns Monotonic capture time of the input the values were derived from, 0 if unknown
 	/// @return Zero on success else negative
 	///
-	virtual int updateLedValues(const QVector<ColorRgb> &ledValues);
+	virtual int updateLedValues(const QVector<ColorRgb> &ledValues, qint64 captureTime_ns = 0);
 
 	void setEnable(bool enable);
 	void setPause(bool pause);
@@ -175,12 +182,27 @@ private:
 	void queueColors(const QVector<ColorRgb> &ledColors);
 	void clearQueuedColors();
 
+	///
+	/// @brief Writes the colors to the LED-device, via the output pacing thread if it runs
+	///
+	/// @param ledColors The colors to write
+	/// @param captureTime_ns Monotonic capture time of the input the colors were derived from
+	///
+	void outputColors(const QVector<ColorRgb> &ledColors, qint64 captureTime_ns);
+
+	///
+	/// @brief Starts the output pacing thread with the current update interval if output pacing is configured and
+	/// smoothing is enabled, stops it otherwise
+	///
+	void updateOutputPacing();
+
 	/// write updated values as input for the smoothing filter
 	///
 	/// @param ledValues The color-value per led
+	/// @param captureTime_ns Monotonic capture time of the input the values were derived from
 	/// @return Zero on success else negative
 	///
-	virtual int write(const QVector<ColorRgb> &ledValues);
+	virtual int write(const QVector<ColorRgb> &ledValues, qint64 captureTime_ns);
 
 	QString getConfig(int cfgID);
 
@@ -190,6 +212,9 @@ private:
 	/// Logger instance
 	QSharedPointer<Logger> _log;
 
+	/// Duration of calculating and writing a smoothed frame
+	QSharedPointer<LatencyHistogram> _smoothingLatency;
+
 	/// Hyperion instance
 	QWeakPointer<Hyperion> _hyperionWeak;
 
@@ -205,12 +230,21 @@ private:
 	/// The Qt timer object
 	QScopedPointer<QTimer> _timer;
 
+	/// Whether the frames are written by a dedicated thread at absolute deadlines instead of by the timer
+	bool _isOutputPacing;
+
+	/// The output pacing thread, writing the latest frame at every update interval
+	QScopedPointer<hyperion::OutputPacer> _outputPacer;
+
 	/// The timestamp at which the target data should be fully applied
 	int64_t _targetTime;
 
 	/// The target led data
 	QVector<ColorRgb> _targetValues;
 
+	/// The capture time of the input the target led data was derived from
+	qint64 _targetCaptureTime_ns;
+
 	/// The timestamp of the previously written led data
 	int64_t _previousWriteTime;
 
@@ -223,32 +257,31 @@ private:
 	/// The number of updates to keep in the output queue (delayed) before being output
 	unsigned _outputDelay;
 
-	/// The output queue
-	std::deque<QVector<ColorRgb>> _outputQueue;
+	/// Led colors delayed in the output queue
+	struct OUTPUT_FRAME
+	{
+		/// The led colors
+		QVector<ColorRgb> colors;
+
+		/// The capture time of the input the most recent target was derived from
+		qint64 captureTime_ns {0};
+	};
+
+	/// The output queue, holding the configured number of delayed frames plus the frame being output
+	FrameRing<OUTPUT_FRAME> _outputQueue;
 
 	/// A frame of led colors used for temporal smoothing
-	class REMEMBERED_FRAME
+	struct REMEMBERED_FRAME
 	{
-		public:
 		/// The time this frame was received
-		int64_t time;
+		int64_t time {0};
 
 		/// The led colors
 		QVector<ColorRgb> colors;
-
-		REMEMBERED_FRAME ( REMEMBERED_FRAME && ) = default;
-		REMEMBERED_FRAME ( const REMEMBERED_FRAME & ) = default;
-		REMEMBERED_FRAME & operator= ( const REMEMBERED_FRAME & ) = default;
-
-		REMEMBERED_FRAME(int64_t time, const QVector<ColorRgb> colors)
-		: time(time)
-		, colors(colors)
-		{}
 	};
 
-
-	/// The queue of temporarily remembered frames
-	std::deque<REMEMBERED_FRAME> _frameQueue;
+	/// The queue of temporarily remembered frames, sized for the frames of a settling time at the update frequency
+	FrameRing<REMEMBERED_FRAME> _frameQueue;
 
 	/// Flag for pausing
 	bool _pause;
@@ -268,6 +301,9 @@ private:
 	/// The decay power > 0. A value of exactly 1 is linear decay, higher numbers indicate a faster decay rate.
 	double _decay;
 
+	/// Whether the frames are weighted linearly (decay of exactly 1), exponentially otherwise
+	bool _isLinearDecay;
+
 	/// Value of 1.0 / settlingTime; inverse of the window size used for weighting of frames.
 	floatT _invWindow;
 
@@ -334,14 +370,11 @@ private:
 	/// The number of led component-values that must be held per color; i.e. size of the color vectors reds / greens / blues
 	size_t _ledCount = 0;
 
-	/// The average component colors red, green, blue of the leds
-	std::vector<floatT> meanValues;
-
-	/// The residual component errors of the leds
-	std::vector<floatT> residualErrors;
+	/// The average component colors red, green, blue of the leds in fixed point (smoothing::FRACTION_BITS)
+	std::vector<uint32_t> meanValues;
 
-	/// The accumulated led color values in 64-bit fixed point domain
-	std::vector<uint64_t> tempValues;
+	/// The residual component errors of the leds in fixed point (smoothing::FRACTION_BITS)
+	std::vector<int32_t> residualErrors;
 
 	/// Writes the target frame RGB data to the LED device without any interpolation.
 	void writeDirect();
@@ -358,7 +391,11 @@ private:
 	void assembleFrame();
 
 	/// Prepares a frame of LED colors by interpolating using the current smoothing window
-	void interpolateFrame();
+	///
+	/// @param weightFrame The frame weighting function for finding the frame's integral value,
+	///                    called with the start and end of frame time and the window start time.
+	template <typename WeightFunc>
+	void interpolateFrame(const WeightFunc& weightFrame);
 
 	/// Performs a decay-based smoothing effect. The frames are interpolated based on their age and a given decay-power.
 	///
@@ -372,13 +409,6 @@ private:
 	/// Performs a linear smoothing effect
 	void performLinear(int64_t now);
 
-	/// Aggregates the RGB components of the LED colors using the given weight and updates weighted accordingly
-	///
-	/// @param colors The LED colors to aggregate.
-	/// @param weighted The target vector, that accumulates the terms.
-	/// @param weight The weight to use.
-	static inline void aggregateComponents(const QVector<ColorRgb>& colors, std::vector<uint64_t>& weighted, const floatT weight);
-
 	/// Gets the current time in microseconds from high precision system clock.
 	static inline int64_t micros() ;
 
@@ -396,14 +426,6 @@ private:
 
 	/// The count of frames that have been interpolated when statistics were shown previously
 	int64_t _interpolationStatCounter;
-
-	/// Frame weighting function for finding the frame's integral value
-	///
-	/// @param frameStart The start of frame time.
-	/// @param frameEnd The end of frame time.
-	/// @param windowStart The window start time.
-	/// @returns The frame weight.
-	std::function<floatT(int64_t, int64_t, int64_t)> _weightFrame;
 };
 
 #endif // LINEARCOLORSMOOTHING_H
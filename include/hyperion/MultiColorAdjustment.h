@@ -16,6 +16,16 @@
 class MultiColorAdjustment
 {
 public:
+	///
+	/// Consecutive LEDs from begin up to (excluding) end which share a ColorAdjustment
+	///
+	struct AdjustmentRange
+	{
+		int begin;
+		int end;
+		ColorAdjustment* adjustment;
+	};
+
 	MultiColorAdjustment(int ledCnt);
 	~MultiColorAdjustment();
 
@@ -26,8 +36,21 @@ public:
 	 */
 	void addAdjustment(ColorAdjustment * adjustment);
 
+	///
+	/// Assigns a ColorAdjustment to a range of LEDs. The ranges used by applyAdjustment() are grouped
+	/// by updateAdjustmentRanges(), once all LEDs are assigned.
+	///
+	/// @param adjutmentId The identifier of the ColorAdjustment
+	/// @param startLed The first LED
+	/// @param endLed The last LED (included)
+	///
 	void setAdjustmentForLed(const QString& adjutmentId, int startLed, int endLed);
 
+	///
+	/// Groups the LED adjustments into ranges, to be called after the LEDs were assigned by setAdjustmentForLed()
+	///
+	void updateAdjustmentRanges();
+
 	bool verifyAdjustments() const;
 
 	void setBacklightEnabled(bool enable);
@@ -54,6 +77,56 @@ public:
 	///
 	void applyAdjustment(QVector<ColorRgb>& ledColors);
 
+	///
+	/// Performs the color adjustment of a single LED, looked up in the baked table if available
+	///
+	/// @param adjustment The ColorAdjustment of the LED
+	/// @param color The raw color, adjusted in place
+	///
+	static void applyAdjustment(ColorAdjustment& adjustment, ColorRgb& color);
+
+	///
+	/// Performs the color adjustment of consecutive LEDs sharing the ColorAdjustment. The lookup table
+	/// (or the calculation) is selected once for all LEDs, the backlight is applied in a second pass.
+	///
+	/// @param adjustment The ColorAdjustment of the LEDs
+	/// @param colors Pointer to the raw color of the first LED, adjusted in place
+	/// @param count Number of LEDs
+	///
+	static void applyAdjustment(ColorAdjustment& adjustment, ColorRgb* colors, int count);
+
+	///
+	/// Calculates the color adjustment of a single LED without lookup table, except for the backlight.
+	/// This is the reference the lookup tables are baked from.
+	///
+	/// @param adjustment The ColorAdjustment of the LED
+	/// @param color The raw color, adjusted in place
+	///
+	static void calculateAdjustment(ColorAdjustment& adjustment, ColorRgb& color);
+
+	///
+	/// Calculates the RGB/CMY/W channel adjustments and the temperature of a gamma corrected color
+	///
+	/// @param adjustment The ColorAdjustment of the LED
+	/// @param color The gamma corrected color, adjusted in place
+	///
+	static void calculateChannelAdjustment(ColorAdjustment& adjustment, ColorRgb& color);
+
+	///
+	/// @return The unique ColorAdjustments
+	///
+	const QVector<ColorAdjustment*>& getAdjustments() const;
+
+	///
+	/// @return The ColorAdjustment per LED (nullptr for LEDs without adjustment)
+	///
+	const QVector<ColorAdjustment*>& getLedAdjustments() const;
+
+	///
+	/// @return The ranges of LEDs sharing a ColorAdjustment in ascending LED order, LEDs without adjustment are not covered
+	///
+	const QVector<AdjustmentRange>& getAdjustmentRanges() const;
+
 private:
 	/// List with transform ids
 	QStringList _adjustmentIds;
@@ -64,6 +137,9 @@ private:
 	/// List with a pointer to the ColorAdjustment for each individual led
 	QVector<ColorAdjustment*> _ledAdjustments;
 
+	/// The LED adjustments grouped into ranges, i.e. an adjustment is dispatched once per range
+	QVector<AdjustmentRange> _adjustmentRanges;
+
 	// logger instance
 	QSharedPointer<Logger> _log;
 };
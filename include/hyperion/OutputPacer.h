@@ -0,0 +1,151 @@
+#ifndef OUTPUTPACER_H
+#define OUTPUTPACER_H
+
+// STL includes
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+#include <QSharedPointer>
+#include <QVector>
+
+// hyperion-utils includes
+#include <utils/ColorRgb.h>
+#include <utils/FrameMailbox.h>
+#include <utils/LatencyMetrics.h>
+
+class Logger;
+
+namespace hyperion
+{
+	///
+	/// Paces the output of LED frames on a dedicated thread.
+	///
+	/// The thread sleeps until absolute deadlines on the monotonic clock (clock_nanosleep where available) and outputs
+	/// the newest frame posted since the previous deadline, i.e. the output cadence does not depend on the load of the
+	/// event loop producing the frames. Frames are handed over without locking, a frame not sent before the next one
+	/// is posted is replaced.
+	///
+	/// The deadlines follow the producer half an interval behind its posts: the phase is taken from the first frame
+	/// (again after an idle deadline) and then corrected gradually, i.e. a producer posting at the same interval gets
+	/// one frame sent per deadline despite the wake-up jitter of either side.
+	///
+	/// The wake-up delay after every deadline is recorded as jitter.
+	///
+	class OutputPacer
+	{
+	public:
+		///
+		/// Writes a frame, called from the pacing thread
+		///
+		using OutputFunc = std::function<void(const QVector<ColorRgb>& ledColors, qint64 captureTime_ns)>;
+
+		///
+		/// Counters since the pacer was started
+		///
+		struct Statistics
+		{
+			/// Deadlines the thread woke up for
+			quint64 ticks {0};
+			/// Deadlines without a new frame to be sent
+			quint64 idleTicks {0};
+			/// Deadlines passed while sending, e.g. after a suspend
+			quint64 missedDeadlines {0};
+			/// Frames replaced before they were sent
+			quint64 replacedFrames {0};
+		};
+
+		///
+		/// @param[in] output  Writes a frame
+		/// @param[in] jitter  Records the wake-up delay per deadline, may be null
+		/// @param[in] log     Logger for the periodic statistics
+		///
+		OutputPacer(OutputFunc output, const QSharedPointer<LatencyHistogram>& jitter, const QSharedPointer<Logger>& log);
+		~OutputPacer();
+
+		OutputPacer(const OutputPacer&) = delete;
+		OutputPacer& operator=(const OutputPacer&) = delete;
+
+		///
+		/// Starts the pacing thread, restarts it if running with another interval
+		///
+		/// @param[in] interval  The output interval
+		///
+		void start(std::chrono::microseconds interval);
+
+		///
+		/// Stops the pacing thread, returns after the current deadline at the latest. A frame not sent yet is dropped.
+		///
+		void stop();
+
+		///
+		/// @return True if the pacing thread runs
+		///
+		bool isRunning() const { return _thread.joinable(); }
+
+		///
+		/// Hands a frame over to the pacing thread, from any thread
+		///
+		/// @param[in] ledColors       The LED colors
+		/// @param[in] captureTime_ns  Monotonic capture time of the input the colors were derived from
+		///
+		void post(const QVector<ColorRgb>& ledColors, qint64 captureTime_ns);
+
+		///
+		/// @return The counters since the pacer was started
+		///
+		Statistics statistics() const;
+
+	private:
+		struct Frame
+		{
+			QVector<ColorRgb> ledColors;
+			qint64 captureTime_ns {0};
+			/// Monotonic time the frame was posted
+			qint64 postTime_ns {0};
+		};
+
+		///
+		/// The pacing loop
+		///
+		void run(qint64 interval_ns);
+
+		///
+		/// Logs the statistics and the jitter recorded
+		///
+		void logStatistics() const;
+
+		///
+		/// @param[in] frame        The frame taken at the deadline
+		/// @param[in] deadline_ns  The deadline
+		/// @param[in] interval_ns  The output interval
+		///
+		/// @return The shift of the deadlines to be half an interval behind the post of the frame, within +/- half an
+		///         interval
+		///
+		static qint64 phaseError(const Frame& frame, qint64 deadline_ns, qint64 interval_ns);
+
+		///
+		/// Sleeps until the given absolute time of the monotonic clock
+		///
+		static void sleepUntil(qint64 deadline_ns);
+
+		OutputFunc _output;
+		QSharedPointer<LatencyHistogram> _jitter;
+		QSharedPointer<Logger> _log;
+
+		FrameMailbox<Frame> _frames;
+		FrameCounters _framesAtStart;
+
+		std::thread _thread;
+		std::chrono::microseconds _interval;
+		std::atomic<bool> _isStopRequested {false};
+
+		std::atomic<quint64> _ticks {0};
+		std::atomic<quint64> _idleTicks {0};
+		std::atomic<quint64> _missedDeadlines {0};
+	};
+} // end namespace hyperion
+
+#endif // OUTPUTPACER_H
@@ -1,6 +1,8 @@
 #pragma once
 
 // STL includes
+#include <array>
+#include <bitset>
 #include <vector>
 #include <cstdint>
 
@@ -27,6 +29,10 @@ class Logger;
 /// and the muxer keeps track of all active priorities. The current priority can be queried and per
 /// priority the led colors. Handles also manual/auto selection mode, provides a lot of signals to hook into priority related events
 ///
+/// The channels are kept in a fixed table indexed by priority, i.e. updating a channel does neither search nor
+/// allocate. Timeouts are measured on the monotonic clock and kept in a min-heap of deadlines, the muxer only
+/// wakes up when the next deadline is due instead of rescanning the channels periodically.
+///
 class PriorityMuxer : public QObject
 {
 	Q_OBJECT
@@ -38,7 +44,8 @@ public:
 	{
 		/// The priority of this channel
 		int priority;
-		/// The absolute timeout of the channel
+		/// The absolute timeout of the channel on the monotonic clock (see currentTime_ms()), or one of ENDLESS,
+		/// TIMEOUT_NOT_ACTIVE_PRIO and REMOVE_CLEARED_PRIO
 		int64_t timeoutTime_ms;
 		/// The colors for each led of the channel
 		QVector<ColorRgb> ledColors;
@@ -52,6 +59,8 @@ public:
 		unsigned smooth_cfg;
 		/// specific owner description
 		QString owner;
+		/// Monotonic capture time of the colors or image in nanoseconds, 0 if unknown
+		qint64 captureTime_ns {0};
 	};
 
 	typedef QMap<int, InputInfo> InputsMap;
@@ -68,6 +77,14 @@ public:
 
 	const static int ENDLESS;
 
+	/// Number of priority slots: the priorities 0 up to LOWEST_PRIORITY and MANUAL_SELECTED_PRIORITY (never an input)
+	static constexpr int PRIORITY_SLOTS = 257;
+
+	///
+	/// @return Milliseconds of the monotonic clock, the time base of the channel timeouts
+	///
+	static int64_t currentTime_ms();
+
 	///
 	/// Constructs the PriorityMuxer for the given number of LEDs (used to switch to black when
 	/// there are no priority channels
@@ -164,9 +181,9 @@ public:
 	///
 	/// @param priority The priority channel
 	///
-	/// @return The information for the specified priority channel
+	/// @return The information for the specified priority channel, valid until the channel is updated
 	///
-	InputInfo getInputInfo(int priority) const;
+	const InputInfo& getInputInfo(int priority) const;
 
 	///
 	/// @brief  Register a new input by priority, the priority is not active (timeout -100 isn't muxer recognized) until you start to update the data with setInput()
@@ -241,30 +258,63 @@ signals:
 	///
 	void prioritiesChanged(int currentPriority, InputsMap activeInputs);
 
-	///
-	/// internal used signal to resolve treading issues with timer
-	///
-	void signalTimeTrigger();
-
 private slots:
 	///
-	/// Slot which is called to adapt to 1s interval for signal prioritiesChanged()
+	/// Slot which is called in 1s interval for signal prioritiesChanged() while a channel counts down its timeout
 	///
 	void timeTrigger();
 
 	///
-	/// Updates the current priorities. Channels with a configured time out will be checked and cleared if
-	/// required. Cleared priorities will be removed.
+	/// Updates the current priorities. Channels whose timeout is due will be cleared,
+	/// cleared priorities will be removed.
 	///
 	void updatePriorities();
 
 private:
+	/// A channel's timeout in the deadline heap
+	struct Deadline
+	{
+		int64_t time_ms;
+		int priority;
+
+		bool operator>(const Deadline& other) const { return time_ms > other.time_ms; }
+	};
+
+	///
+	/// @param priority The priority
+	/// @return True if the priority is registered
+	///
+	bool isRegistered(int priority) const;
+
 	///
 	/// @brief Get the component of the given priority
 	/// @return The component
 	///
 	hyperion::Components getComponentOfPriority(int priority) const;
 
+	///
+	/// @brief Sets the timeout of a registered channel and keeps the deadline heap up to date
+	/// @param priority    The priority of the channel
+	/// @param timeout_ms  The absolute timeout or one of the special timeout values
+	///
+	void setTimeout(int priority, int64_t timeout_ms);
+
+	///
+	/// @brief Removes a channel from the table
+	/// @param priority The priority of the channel
+	///
+	void removeInput(int priority);
+
+	///
+	/// @brief Wakes up the muxer at the next deadline (or immediately if cleared channels are pending)
+	///
+	void scheduleUpdate();
+
+	///
+	/// @brief Starts or stops the 1s interval of prioritiesChanged(), depending on channels counting down their timeout
+	///
+	void updateCountdown();
+
 	/// Logger instance
 	QSharedPointer<Logger> _log;
 
@@ -280,8 +330,24 @@ private:
 	// The last visible component
 	hyperion::Components _prevVisComp = hyperion::COMP_INVALID;
 
-	/// The mapping from priority channel to led-information
-	InputsMap _activeInputs;
+	/// The led-information per priority channel, indexed by priority
+	std::array<InputInfo, PRIORITY_SLOTS> _inputs;
+
+	/// The registered priority channels
+	std::bitset<PRIORITY_SLOTS> _registered;
+
+	/// Min-heap of the channel timeouts. Entries of channels whose timeout changed in the meantime are
+	/// outdated and dropped when due, i.e. the heap holds one entry per timed channel in steady state.
+	std::vector<Deadline> _deadlines;
+
+	/// The deadline in the heap per priority channel, 0 for none
+	std::array<int64_t, PRIORITY_SLOTS> _scheduledTimeout_ms;
+
+	/// Cleared channels which are not yet removed
+	bool _hasClearedInputs;
+
+	/// Reflects setEnable(), the muxer does not wake up for timeouts while disabled
+	bool _isUpdateEnabled;
 
 	/// The information of the lowest priority channel
 	InputInfo _lowestPriorityInfo;
@@ -289,9 +355,9 @@ private:
 	// Reflect the state of auto select
 	bool _sourceAutoSelectEnabled;
 
-	// Timer to update Muxer times independent
+	// Timer to wake up the muxer at the next deadline
 	QScopedPointer<QTimer> _updateTimer;
 
+	// Timer for the 1s interval of prioritiesChanged() while channels count down
 	QScopedPointer<QTimer> _timer;
-	QScopedPointer<QTimer> _blockTimer;
 };
@@ -0,0 +1,98 @@
+#ifndef SMOOTHINGKERNELS_H
+#define SMOOTHINGKERNELS_H
+
+// STL includes
+#include <cstdint>
+
+#include <QVector>
+
+namespace hyperion
+{
+	///
+	/// Fixed point kernels of the LinearColorSmoothing, operating on the color components of the LEDs (three bytes per LED).
+	/// The scalar kernels are the reference implementation; vectorised variants (SSE2, NEON) are selected at runtime
+	/// depending on the CPU features available. All kernels are integer based and therefore give bit-exact results.
+	///
+	namespace smoothing
+	{
+		/// Number of fraction bits of the fixed point frame weights and component means
+		constexpr int FRACTION_BITS = 22;
+
+		/// The fixed point weight 1.0, the weights of the frames accumulated into a mean must not add up to more
+		constexpr uint32_t FIXED_ONE = 1U << FRACTION_BITS;
+
+		/// Number of fraction bits of the factor of a linear smoothing step
+		constexpr int STEP_FRACTION_BITS = 16;
+
+		///
+		/// Adds the weighted components to the sums, i.e. sums[i] += weight * components[i]
+		///
+		/// @param[in] components Pointer to the first component
+		/// @param[in] count Number of components
+		/// @param[in] weight The fixed point weight of the components
+		/// @param[in,out] sums The fixed point sums to be updated
+		///
+		using AccumulateFunc = void (*)(const uint8_t* components, int count, uint32_t weight, uint32_t* sums);
+
+		///
+		/// Rounds the fixed point means to the components, clamped to 255
+		///
+		/// @param[in] means Pointer to the first fixed point mean
+		/// @param[in] count Number of components
+		/// @param[out] components The components
+		///
+		using AssembleFunc = void (*)(const uint32_t* means, int count, uint8_t* components);
+
+		///
+		/// Rounds the fixed point means plus the residual errors of the previous frame to the components, clamped to
+		/// [0, 255], and keeps the new residual errors for the next frame (temporal dithering)
+		///
+		/// @param[in] means Pointer to the first fixed point mean
+		/// @param[in,out] residuals The fixed point residual errors
+		/// @param[in] count Number of components
+		/// @param[out] components The components
+		///
+		using DitherFunc = void (*)(const uint32_t* means, int32_t* residuals, int count, uint8_t* components);
+
+		///
+		/// Moves the components towards the target components by the given fraction of their difference, rounded up
+		///
+		/// @param[in] target Pointer to the first target component
+		/// @param[in] count Number of components
+		/// @param[in] factor The fraction in fixed point with STEP_FRACTION_BITS, at most 1.0
+		/// @param[in,out] components The components
+		///
+		using StepFunc = void (*)(const uint8_t* target, int count, uint32_t factor, uint8_t* components);
+
+		struct SmoothingKernels
+		{
+			/// Name of the instruction set used
+			const char* name;
+			/// Accumulates weighted frames
+			AccumulateFunc accumulate;
+			/// Rounds the means
+			AssembleFunc assemble;
+			/// Rounds the means with error diffusion
+			DitherFunc dither;
+			/// Linear smoothing step
+			StepFunc step;
+		};
+
+		///
+		/// @return The scalar reference kernels
+		///
+		const SmoothingKernels& scalarKernels();
+
+		///
+		/// @return The fastest kernels supported by the CPU (determined once at first call)
+		///
+		const SmoothingKernels& smoothingKernels();
+
+		///
+		/// @return All kernels supported by the CPU, the scalar reference kernels first
+		///
+		QVector<const SmoothingKernels*> availableKernels();
+	}
+} // end namespace hyperion
+
+#endif // SMOOTHINGKERNELS_H
@@ -28,6 +28,7 @@
 #include <functional>
 #include <utils/Components.h>
 #include <utils/JsonUtils.h>
+#include <utils/LatencyMetrics.h>
 
 Q_DECLARE_LOGGING_CATEGORY(leddevice_config);
 Q_DECLARE_LOGGING_CATEGORY(leddevice_control);
@@ -92,7 +93,7 @@ public:
 	/// @brief Set a device's latch time.
 	///
 	/// Latch time is the time-frame a device requires until the next update can be processed.
-	/// During that time-frame any updates done via updateLeds are skipped.
+	/// The newest update done via updateLeds during that time-frame is written when the latch time expires.
 	///
 	/// @param[in] latchTime_ms Latch time in milliseconds
 	///
@@ -197,6 +198,34 @@ public:
 	///
 	bool isInError() const;
 
+	///
+	/// @brief Write rates and latch statistics of the device
+	///
+	struct WriteStatistics
+	{
+		/// Rate of the updates requested via updateLeds over the last statistics interval
+		double requestedRate_hz {0};
+		/// Rate of the updates written to the device over the last statistics interval
+		double achievedRate_hz {0};
+		/// Updates requested since the device was created
+		quint64 requested {0};
+		/// Updates written since the device was created
+		quint64 written {0};
+		/// Updates deferred until the latch time expired
+		quint64 deferred {0};
+		/// Deferred updates replaced by a newer one before the latch time expired
+		quint64 replaced {0};
+	};
+
+	///
+	/// @brief Get the write statistics, can be called from any thread.
+	///
+	/// The delay of the updates by the latch time is recorded as latency stage "latch_delay".
+	///
+	/// @return The write statistics
+	///
+	WriteStatistics getWriteStatistics() const;
+
 	///
 	/// @brief Prints the color values to stdout.
 	///
@@ -224,9 +253,10 @@ public slots:
 	/// Updates received while another updates is in progress are skipped to avoid queueing.
 	///
 	/// @param[in] ledValues The color per LED
+	/// @param[in] captureTime_ns Monotonic capture time of the input the colors were derived from, 0 if unknown
 	/// @return Zero on success else negative
 	///
-	virtual int updateLeds(const QVector<ColorRgb>& ledValues);
+	virtual int updateLeds(const QVector<ColorRgb>& ledValues, qint64 captureTime_ns = 0);
 
 	///
 	/// @brief Get the currently defined LatchTime.
@@ -501,8 +531,8 @@ protected:
 	/// Is the device in error state, but is retries might resolve the situation?
 	bool _isDeviceRecoverable;
 
-	/// Timestamp of last write
-	QDateTime _lastWriteTime;
+	/// Monotonic time of the last write in nanoseconds, 0 if there was none yet
+	qint64 _lastWriteTime_ns;
 
 protected slots:
 
@@ -528,6 +558,11 @@ private slots:
 	///
 	void processLedUpdate();
 
+	///
+	/// @brief Write the update deferred by the latch time, called when the latch time expired.
+	///
+	void writeLatchedUpdate();
+
 	///
 	/// @brief Retry to enable the LED-device
 	///
@@ -565,9 +600,28 @@ private:
 	/// Handles refreshing of LEDs.
 	///
 	/// @param[in] ledValues The color per LED
+	/// @param[in] captureTime_ns Monotonic capture time of the input the colors were derived from, 0 if unknown
 	/// @return Zero on success else negative (i.e. device is not ready)
 	///
-	int writeLedUpdate(const QVector<ColorRgb>& ledValues);
+	int writeLedUpdate(const QVector<ColorRgb>& ledValues, qint64 captureTime_ns);
+
+	///
+	/// @brief Write the color values to the device and record the write statistics.
+	///
+	/// @param[in] ledValues The color per LED
+	/// @param[in] captureTime_ns Monotonic capture time of the input the colors were derived from, 0 if unknown
+	/// @param[in] latchDelay_ns Time the update was deferred by the latch time
+	/// @return Zero on success else negative
+	///
+	int writeLedValues(const QVector<ColorRgb>& ledValues, qint64 captureTime_ns, qint64 latchDelay_ns);
+
+	/// @brief Drop an update deferred by the latch time
+	void cancelLatchedUpdate();
+
+	/// @brief Update the write rates, if the statistics interval has passed
+	///
+	/// @param[in] now_ns Monotonic time in nanoseconds
+	void updateWriteRates(qint64 now_ns);
 
 	/// @brief Start a new refresh cycle
 	void startRefreshTimer();
@@ -620,6 +674,36 @@ private:
 	// The mutex now ONLY protects the data buffer.
 	QMutex _ledBufferMutex;
 	QVector<ColorRgb> _ledUpdateBuffer;
+	qint64 _ledUpdateCaptureTime_ns{ 0 };
+
+	/// Duration of writing LED values to the device
+	QSharedPointer<LatencyHistogram> _writeLatency;
+	/// Time from capturing the input to the LED values being written to the device
+	QSharedPointer<LatencyHistogram> _captureToLedLatency;
+	/// Time updates were deferred by the latch time
+	QSharedPointer<LatencyHistogram> _latchDelay;
+
+	/// Timer writing the update deferred when the latch time expires
+	QScopedPointer<QTimer> _latchTimer;
+	/// Is an update deferred by the latch time?
+	bool _isLatchedUpdatePending{ false };
+	/// The newest update deferred by the latch time
+	QVector<ColorRgb> _latchedLedValues;
+	qint64 _latchedCaptureTime_ns{ 0 };
+	/// Monotonic time the deferred update was requested
+	qint64 _latchedSince_ns{ 0 };
+
+	// Write statistics, updated by the device's thread and read from any thread
+	std::atomic<quint64> _updatesRequested{ 0 };
+	std::atomic<quint64> _updatesWritten{ 0 };
+	std::atomic<quint64> _updatesDeferred{ 0 };
+	std::atomic<quint64> _updatesReplaced{ 0 };
+	std::atomic<double> _requestedRate_hz{ 0 };
+	std::atomic<double> _achievedRate_hz{ 0 };
+	std::atomic<qint64> _rateIntervalStart_ns{ 0 };
+	quint64 _rateIntervalRequested{ 0 };
+	quint64 _rateIntervalWritten{ 0 };
+	quint64 _rateIntervalDeferred{ 0 };
 };
 
 #endif // LEDEVICE_H
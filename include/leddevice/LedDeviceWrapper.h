@@ -9,7 +9,8 @@
 #include <QScopedPointer>
 #include <QWeakPointer>
 
-class LedDevice;
+#include <leddevice/LedDevice.h>
+
 class Hyperion;
 
 using LedDeviceCreateFuncType = LedDevice* (*)( const QJsonObject& );
@@ -60,6 +61,12 @@ public:
 	///
 	int getLatchTime() const;
 
+	///
+	/// @brief Get the write rates and latch statistics of the LED-device
+	/// @return The write statistics
+	///
+	LedDevice::WriteStatistics getWriteStatistics() const;
+
 	///
 	/// @brief Get the current active LED-device type
 	///
@@ -103,10 +110,11 @@ signals:
 	/// PIPER signal for Hyperion -> LedDevice
 	///
 	/// @param[in] ledValues  The RGB-color per led
+	/// @param[in] captureTime_ns  Monotonic capture time of the input the colors were derived from, 0 if unknown
 	///
 	/// @return Zero on success else negative
 	///
-	int updateLeds(const QVector<ColorRgb>& ledValues);
+	int updateLeds(const QVector<ColorRgb>& ledValues, qint64 captureTime_ns);
 
 	///
 	/// @brief Switch the LEDs on.
@@ -0,0 +1,217 @@
+#ifndef FRAMEMAILBOX_H
+#define FRAMEMAILBOX_H
+
+// STL includes
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtGlobal>
+
+///
+/// Frame counters of a mailbox
+///
+struct FrameCounters
+{
+	/// Frames posted
+	quint64 posted {0};
+	/// Frames replaced by a newer one before they were taken
+	quint64 dropped {0};
+};
+
+///
+/// Single slot mailbox passing the latest frame from any number of producer threads to a consumer, without locking.
+///
+/// A frame posted before the previous one was taken replaces it, i.e. the consumer only gets the newest frame
+/// and a slow consumer neither builds up a backlog nor holds more than two frames (the pending one and a spare
+/// container reused by the next post).
+///
+template <typename T>
+class FrameMailbox
+{
+public:
+	FrameMailbox() = default;
+
+	~FrameMailbox()
+	{
+		delete _pending.load();
+		delete _spare.load();
+	}
+
+	FrameMailbox(const FrameMailbox&) = delete;
+	FrameMailbox& operator=(const FrameMailbox&) = delete;
+
+	///
+	/// Posts a frame, replacing a frame not taken yet
+	///
+	/// @param[in] frame The frame
+	///
+	/// @return True if the mailbox was empty, i.e. the consumer has to be notified to take the frame.
+	///         False if a pending frame was replaced, the consumer is notified already.
+	///
+	bool post(const T& frame)
+	{
+		Node* node = _spare.exchange(nullptr, std::memory_order_acquire);
+		if (node == nullptr)
+		{
+			node = new Node();
+		}
+		node->frame = frame;
+
+		Node* const replaced = _pending.exchange(node, std::memory_order_acq_rel);
+		_posted.fetch_add(1, std::memory_order_relaxed);
+		if (replaced != nullptr)
+		{
+			_dropped.fetch_add(1, std::memory_order_relaxed);
+			recycle(replaced);
+			return false;
+		}
+		return true;
+	}
+
+	///
+	/// Takes the pending frame
+	///
+	/// @param[out] frame The newest frame posted
+	///
+	/// @return True if a frame was pending
+	///
+	bool take(T& frame)
+	{
+		Node* const node = _pending.exchange(nullptr, std::memory_order_acq_rel);
+		if (node == nullptr)
+		{
+			return false;
+		}
+		frame = std::move(node->frame);
+		recycle(node);
+		return true;
+	}
+
+	///
+	/// @return The frame counters since construction
+	///
+	FrameCounters counters() const
+	{
+		return { _posted.load(std::memory_order_relaxed), _dropped.load(std::memory_order_relaxed) };
+	}
+
+private:
+	struct Node
+	{
+		T frame;
+	};
+
+	///
+	/// Keeps a node for the next post, the frame it holds is released
+	///
+	void recycle(Node* node)
+	{
+		node->frame = T();
+		delete _spare.exchange(node, std::memory_order_acq_rel);
+	}
+
+	std::atomic<Node*> _pending {nullptr};
+	std::atomic<Node*> _spare {nullptr};
+	std::atomic<quint64> _posted {0};
+	std::atomic<quint64> _dropped {0};
+};
+
+///
+/// A FrameMailbox per input slot (e.g. per priority) and the notification of the consumer.
+///
+/// The consumer is notified once whenever a mailbox turns from empty to pending, e.g. by queueing a call into
+/// its thread which takes the frame. Frames posted meanwhile replace the pending one without notification,
+/// i.e. the consumer's event queue holds one notification per slot at most.
+///
+/// The inbox is shared with the producers (e.g. captured by a direct connection), the consumer closes it on
+/// destruction, frames posted afterwards are dropped silently.
+///
+template <typename T>
+class FrameInbox
+{
+public:
+	///
+	/// @param[in] slotCount  Number of input slots
+	/// @param[in] notify     Called from the producer's thread with the slot to be taken
+	///
+	FrameInbox(int slotCount, std::function<void(int slot)> notify)
+		: _slotCount(slotCount)
+		, _mailboxes(new FrameMailbox<T>[static_cast<size_t>(slotCount)])
+		, _notify(std::move(notify))
+	{
+	}
+
+	///
+	/// @return The number of input slots
+	///
+	int slotCount() const { return _slotCount; }
+
+	///
+	/// Posts a frame to a slot, from any thread
+	///
+	/// @param[in] slot   The input slot
+	/// @param[in] frame  The frame
+	///
+	void post(int slot, const T& frame)
+	{
+		if (slot < 0 || slot >= _slotCount)
+		{
+			return;
+		}
+
+		if (_mailboxes[static_cast<size_t>(slot)].post(frame))
+		{
+			const QMutexLocker locker(&_notifyMutex);
+			if (_notify)
+			{
+				_notify(slot);
+			}
+		}
+	}
+
+	///
+	/// Takes the newest frame of a slot
+	///
+	/// @param[in] slot    The input slot
+	/// @param[out] frame  The frame
+	///
+	/// @return True if a frame was pending
+	///
+	bool take(int slot, T& frame)
+	{
+		return slot >= 0 && slot < _slotCount && _mailboxes[static_cast<size_t>(slot)].take(frame);
+	}
+
+	///
+	/// @param[in] slot  The input slot
+	///
+	/// @return The frame counters of the slot
+	///
+	FrameCounters counters(int slot) const
+	{
+		return _mailboxes[static_cast<size_t>(slot)].counters();
+	}
+
+	///
+	/// Stops notifying the consumer, returns after a notification in progress
+	///
+	void close()
+	{
+		const QMutexLocker locker(&_notifyMutex);
+		_notify = nullptr;
+	}
+
+private:
+	const int _slotCount;
+	std::unique_ptr<FrameMailbox<T>[]> _mailboxes;
+
+	/// Guards the consumer's notification against its destruction, taken once per notification
+	QMutex _notifyMutex;
+	std::function<void(int slot)> _notify;
+};
+
+#endif // FRAMEMAILBOX_H
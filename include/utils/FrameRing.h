@@ -0,0 +1,134 @@
+#ifndef FRAMERING_H
+#define FRAMERING_H
+
+// STL includes
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+///
+/// FIFO of frames on a ring of preallocated slots.
+///
+/// Slots are not destroyed when frames are removed, a frame pushed later is written into the slot of a removed one.
+/// Frames holding buffers (e.g. LED colors) therefore reuse the buffers of removed frames, i.e. a ring sized for the
+/// frames queued at most does not allocate once its buffers have the size of a frame. A push into a full ring
+/// doubles its capacity.
+///
+template <typename T>
+class FrameRing
+{
+public:
+	///
+	/// @param[in] capacity  The number of frames the ring holds without growing
+	///
+	explicit FrameRing(size_t capacity = 0)
+		: _slots(std::max<size_t>(capacity, 1))
+	{
+	}
+
+	///
+	/// Changes the capacity, the newest frames are kept if the ring holds more frames than fit
+	///
+	/// @param[in] capacity  The number of frames the ring holds without growing
+	///
+	void setCapacity(size_t capacity)
+	{
+		capacity = std::max<size_t>(capacity, 1);
+		if (capacity == _slots.size())
+		{
+			return;
+		}
+
+		if (_size > capacity)
+		{
+			popFront(_size - capacity);
+		}
+
+		// Move the frames to the front of the new slots, keeping the buffers of the free slots
+		std::vector<T> slots;
+		slots.reserve(capacity);
+		for (size_t i = 0; i < _slots.size() && slots.size() < capacity; ++i)
+		{
+			slots.push_back(std::move(_slots[index(i)]));
+		}
+		slots.resize(capacity);
+
+		_slots = std::move(slots);
+		_head = 0;
+	}
+
+	///
+	/// @return The number of frames the ring holds without growing
+	///
+	size_t capacity() const { return _slots.size(); }
+
+	///
+	/// @return The number of frames queued
+	///
+	size_t size() const { return _size; }
+
+	bool empty() const { return _size == 0; }
+
+	///
+	/// Appends a frame
+	///
+	/// @return The slot of the new frame, holding the frame previously stored in it. It is to be overwritten by
+	///         assigning its members, so their buffers are reused.
+	///
+	T& pushBack()
+	{
+		if (_size == _slots.size())
+		{
+			setCapacity(2 * _slots.size());
+		}
+		++_size;
+		return back();
+	}
+
+	///
+	/// Removes the oldest frames, their slots are kept for reuse
+	///
+	/// @param[in] count  The number of frames to remove
+	///
+	void popFront(size_t count = 1)
+	{
+		count = std::min(count, _size);
+		_head = (_head + count) % _slots.size();
+		_size -= count;
+	}
+
+	///
+	/// Removes all frames, their slots are kept for reuse
+	///
+	void clear()
+	{
+		_head = 0;
+		_size = 0;
+	}
+
+	///
+	/// @param[in] i  Position of the frame, 0 is the oldest one
+	///
+	T& operator[](size_t i) { return _slots[index(i)]; }
+	const T& operator[](size_t i) const { return _slots[index(i)]; }
+
+	T& front() { return _slots[_head]; }
+	const T& front() const { return _slots[_head]; }
+
+	T& back() { return _slots[index(_size - 1)]; }
+	const T& back() const { return _slots[index(_size - 1)]; }
+
+private:
+	size_t index(size_t i) const
+	{
+		const size_t slot = _head + i;
+		return slot < _slots.size() ? slot : slot - _slots.size();
+	}
+
+	std::vector<T> _slots;
+	size_t _head {0};
+	size_t _size {0};
+};
+
+#endif // FRAMERING_H
@@ -190,6 +190,20 @@ public:
 
 	quint64 id() const;
 
+	///
+	/// Returns the time the image was captured, i.e. grabbed or received
+	///
+	/// @return Nanoseconds of the monotonic clock (see LatencyMetrics::monotonicTime_ns()), 0 if unknown
+	///
+	qint64 captureTime() const;
+
+	///
+	/// Set the time the image was captured. The time is kept by copies of this handle.
+	///
+	/// @param captureTime_ns Nanoseconds of the monotonic clock
+	///
+	void setCaptureTime(qint64 captureTime_ns);
+
 	///
 	/// Returns a const QImage that shares data with this Image object.
 	/// No data is copied. The returned QImage is read-only.
@@ -219,6 +233,7 @@ public:
 
 	QSharedDataPointer<ImageData<pixel_type>> _d_ptr;
 	quint64 _instanceId; // Unique ID for this C++ object handle
+	qint64 _captureTime_ns; // Monotonic capture time of the image data
 };
 
 #endif // IMAGE_H
@@ -0,0 +1,167 @@
+#ifndef LATENCYMETRICS_H
+#define LATENCYMETRICS_H
+
+// STL includes
+#include <array>
+#include <atomic>
+#include <chrono>
+
+#include <QByteArray>
+#include <QJsonArray>
+#include <QList>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+#include <QWeakPointer>
+
+///
+/// Histogram of processing durations, which can be recorded from any thread without locking.
+///
+/// Durations are counted in buckets with an upper bound of 2^index microseconds,
+/// the last bucket collects all longer durations.
+///
+class LatencyHistogram
+{
+public:
+	static constexpr int BUCKET_COUNT = 24;
+
+	///
+	/// Copy of the counters for evaluation. The counters are read one after the other without locking,
+	/// durations recorded meanwhile may be contained in some of them only.
+	///
+	struct Snapshot
+	{
+		std::array<quint64, BUCKET_COUNT> counts {};
+		quint64 count {0};
+		quint64 sum_us {0};
+		quint64 max_us {0};
+
+		///
+		/// @param[in] quantile  Quantile in the range [0..1], e.g. 0.99
+		///
+		/// @return Upper bound of the bucket holding the quantile in microseconds (0 if nothing was recorded)
+		///
+		quint64 percentile(double quantile) const;
+	};
+
+	LatencyHistogram();
+
+	///
+	/// Records a duration
+	///
+	void record(std::chrono::nanoseconds duration);
+
+	///
+	/// @return Copy of the current counters
+	///
+	Snapshot snapshot() const;
+
+	///
+	/// @return Upper bound of a bucket in microseconds
+	///
+	static quint64 bucketUpperBound_us(int bucket) { return quint64{1} << bucket; }
+
+private:
+	std::array<std::atomic<quint64>, BUCKET_COUNT> _counts;
+	std::atomic<quint64> _sum_us;
+	std::atomic<quint64> _max_us;
+};
+
+///
+/// Records the time from construction to destruction into a histogram (if given)
+///
+class LatencyTimer
+{
+public:
+	explicit LatencyTimer(LatencyHistogram* histogram)
+		: _histogram(histogram)
+		, _start(std::chrono::steady_clock::now())
+	{
+	}
+
+	~LatencyTimer()
+	{
+		if (_histogram != nullptr)
+		{
+			_histogram->record(std::chrono::steady_clock::now() - _start);
+		}
+	}
+
+	LatencyTimer(const LatencyTimer&) = delete;
+	LatencyTimer& operator=(const LatencyTimer&) = delete;
+
+private:
+	LatencyHistogram* _histogram;
+	std::chrono::steady_clock::time_point _start;
+};
+
+///
+/// Registry of the latency histograms of all processing stages, instances and LED devices.
+///
+/// Components request their histogram once and record into it directly. A histogram is reported
+/// as long as its component holds it.
+///
+class LatencyMetrics
+{
+public:
+	static constexpr const char* STAGE_GRAB = "grab";
+	static constexpr const char* STAGE_RESAMPLE = "resample";
+	static constexpr const char* STAGE_MAPPING = "mapping";
+	static constexpr const char* STAGE_ADJUSTMENT = "adjustment";
+	static constexpr const char* STAGE_SMOOTHING = "smoothing";
+	static constexpr const char* STAGE_DEVICE_WRITE = "device_write";
+	static constexpr const char* STAGE_OUTPUT_JITTER = "output_jitter";
+	static constexpr const char* STAGE_LATCH_DELAY = "latch_delay";
+	static constexpr const char* STAGE_END_TO_END = "end_to_end";
+	static constexpr const char* STAGE_CAPTURE_TO_LED = "capture_to_led";
+
+	static LatencyMetrics& getInstance();
+
+	///
+	/// @return Nanoseconds of the monotonic clock, the time base of capture timestamps (CLOCK_MONOTONIC on Linux)
+	///
+	static qint64 monotonicTime_ns()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	///
+	/// @param[in] stage  The processing stage
+	/// @param[in] instance  The instance the stage runs for, empty for global stages
+	/// @param[in] component  The grabber or LED device type, empty if not applicable
+	///
+	/// @return The histogram for the given labels, created if it does not exist yet
+	///
+	QSharedPointer<LatencyHistogram> histogram(const QString& stage, const QString& instance = QString(), const QString& component = QString());
+
+	///
+	/// @return Count, mean, percentiles and maximum per histogram
+	///
+	QJsonArray toJson() const;
+
+	///
+	/// @return All histograms in the Prometheus text exposition format
+	///
+	QByteArray toPrometheus() const;
+
+private:
+	LatencyMetrics() = default;
+
+	struct Entry
+	{
+		QString stage;
+		QString instance;
+		QString component;
+		QWeakPointer<LatencyHistogram> histogram;
+	};
+
+	///
+	/// @return The entries still held by a component, dropping all others
+	///
+	QList<QPair<Entry, QSharedPointer<LatencyHistogram>>> activeEntries() const;
+
+	mutable QMutex _mutex;
+	mutable QList<Entry> _entries;
+};
+
+#endif // LATENCYMETRICS_H
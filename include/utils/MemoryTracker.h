@@ -1,6 +1,8 @@
 #ifndef MEMORYTRACKER_H
 #define MEMORYTRACKER_H
 
+#include <atomic>
+#include <cstddef>
 #include <typeinfo>
 #include <type_traits>
 #include <memory>
@@ -184,6 +186,46 @@ QSharedPointer<T> makeTrackedSingleton(QObject* parent)
     return makeTrackedShared<T>(parent, parent);
 }
 
+// Heap allocation tracking, e.g. to verify that a processing path does not allocate in steady state.
+// Allocations are only counted in executables which expand INSTALL_HEAP_ALLOCATION_TRACKING() once at file scope.
+namespace memorytracker
+{
+	/// Number of heap allocations (malloc, calloc, realloc, operator new) since program start
+	inline std::atomic<quint64> heapAllocationCount{ 0 };
+
+	inline quint64 heapAllocations()
+	{
+		return heapAllocationCount.load(std::memory_order_relaxed);
+	}
+}
+
+#if defined(__GLIBC__)
+#define HEAP_ALLOCATION_TRACKING_SUPPORTED 1
+// Interposes the C allocation functions (operator new is based on malloc) and forwards them to glibc
+#define INSTALL_HEAP_ALLOCATION_TRACKING()                                                      \
+    extern "C" void *__libc_malloc(size_t size);                                                \
+    extern "C" void *__libc_calloc(size_t count, size_t size);                                  \
+    extern "C" void *__libc_realloc(void *ptr, size_t size);                                    \
+    extern "C" void *malloc(size_t size) __THROW                                                \
+    {                                                                                           \
+        memorytracker::heapAllocationCount.fetch_add(1, std::memory_order_relaxed);             \
+        return __libc_malloc(size);                                                             \
+    }                                                                                           \
+    extern "C" void *calloc(size_t count, size_t size) __THROW                                  \
+    {                                                                                           \
+        memorytracker::heapAllocationCount.fetch_add(1, std::memory_order_relaxed);             \
+        return __libc_calloc(count, size);                                                      \
+    }                                                                                           \
+    extern "C" void *realloc(void *ptr, size_t size) __THROW                                    \
+    {                                                                                           \
+        memorytracker::heapAllocationCount.fetch_add(1, std::memory_order_relaxed);             \
+        return __libc_realloc(ptr, size);                                                       \
+    }
+#else
+#define HEAP_ALLOCATION_TRACKING_SUPPORTED 0
+#define INSTALL_HEAP_ALLOCATION_TRACKING()
+#endif
+
 inline void setTracingLogPattern()
 {
     //Turn off Qt debug logging per default
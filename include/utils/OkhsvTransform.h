@@ -9,6 +9,15 @@
 class OkhsvTransform
 {
 public:
+	/// Implementations of the transform
+	enum class Implementation
+	{
+		/// Double precision ok_color conversions to Okhsv and back
+		Reference,
+		/// Fused conversion without trigonometric functions and with table based sRGB transfer, matches the reference exactly
+		Fast
+	};
+
 	///
 	/// Default constructor
 	///
@@ -48,6 +57,24 @@ public:
 	///
 	void transform(uint8_t & red, uint8_t & green, uint8_t & blue) const;
 
+	///
+	/// Apply the transform to the given RGB values using a specific implementation.
+	///
+	/// @param red The red color component
+	/// @param green The green color component
+	/// @param blue The blue color component
+	/// @param implementation The implementation to be used
+	///
+	/// @note The values are updated in place.
+	///
+	void transform(uint8_t & red, uint8_t & green, uint8_t & blue, Implementation implementation) const;
+
+	///
+	/// @return The implementation used by transform(), the fast one unless it failed its self-check
+	///         against the reference (determined once, when the first transform is constructed)
+	///
+	static Implementation implementation();
+
 private:
 	/// Sets _isIdentity to true if both gain values are at their neutral setting
 	void updateIsIdentity();
@@ -58,6 +85,9 @@ private:
 
 	/// Is true if the gain settings result in an identity transformation
 	bool _isIdentity;
+
+	/// The implementation used by transform()
+	Implementation _implementation;
 };
 
 #endif // OKHSVTRANSFORM_H
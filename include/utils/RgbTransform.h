@@ -106,6 +106,16 @@ public:
 	///
 	void applyBacklight(uint8_t & red, uint8_t & green, uint8_t & blue) const;
 
+	///
+	/// Apply Backlight to a range of colors, skipped at once if the backlight is disabled.
+	///
+	/// @param colors Pointer to the first color
+	/// @param count Number of colors
+	///
+	/// @note The values are updated in place.
+	///
+	void applyBacklight(ColorRgb* colors, int count) const;
+
 	int getTemperature() const;
 	void setTemperature(int temperature);
 	void applyTemperature(ColorRgb& color) const;
@@ -1,9 +1,13 @@
 #ifndef THREAD_UTILS_H
 #define THREAD_UTILS_H
 
+#include <utility>
+
 #include <QThread>
 #include <QMetaObject>
 #include <QObject>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QDebug>
 
 /**
@@ -73,4 +77,51 @@ inline void stopThreadImmediate(QThread* threadPtr)
 	}
 }
 
+/**
+ * @brief Hands the results of worker threads (e.g. of the global thread pool) over to the thread of a receiver object.
+ *
+ * The workers share it via QSharedPointer, the receiver closes it on destruction. Calls queued before are discarded
+ * together with the receiver's pending events, calls made afterwards are dropped. Unlike a QPointer checked on the
+ * worker thread, the receiver cannot be destroyed between the check and queueing the call.
+ */
+class QueuedReceiver
+{
+public:
+	explicit QueuedReceiver(QObject* receiver)
+		: _receiver(receiver)
+	{
+	}
+
+	QueuedReceiver(const QueuedReceiver&) = delete;
+	QueuedReceiver& operator=(const QueuedReceiver&) = delete;
+
+	/**
+	 * @brief Queues a call of the function in the receiver's thread, from any thread.
+	 *
+	 * @param function Called in the receiver's thread, as long as the receiver exists.
+	 */
+	template <typename Func>
+	void invoke(Func&& function)
+	{
+		const QMutexLocker locker(&_mutex);
+		if (_receiver != nullptr)
+		{
+			QMetaObject::invokeMethod(_receiver, std::forward<Func>(function), Qt::QueuedConnection);
+		}
+	}
+
+	/**
+	 * @brief Stops queueing calls, returns after a call being queued. To be called by the receiver's destructor.
+	 */
+	void close()
+	{
+		const QMutexLocker locker(&_mutex);
+		_receiver = nullptr;
+	}
+
+private:
+	QMutex _mutex;
+	QObject* _receiver;
+};
+
 #endif // THREAD_UTILS_H
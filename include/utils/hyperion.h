@@ -175,6 +175,7 @@ namespace hyperion {
 				}
 			}
 		}
+		adjustment->updateAdjustmentRanges();
 
 		return adjustment;
 	}
@@ -24,6 +24,7 @@
 #include <utils/SysInfo.h>
 #include <utils/ColorSys.h>
 #include <utils/Process.h>
+#include <utils/LatencyMetrics.h>
 
 // ledmapping int <> string transform methods
 #include <hyperion/ImageProcessor.h>
@@ -115,6 +116,8 @@ void API::setColor(int priority, const QVector<uint8_t> &ledColors, int timeout_
 
 bool API::setImage(ImageCmdData &data, hyperion::Components comp, QString &replyMsg, hyperion::Components /*callerComp*/) const
 {
+	const qint64 receiveTime_ns = LatencyMetrics::monotonicTime_ns();
+
 	// truncate name length
 	data.imgName.truncate(16);
 
@@ -198,11 +201,12 @@ bool API::setImage(ImageCmdData &data, hyperion::Components comp, QString &reply
 	// copy image
 	Image<ColorRgb> image(data.width, data.height);
 	memcpy(image.memptr(), data.data.data(), static_cast<size_t>(data.data.size()));
+	image.setCaptureTime(receiveTime_ns);
 
 	if (auto hyperion = _hyperionWeak.toStrongRef())
 	{
-		QMetaObject::invokeMethod(hyperion.get(), "registerInput", Qt::QueuedConnection, Q_ARG(int, data.priority), Q_ARG(hyperion::Components, comp), Q_ARG(QString, data.origin), Q_ARG(QString, data.imgName));
-		QMetaObject::invokeMethod(hyperion.get(), "setInputImage", Qt::QueuedConnection, Q_ARG(int, data.priority), Q_ARG(Image<ColorRgb>, image), Q_ARG(int64_t, data.duration));
+		hyperion->postRegisterInput(data.priority, comp, data.origin, data.imgName);
+		hyperion->postInputImage(data.priority, image, data.duration);
 	}
 
 	return true;
@@ -214,7 +218,7 @@ bool API::clearPriority(int priority, QString &replyMsg, hyperion::Components /*
 	{
 		if (auto hyperion = _hyperionWeak.toStrongRef())
 		{
-			QMetaObject::invokeMethod(hyperion.get(), "clear", Qt::QueuedConnection, Q_ARG(int, priority));
+			hyperion->postClear(priority);
 		}
 	}
 	else
@@ -34,6 +34,7 @@
 #include <utils/KelvinToRgb.h>
 #include <utils/Process.h>
 #include <utils/JsonUtils.h>
+#include <utils/LatencyMetrics.h>
 #include <effectengine/EffectFileHandler.h>
 
 // ledmapping int <> string transform methods
@@ -478,6 +479,9 @@ void JsonAPI::handleCommand(const JsonApiCommand& cmd, const QJsonObject &messag
 	case Command::SysInfo:
 		handleSysInfoCommand(message, cmd);
 	break;
+	case Command::Metrics:
+		handleMetricsCommand(message, cmd);
+	break;
 	case Command::ServerInfo:
 		handleServerInfoCommand(message, cmd);
 	break;
@@ -771,6 +775,11 @@ void JsonAPI::handleSysInfoCommand(const QJsonObject & /*unused*/, const JsonApi
 	sendSuccessDataReply(JsonInfo::getSystemInfo(), cmd);
 }
 
+void JsonAPI::handleMetricsCommand(const QJsonObject & /*unused*/, const JsonApiCommand& cmd)
+{
+	sendSuccessDataReply(LatencyMetrics::getInstance().toJson(), cmd);
+}
+
 void JsonAPI::handleServerInfoCommand(const QJsonObject &message, const JsonApiCommand& cmd)
 {
 	QJsonObject info {};
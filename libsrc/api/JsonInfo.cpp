@@ -48,6 +48,29 @@ QJsonObject JsonInfo::getInfo(const QSharedPointer<Hyperion>& hyperionInstance,
 		info["videomode"] = QString(videoMode2String(hyperionInstance->getCurrentVideoMode()));
 		info["imageToLedMappingType"] = ImageProcessor::mappingTypeToStr(hyperionInstance->getLedMappingType());
 		info["leds"] = hyperionInstance->getSetting(settings::LEDS).array();
+		info["staticFramesSkipped"] = static_cast<qint64>(hyperionInstance->getStaticFramesSkipped());
+
+		QJsonArray inputFrames;
+		const QMap<int, FrameCounters> inputCounters = hyperionInstance->getInputImageCounters();
+		for (auto it = inputCounters.cbegin(); it != inputCounters.cend(); ++it)
+		{
+			QJsonObject input;
+			input["priority"] = it.key();
+			input["received"] = static_cast<qint64>(it.value().posted);
+			input["dropped"] = static_cast<qint64>(it.value().dropped);
+			inputFrames.append(input);
+		}
+		info["inputFrames"] = inputFrames;
+
+		const LedDevice::WriteStatistics writeStatistics = hyperionInstance->getLedDeviceWriteStatistics();
+		QJsonObject ledDeviceWrites;
+		ledDeviceWrites["requestedRate"] = writeStatistics.requestedRate_hz;
+		ledDeviceWrites["achievedRate"] = writeStatistics.achievedRate_hz;
+		ledDeviceWrites["requested"] = static_cast<qint64>(writeStatistics.requested);
+		ledDeviceWrites["written"] = static_cast<qint64>(writeStatistics.written);
+		ledDeviceWrites["deferred"] = static_cast<qint64>(writeStatistics.deferred);
+		ledDeviceWrites["replaced"] = static_cast<qint64>(writeStatistics.replaced);
+		info["ledDeviceWrites"] = ledDeviceWrites;
 	}
 	else
 	{
@@ -55,6 +78,9 @@ QJsonObject JsonInfo::getInfo(const QSharedPointer<Hyperion>& hyperionInstance,
 		info["videomode"] = QString(videoMode2String(VideoMode::VIDEO_2D));
 		info["imageToLedMappingType"] = ImageProcessor::mappingTypeToStr(0);
 		info["leds"] = QJsonArray();
+		info["staticFramesSkipped"] = 0;
+		info["inputFrames"] = QJsonArray();
+		info["ledDeviceWrites"] = QJsonObject();
 	}
 
 	// BEGIN | The following entries are deprecated but used to ensure backward compatibility with hyperionInstance Classic or up to hyperionInstance 2.0.16
@@ -156,7 +182,7 @@ QJsonArray JsonInfo::getPrioritiestInfo(const QSharedPointer<Hyperion>& hyperion
 QJsonArray JsonInfo::getPrioritiestInfo(int currentPriority, const PriorityMuxer::InputsMap& activeInputs)
 {
 	QJsonArray priorities;
-	int64_t now = QDateTime::currentMSecsSinceEpoch();
+	int64_t now = PriorityMuxer::currentTime_ms();
 
 	QList<int> activePriorities = activeInputs.keys();
 	activePriorities.removeAll(PriorityMuxer::LOWEST_PRIORITY);
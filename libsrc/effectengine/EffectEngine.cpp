@@ -228,7 +228,9 @@ int EffectEngine::runEffectScript(const QString &script, const QString &name, co
 	QSharedPointer<Hyperion> hyperion = _hyperionWeak.toStrongRef();
 	QSharedPointer<Effect> const effect = MAKE_TRACKED_SHARED(Effect, hyperion, priority, timeout, script, name, args, imageData);
 	connect(effect.get(), &Effect::setInput, hyperion.get(), &Hyperion::setInput, Qt::QueuedConnection);
-	connect(effect.get(), &Effect::setInputImage, hyperion.get(), &Hyperion::setInputImage, Qt::QueuedConnection);
+	connect(effect.get(), &Effect::setInputImage, hyperion.get(), [inbox = hyperion->getInputImageInbox()](int priority, const Image<ColorRgb>& image, int timeout_ms, bool clearEffect) {
+		inbox->post(priority, { image, timeout_ms, clearEffect });
+	}, Qt::DirectConnection);
 	connect(effect.get(), &QThread::finished, this, &EffectEngine::effectFinished);
 	_activeEffects.push_back(effect);
 
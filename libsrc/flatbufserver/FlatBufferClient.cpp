@@ -1,6 +1,7 @@
 #include "FlatBufferClient.h"
 #include <utils/PixelFormat.h>
 #include <utils/ColorRgba.h>
+#include <utils/LatencyMetrics.h>
 
 // qt
 #include <QTcpSocket>
@@ -181,6 +182,8 @@ void FlatBufferClient::handleRegisterCommand(const hyperionnet::Register *regReq
 
 void FlatBufferClient::handleImageCommand(const hyperionnet::Image *image)
 {
+	const qint64 receiveTime_ns = LatencyMetrics::monotonicTime_ns();
+
 	// extract parameters
 	int const duration = image->duration();
 
@@ -271,6 +274,7 @@ void FlatBufferClient::handleImageCommand(const hyperionnet::Image *image)
 										   << "size" << _imageOutputBuffer.width() << "x" << _imageOutputBuffer.height()
 										   << "and duration" << duration << "ms";
 
+	_imageOutputBuffer.setCaptureTime(receiveTime_ns);
 	emit setGlobalInputImage(_priority, _imageOutputBuffer, duration);
 	emit setBufferImage("FlatBuffer", _imageOutputBuffer);
 
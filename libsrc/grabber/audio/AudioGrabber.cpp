@@ -1,4 +1,5 @@
 #include <grabber/audio/AudioGrabber.h>
+#include <utils/LatencyMetrics.h>
 #include <math.h>
 #include <QImage>
 #include <QObject>
@@ -100,6 +101,8 @@ void AudioGrabber::resetMultiplier()
 
 void AudioGrabber::processAudioFrame(int16_t* buffer, int length)
 {
+	const qint64 captureTime_ns = LatencyMetrics::monotonicTime_ns();
+
 	// Apply Visualizer and Construct Image
 
 	// TODO: Pass Audio Frame to python and let the script calculate the image.
@@ -184,6 +187,8 @@ void AudioGrabber::processAudioFrame(int16_t* buffer, int length)
 		memcpy((unsigned char*)finalImage.memptr() + y * image.width() * 3, static_cast<unsigned char*>(image.scanLine(y)), image.width() * 3);
 	}
 
+	finalImage.setCaptureTime(captureTime_ns);
+
 	emit newFrame(finalImage);
 }
 
@@ -5,6 +5,7 @@
 EncoderThread::EncoderThread()
 	: _localData(nullptr)
 	, _scalingFactorsCount(0)
+	, _captureTime_ns(0)
 	, _doTransform(false)
 	, _imageResampler()
 	, _tjInstance(nullptr)
@@ -38,7 +39,8 @@ void EncoderThread::setup(
 		PixelFormat pixelFormat, uint8_t* sharedData,
 		int size, int width, int height, int lineLength,
 		int cropLeft, int cropTop, int cropBottom, int cropRight,
-		VideoMode videoMode, FlipMode flipMode, int pixelDecimation)
+		VideoMode videoMode, FlipMode flipMode, int pixelDecimation,
+		qint64 captureTime_ns)
 {
 	_lineLength = lineLength;
 	_pixelFormat = pixelFormat;
@@ -52,6 +54,7 @@ void EncoderThread::setup(
 	_flipMode = flipMode;
 	_videoMode = videoMode;
 	_pixelDecimation = pixelDecimation;
+	_captureTime_ns = captureTime_ns;
 
 	bool needTransform {false};
 
@@ -134,6 +137,7 @@ void EncoderThread::process()
 				image
 			);
 
+			image.setCaptureTime(_captureTime_ns);
 			emit newFrame(image);
 		}
 	}
@@ -316,6 +320,7 @@ void EncoderThread::processImageMjpeg()
 			return;
 		}
 	}
+	srcImage.setCaptureTime(_captureTime_ns);
 	emit newFrame(srcImage);
 }
 #endif
@@ -1,6 +1,8 @@
 #include "MFSourceReaderCB.h"
 #include "grabber/video/mediafoundation/MFGrabber.h"
 
+#include <utils/LatencyMetrics.h>
+
 
 // Need more video properties? Visit https://docs.microsoft.com/en-us/windows/win32/api/strmif/ne-strmif-videoprocampproperty
 using VideoProcAmpPropertyMap = QMap<VideoProcAmpProperty, QString>;
@@ -542,6 +544,7 @@ void MFGrabber::start_capturing()
 
 void MFGrabber::process_image(const void *frameImageBuffer, int size)
 {
+	const qint64 captureTime_ns = LatencyMetrics::monotonicTime_ns();
 	int processFrameIndex = _currentFrame++;
 
 	// frame skipping
@@ -561,7 +564,7 @@ void MFGrabber::process_image(const void *frameImageBuffer, int size)
 		{
 			if (!_threadManager->_threads[i]->isBusy())
 			{
-				_threadManager->_threads[i]->setup(_pixelFormat, (uint8_t*)frameImageBuffer, size, _width, _height, _lineLength, _cropLeft, _cropTop, _cropBottom, _cropRight, _videoMode, _flipMode, _pixelDecimation);
+				_threadManager->_threads[i]->setup(_pixelFormat, (uint8_t*)frameImageBuffer, size, _width, _height, _lineLength, _cropLeft, _cropTop, _cropBottom, _cropRight, _videoMode, _flipMode, _pixelDecimation, captureTime_ns);
 				_threadManager->_threads[i]->process();
 				break;
 			}
@@ -28,6 +28,8 @@
 #include "grabber/video/v4l2/V4L2Grabber.h"
 #include "grabber/video/v4l2/V4L2GrabberDebug.h"
 
+#include <utils/LatencyMetrics.h>
+
 using namespace V4L2GrabberDebug;
 
 #define CLEAR(x) memset(&(x), 0, sizeof(x))
@@ -62,6 +64,17 @@ inline QMap<unsigned int, QString> initControlIDPropertyMap()
 
 Q_GLOBAL_STATIC_WITH_ARGS(ControlIDPropertyMap, _controlIDPropertyMap, (initControlIDPropertyMap()));
 
+// Capture time of a dequeued buffer on the monotonic clock.
+// The driver's timestamp is used if it is taken from the monotonic clock, otherwise the time of dequeuing.
+static qint64 captureTime(const struct v4l2_buffer& buf)
+{
+	if ((buf.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) == V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC && (buf.timestamp.tv_sec != 0 || buf.timestamp.tv_usec != 0))
+	{
+		return static_cast<qint64>(buf.timestamp.tv_sec) * 1000000000 + static_cast<qint64>(buf.timestamp.tv_usec) * 1000;
+	}
+	return LatencyMetrics::monotonicTime_ns();
+}
+
 static PixelFormat GetPixelFormat(const unsigned int format)
 {
 	if (format == V4L2_PIX_FMT_RGB32) return PixelFormat::RGB32;
@@ -1070,7 +1083,7 @@ int V4L2Grabber::read_frame()
 					}
 				}
 
-				rc = process_image(_buffers[0].start, size);
+				rc = process_image(_buffers[0].start, size, LatencyMetrics::monotonicTime_ns());
 			}
 			break;
 
@@ -1101,7 +1114,7 @@ int V4L2Grabber::read_frame()
 
 				assert(buf.index < _buffers.size());
 
-				rc = process_image(_buffers[buf.index].start, buf.bytesused);
+				rc = process_image(_buffers[buf.index].start, buf.bytesused, captureTime(buf));
 
 				if (-1 == xioctl(VIDIOC_QBUF, &buf))
 				{
@@ -1144,7 +1157,7 @@ int V4L2Grabber::read_frame()
 					}
 				}
 
-				rc = process_image((void *)buf.m.userptr, buf.bytesused);
+				rc = process_image((void *)buf.m.userptr, buf.bytesused, captureTime(buf));
 
 				if (!rc && -1 == xioctl(VIDIOC_QBUF, &buf))
 				{
@@ -1164,7 +1177,7 @@ int V4L2Grabber::read_frame()
 	return rc ? 1 : 0;
 }
 
-bool V4L2Grabber::process_image(const void *p, int size)
+bool V4L2Grabber::process_image(const void *p, int size, qint64 captureTime_ns)
 {
 	int processFrameIndex = _currentFrame++, result = false;
 
@@ -1186,7 +1199,7 @@ bool V4L2Grabber::process_image(const void *p, int size)
 		{
 			if (!_threadManager->_threads[i]->isBusy())
 			{
-				_threadManager->_threads[i]->setup(_pixelFormat, (uint8_t*)p, size, _width, _height, _lineLength, _cropLeft, _cropTop, _cropBottom, _cropRight, _videoMode, _flipMode, _pixelDecimation);
+				_threadManager->_threads[i]->setup(_pixelFormat, (uint8_t*)p, size, _width, _height, _lineLength, _cropLeft, _cropTop, _cropBottom, _cropRight, _videoMode, _flipMode, _pixelDecimation, captureTime_ns);
 				_threadManager->_threads[i]->process();
 				result = true;
 				break;
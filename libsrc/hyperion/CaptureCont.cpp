@@ -1,6 +1,7 @@
 #include <hyperion/CaptureCont.h>
 
 #include <chrono>
+#include <utility>
 
 #include <QTimer>
 
@@ -34,11 +35,19 @@ CaptureCont::CaptureCont(const QSharedPointer<Hyperion>& hyperionInstance)
 	, _audioCaptureInactiveTimer(nullptr)
 {
 	TRACK_SCOPE();
+
+	// a captured image queues one delivery into the instance's thread, images captured meanwhile replace it
+	_imageInbox.reset(new FrameInbox<CapturedImage>(CAPTURE_SLOTS, [this](int slot) {
+		QMetaObject::invokeMethod(this, [this, slot]() { deliverImage(slot); }, Qt::QueuedConnection);
+	}));
 }
 
 CaptureCont::~CaptureCont()
 {
 	TRACK_SCOPE();
+
+	// grabber threads may still hold the inbox
+	_imageInbox->close();
 }
 
 void CaptureCont::start()
@@ -93,6 +102,57 @@ void CaptureCont::stop()
 	disconnect(_audioCaptureInactiveTimer.get(), &QTimer::timeout, this, &CaptureCont::onAudioIsInactive);
 }
 
+QMap<int, FrameCounters> CaptureCont::getImageCounters() const
+{
+	QMap<int, FrameCounters> counters;
+	const std::pair<int, CaptureSlot> captures[] = {
+		{ _screenCapturePriority, SCREEN_CAPTURE },
+		{ _videoCapturePriority, VIDEO_CAPTURE },
+		{ _audioCapturePriority, AUDIO_CAPTURE }
+	};
+	for (const auto& capture : captures)
+	{
+		const FrameCounters captureCounters = _imageInbox->counters(capture.second);
+		if (captureCounters.posted > 0)
+		{
+			counters.insert(capture.first, captureCounters);
+		}
+	}
+	return counters;
+}
+
+void CaptureCont::connectCapture(void (GlobalSignals::*signal)(const QString&, const Image<ColorRgb>&), CaptureSlot slot)
+{
+	// images are posted from the grabbers' threads directly, only the latest per capture input is handled
+	connect(GlobalSignals::getInstance(), signal, this, [inbox = _imageInbox, slot](const QString& name, const Image<ColorRgb>& image) {
+		inbox->post(slot, { name, image });
+	}, Qt::DirectConnection);
+}
+
+void CaptureCont::deliverImage(int slot)
+{
+	CapturedImage captured;
+	if (!_imageInbox->take(slot, captured))
+	{
+		return;
+	}
+
+	switch (slot)
+	{
+	case SCREEN_CAPTURE:
+		handleScreenImage(captured.name, captured.image);
+		break;
+	case VIDEO_CAPTURE:
+		handleVideoImage(captured.name, captured.image);
+		break;
+	case AUDIO_CAPTURE:
+		handleAudioImage(captured.name, captured.image);
+		break;
+	default:
+		break;
+	}
+}
+
 void CaptureCont::handleVideoImage(const QString& name, const Image<ColorRgb> & image)
 {
 	QSharedPointer<Hyperion> hyperion = _hyperionWeak.toStrongRef();
@@ -143,7 +203,7 @@ void CaptureCont::setScreenCaptureEnable(bool enable)
 		if(enable)
 		{
 			hyperion->registerInput(_screenCapturePriority, hyperion::COMP_GRABBER);
-			connect(GlobalSignals::getInstance(), &GlobalSignals::setSystemImage, this, &CaptureCont::handleScreenImage);
+			connectCapture(&GlobalSignals::setSystemImage, SCREEN_CAPTURE);
 			connect(GlobalSignals::getInstance(), &GlobalSignals::setSystemImage, hyperion.get(), &Hyperion::forwardSystemProtoMessage);
 		}
 		else
@@ -151,6 +211,10 @@ void CaptureCont::setScreenCaptureEnable(bool enable)
 			disconnect(GlobalSignals::getInstance(), &GlobalSignals::setSystemImage, hyperion.get(), &Hyperion::forwardSystemProtoMessage);
 			disconnect(GlobalSignals::getInstance(), &GlobalSignals::setSystemImage, this, nullptr);
 
+			// drop an image not handled yet
+			CapturedImage pending;
+			_imageInbox->take(SCREEN_CAPTURE, pending);
+
 			hyperion->clear(_screenCapturePriority);
 			_screenCaptureInactiveTimer->stop();
 			_screenCaptureName = "";
@@ -170,7 +234,7 @@ void CaptureCont::setVideoCaptureEnable(bool enable)
 		if(enable)
 		{
 			hyperion->registerInput(_videoCapturePriority, hyperion::COMP_V4L);
-			connect(GlobalSignals::getInstance(), &GlobalSignals::setV4lImage, this, &CaptureCont::handleVideoImage);
+			connectCapture(&GlobalSignals::setV4lImage, VIDEO_CAPTURE);
 			connect(GlobalSignals::getInstance(), &GlobalSignals::setV4lImage, hyperion.get(), &Hyperion::forwardV4lProtoMessage);
 		}
 		else
@@ -178,6 +242,10 @@ void CaptureCont::setVideoCaptureEnable(bool enable)
 			disconnect(GlobalSignals::getInstance(), &GlobalSignals::setV4lImage, hyperion.get(), &Hyperion::forwardV4lProtoMessage);
 			disconnect(GlobalSignals::getInstance(), &GlobalSignals::setV4lImage, this, nullptr);
 
+			// drop an image not handled yet
+			CapturedImage pending;
+			_imageInbox->take(VIDEO_CAPTURE, pending);
+
 			hyperion->clear(_videoCapturePriority);
 			_videoInactiveTimer->stop();
 			_videoCaptureName = "";
@@ -197,7 +265,7 @@ void CaptureCont::setAudioCaptureEnable(bool enable)
 		if (enable)
 		{
 			hyperion->registerInput(_audioCapturePriority, hyperion::COMP_AUDIO);
-			connect(GlobalSignals::getInstance(), &GlobalSignals::setAudioImage, this, &CaptureCont::handleAudioImage);
+			connectCapture(&GlobalSignals::setAudioImage, AUDIO_CAPTURE);
 			connect(GlobalSignals::getInstance(), &GlobalSignals::setAudioImage, hyperion.get(), &Hyperion::forwardAudioProtoMessage);
 		}
 		else
@@ -205,6 +273,10 @@ void CaptureCont::setAudioCaptureEnable(bool enable)
 			disconnect(GlobalSignals::getInstance(), &GlobalSignals::setAudioImage, hyperion.get(), &Hyperion::forwardAudioProtoMessage);
 			disconnect(GlobalSignals::getInstance(), &GlobalSignals::setAudioImage, this, nullptr);
 
+			// drop an image not handled yet
+			CapturedImage pending;
+			_imageInbox->take(AUDIO_CAPTURE, pending);
+
 			hyperion->clear(_audioCapturePriority);
 			_audioCaptureInactiveTimer->stop();
 			_audioCaptureName = "";
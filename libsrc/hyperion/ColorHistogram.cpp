@@ -0,0 +1,40 @@
+#include <hyperion/ColorHistogram.h>
+
+#include <algorithm>
+#include <memory>
+
+using namespace hyperion;
+
+ColorHistogram::Counters::Counters(uint32_t size)
+	: _entries(size)
+	, _generation(0)
+{
+	clear();
+}
+
+void ColorHistogram::Counters::clear()
+{
+	std::fill(_entries.begin(), _entries.end(), Entry{0, 0});
+	_generation = 1;
+}
+
+ColorHistogram::ColorHistogram(int bitsPerChannel)
+	: _bits(std::clamp(bitsPerChannel, MIN_BITS_PER_CHANNEL, MAX_BITS_PER_CHANNEL))
+	, _shift(8 - _bits)
+	, _bins(1U << (3 * _bits))
+	, _colors(1U << (3 * _shift))
+{
+}
+
+ColorHistogram& ColorHistogram::threadLocal(int bitsPerChannel)
+{
+	// LED areas may be processed in parallel, every thread uses its own tables
+	thread_local std::unique_ptr<ColorHistogram> histogram;
+
+	const int bits = std::clamp(bitsPerChannel, MIN_BITS_PER_CHANNEL, MAX_BITS_PER_CHANNEL);
+	if (!histogram || histogram->bitsPerChannel() != bits)
+	{
+		histogram = std::make_unique<ColorHistogram>(bits);
+	}
+	return *histogram;
+}
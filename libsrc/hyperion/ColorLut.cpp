@@ -0,0 +1,107 @@
+#include <hyperion/ColorLut.h>
+#include <hyperion/ColorAdjustment.h>
+#include <hyperion/MultiColorAdjustment.h>
+
+#include <algorithm>
+
+using namespace hyperion;
+
+namespace {
+
+/// Grid of the gamma corrected colors, the channel adjustments are nearly linear
+constexpr int GRID_SIZE_GAMMA_CORRECTED = 33;
+/// Grid of the raw colors, which covers the non-linear OkHSV transform and gamma as well
+constexpr int GRID_SIZE_RAW = 65;
+
+} // namespace
+
+ColorLut::Settings::Settings(const ColorAdjustment& adjustment)
+{
+	const RgbChannelAdjustment* const channelAdjustments[] = {
+		&adjustment._rgbBlackAdjustment, &adjustment._rgbWhiteAdjustment,
+		&adjustment._rgbRedAdjustment, &adjustment._rgbGreenAdjustment, &adjustment._rgbBlueAdjustment,
+		&adjustment._rgbCyanAdjustment, &adjustment._rgbMagentaAdjustment, &adjustment._rgbYellowAdjustment
+	};
+	for (size_t idx = 0; idx < channels.size(); ++idx)
+	{
+		channels[idx] = {channelAdjustments[idx]->getAdjustmentR(), channelAdjustments[idx]->getAdjustmentG(), channelAdjustments[idx]->getAdjustmentB()};
+	}
+
+	gamma = {adjustment._rgbTransform.getGammaR(), adjustment._rgbTransform.getGammaG(), adjustment._rgbTransform.getGammaB()};
+	adjustment._rgbTransform.getBrightnessComponents(brightness[0], brightness[1], brightness[2]);
+	temperature = adjustment._rgbTransform.getTemperature();
+	saturationGain = adjustment._okhsvTransform.getSaturationGain();
+	brightnessGain = adjustment._okhsvTransform.getBrightnessGain();
+}
+
+bool ColorLut::Settings::operator==(const Settings& other) const
+{
+	return channels == other.channels && gamma == other.gamma && brightness == other.brightness
+		&& temperature == other.temperature && saturationGain == other.saturationGain && brightnessGain == other.brightnessGain;
+}
+
+ColorLut::ColorLut(const Settings& settings, int gridSize)
+	: _settings(settings)
+	, _gridSize(gridSize)
+	, _step(256 / (gridSize - 1))
+	, _strideR(static_cast<uint32_t>(gridSize * gridSize))
+	, _strideG(static_cast<uint32_t>(gridSize))
+	, _offset{}
+	, _fraction{}
+	, _table(static_cast<size_t>(gridSize) * gridSize * gridSize)
+{
+}
+
+uint8_t ColorLut::nodeValue(int node) const
+{
+	return static_cast<uint8_t>(std::min(node * _step, static_cast<int>(UINT8_MAX)));
+}
+
+QSharedPointer<const ColorLut> ColorLut::bake(ColorAdjustment adjustment)
+{
+	const bool isGammaCorrectedGrid = adjustment._okhsvTransform.isIdentity();
+	QSharedPointer<ColorLut> lut(new ColorLut(Settings(adjustment), isGammaCorrectedGrid ? GRID_SIZE_GAMMA_CORRECTED : GRID_SIZE_RAW));
+
+	// Input shaper: the position of every channel value on the grid, gamma corrected if the grid is
+	const uint32_t strides[3] = {lut->_strideR, lut->_strideG, 1};
+	for (int value = 0; value <= UINT8_MAX; ++value)
+	{
+		uint8_t coordinates[3] = {static_cast<uint8_t>(value), static_cast<uint8_t>(value), static_cast<uint8_t>(value)};
+		if (isGammaCorrectedGrid)
+		{
+			adjustment._rgbTransform.applyGamma(coordinates[0], coordinates[1], coordinates[2]);
+		}
+
+		for (int channel = 0; channel < 3; ++channel)
+		{
+			const int node = std::min(coordinates[channel] / lut->_step, lut->_gridSize - 2);
+			const int lower = lut->nodeValue(node);
+			const int width = lut->nodeValue(node + 1) - lower;
+			lut->_offset[channel][value] = static_cast<uint32_t>(node) * strides[channel];
+			lut->_fraction[channel][value] = static_cast<uint16_t>(((coordinates[channel] - lower) * 256 + width / 2) / width);
+		}
+	}
+
+	// The grid points are calculated by the reference implementation, i.e. the table is exact on the grid
+	ColorRgb* entry = lut->_table.data();
+	for (int red = 0; red < lut->_gridSize; ++red)
+	{
+		for (int green = 0; green < lut->_gridSize; ++green)
+		{
+			for (int blue = 0; blue < lut->_gridSize; ++blue, ++entry)
+			{
+				*entry = {lut->nodeValue(red), lut->nodeValue(green), lut->nodeValue(blue)};
+				if (isGammaCorrectedGrid)
+				{
+					MultiColorAdjustment::calculateChannelAdjustment(adjustment, *entry);
+				}
+				else
+				{
+					MultiColorAdjustment::calculateAdjustment(adjustment, *entry);
+				}
+			}
+		}
+	}
+
+	return lut;
+}
@@ -33,6 +33,7 @@ GrabberWrapper::GrabberWrapper(const QString& grabberName, Grabber * ggrabber, i
 	, _grabberName(grabberName)
 	, _timer(nullptr)
 	, _updateInterval_ms(1000/updateRate_Hz)
+	, _grabLatency(LatencyMetrics::getInstance().histogram(LatencyMetrics::STAGE_GRAB, QString(), grabberName))
 {
 	TRACK_SCOPE();
 	GrabberWrapper::instance = this;
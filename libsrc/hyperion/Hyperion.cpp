@@ -1,10 +1,12 @@
 // STL includes
 #include<algorithm>
+#include <cstring>
 
 // QT includes
 #include <QString>
 #include <QStringList>
 #include <QThread>
+#include <QThreadPool>
 #include <QVariantMap>
 
 // hyperion include
@@ -53,6 +55,36 @@ Q_LOGGING_CATEGORY(instance_update, "hyperion.instance.update");
 namespace {
 	const double DEFAULT_SKIPPEDUPDATES_LOWERBOUND = {5}; // Report skipped updates only if greater 5%
 	constexpr std::chrono::seconds DEFAULT_STATISTICS_INTERVAL{ 60 }; //Generate statistics every 60 seconds
+	constexpr std::chrono::milliseconds STATIC_FRAME_REFRESH_INTERVAL{ 1000 }; //Process static frames at least every second
+	constexpr int STATIC_FRAME_ROW_SAMPLING = 4; //Hash every 4th row for the static frame detection
+
+	///
+	/// Hash of the bytes of every STATIC_FRAME_ROW_SAMPLING row of an image, 64bit words at a time
+	///
+	quint64 sampledImageHash(const Image<ColorRgb>& image)
+	{
+		const auto* data = reinterpret_cast<const uint8_t*>(image.memptr());
+		const size_t rowBytes = static_cast<size_t>(image.width()) * sizeof(ColorRgb);
+
+		quint64 hash = 0x9E3779B97F4A7C15ULL ^ rowBytes;
+		for (int row = STATIC_FRAME_ROW_SAMPLING / 2; row < image.height(); row += STATIC_FRAME_ROW_SAMPLING)
+		{
+			const uint8_t* rowData = data + static_cast<size_t>(row) * rowBytes;
+			size_t idx = 0;
+			for (; idx + sizeof(quint64) <= rowBytes; idx += sizeof(quint64))
+			{
+				quint64 word;
+				std::memcpy(&word, rowData + idx, sizeof(word));
+				hash = (hash ^ word) * 0x100000001B3ULL;
+				hash ^= hash >> 29;
+			}
+			for (; idx < rowBytes; ++idx)
+			{
+				hash = (hash ^ rowData[idx]) * 0x100000001B3ULL;
+			}
+		}
+		return hash;
+	}
 } //End of constants
 
 Hyperion::Hyperion(quint8 instance, QObject* parent)
@@ -87,12 +119,30 @@ Hyperion::Hyperion(quint8 instance, QObject* parent)
 
 	_log = Logger::getInstance("HYPERION", subComponent);
 	TRACK_SCOPE_SUBCOMPONENT();
+
+	_mappingLatency = LatencyMetrics::getInstance().histogram(LatencyMetrics::STAGE_MAPPING, subComponent);
+	_adjustmentLatency = LatencyMetrics::getInstance().histogram(LatencyMetrics::STAGE_ADJUSTMENT, subComponent);
+	_endToEndLatency = LatencyMetrics::getInstance().histogram(LatencyMetrics::STAGE_END_TO_END, subComponent);
+
+	// a posted image queues one delivery into the instance's thread, images posted meanwhile replace it
+	_inputImageInbox.reset(new InputImageInbox(PriorityMuxer::PRIORITY_SLOTS, [this](int priority) {
+		QMetaObject::invokeMethod(this, [this, priority]() { deliverInputImage(priority); }, Qt::QueuedConnection);
+	}));
+
+	_colorLutReceiver.reset(new QueuedReceiver(this));
+	_inputCallReceiver.reset(new QueuedReceiver(this));
 }
 
 Hyperion::~Hyperion()
 {
 	Debug(_log, "Hyperion instance [%u] is stopping...", _instIndex);
 	TRACK_SCOPE_SUBCOMPONENT();
+
+	// producers may still hold the inbox
+	_inputImageInbox->close();
+	_inputCallReceiver->close();
+	// color lookup tables may still be baked in the background
+	_colorLutReceiver->close();
 }
 
 void Hyperion::start()
@@ -133,7 +183,7 @@ void Hyperion::start()
 
 	QJsonArray const ledLayout = getSetting(settings::LEDS).array();
 	updateLedLayout(ledLayout);
-	_ledBuffer = QVector<ColorRgb>(static_cast<size_t>(_hwLedCount), ColorRgb::BLACK);
+	_ledBuffer.resize(_hwLedCount);
 
 	// smoothing
 	_deviceSmooth = MAKE_TRACKED_SHARED(LinearColorSmoothing, getSetting(settings::SMOOTHING).object(), sharedFromThis());
@@ -146,7 +196,8 @@ void Hyperion::start()
 
 	_ledDeviceWrapper = MAKE_TRACKED_SHARED(LedDeviceWrapper, sharedFromThis());
 	connect(this, &Hyperion::compStateChangeRequest, _ledDeviceWrapper.get(), &LedDeviceWrapper::handleComponentState);
-	connect(this, &Hyperion::ledDeviceData, _ledDeviceWrapper.get(), &LedDeviceWrapper::updateLeds);
+	// Direct, frames emitted by the output pacing thread of the smoothing are queued to the device thread only
+	connect(this, &Hyperion::ledDeviceData, _ledDeviceWrapper.get(), &LedDeviceWrapper::updateLeds, Qt::DirectConnection);
 
 	_ledDeviceWrapper->createLedDevice(ledDeviceSettings);
 
@@ -173,10 +224,22 @@ void Hyperion::start()
 	_captureCont->start();
 
 	// link global signals with the corresponding slots
-	connect(GlobalSignals::getInstance(), &GlobalSignals::registerGlobalInput, this, &Hyperion::registerInput);
-	connect(GlobalSignals::getInstance(), &GlobalSignals::clearGlobalInput, this, &Hyperion::clear);
 	connect(GlobalSignals::getInstance(), &GlobalSignals::setGlobalColor, this, &Hyperion::setColor);
-	connect(GlobalSignals::getInstance(), &GlobalSignals::setGlobalImage, this, &Hyperion::setInputImage);
+	// images are posted from the servers' threads directly, only the latest per priority is applied
+	connect(GlobalSignals::getInstance(), &GlobalSignals::setGlobalImage, this, [inbox = _inputImageInbox](int priority, const Image<ColorRgb>& image, int timeout_ms, bool clearEffect) {
+		inbox->post(priority, { image, timeout_ms, clearEffect });
+	}, Qt::DirectConnection);
+	// registrations and clears are queued from the servers' threads as well, in order with their images
+	connect(GlobalSignals::getInstance(), &GlobalSignals::registerGlobalInput, this, [inbox = _inputImageInbox, receiver = _inputCallReceiver, instance = this](int priority, hyperion::Components component, const QString& origin, const QString& owner, unsigned smooth_cfg) {
+		postInputCall(inbox, receiver, instance, priority, [instance, priority, component, origin, owner, smooth_cfg]() {
+			instance->registerInput(priority, component, origin, owner, smooth_cfg);
+		});
+	}, Qt::DirectConnection);
+	connect(GlobalSignals::getInstance(), &GlobalSignals::clearGlobalInput, this, [inbox = _inputImageInbox, receiver = _inputCallReceiver, instance = this](int priority, bool forceClearAll) {
+		postInputCall(inbox, receiver, instance, priority, [instance, priority, forceClearAll]() {
+			instance->clear(priority, forceClearAll);
+		});
+	}, Qt::DirectConnection);
 
 	// if there is no startup / background effect and no sending capture interface we probably want to push once BLACK (as PrioMuxer won't emit a priority change)
 	refreshUpdate();
@@ -203,6 +266,7 @@ void Hyperion::stop(const QString name)
 	_BGEffectHandler->stop();
 
 	_captureCont->stop();
+	_inputImageInbox->close();
 
 #if defined(ENABLE_BOBLIGHT_SERVER)
 	_boblightServer->stop();
@@ -263,7 +327,7 @@ void Hyperion::handleSettingsUpdate(settings::type type, const QJsonDocument& co
 		_colorOrder = _ledDeviceWrapper->getColorOrder();
 
 		updateLedLayout(getSetting(settings::LEDS).array());
-		_ledBuffer.fill(ColorRgb::BLACK, _hwLedCount);
+		_ledBuffer.resize(_hwLedCount);
 	}
 }
 
@@ -275,6 +339,80 @@ void Hyperion::updateLedColorAdjustment(int ledCount, const QJsonObject& colors)
 	{
 		Warning(_log, "At least one LED has no color calibration, please add all LEDs from your LED layout to an 'LED index' field!");
 	}
+
+	_ledOutput.compile(_ledStringColorOrder, _ledString.blacklistedLedIds(), _raw2ledAdjustment.data());
+	updateColorLuts();
+}
+
+void Hyperion::updateColorLuts()
+{
+	QList<QSharedPointer<const hyperion::ColorLut>> colorLuts;
+	for (ColorAdjustment* adjustment : _raw2ledAdjustment->getAdjustments())
+	{
+		const hyperion::ColorLut::Settings settings(*adjustment);
+		const auto lut = std::find_if(_colorLuts.cbegin(), _colorLuts.cend(), [&settings](const QSharedPointer<const hyperion::ColorLut>& colorLut) {
+			return colorLut->settings() == settings;
+		});
+
+		if (lut != _colorLuts.cend())
+		{
+			adjustment->_lut = *lut;
+			if (!colorLuts.contains(*lut))
+			{
+				colorLuts.append(*lut);
+			}
+		}
+		else
+		{
+			adjustment->_lut.reset();
+			bakeColorLutInBackground(*adjustment);
+		}
+	}
+	_colorLuts = colorLuts;
+}
+
+void Hyperion::bakeColorLutInBackground(const ColorAdjustment& adjustment)
+{
+	const hyperion::ColorLut::Settings settings(adjustment);
+	if (_colorLutsInBake.contains(settings))
+	{
+		return;
+	}
+	_colorLutsInBake.append(settings);
+
+	qCDebug(instance_flow) << "Bake color lookup table for adjustment" << adjustment._id << "in background";
+
+	// The worker bakes a copy, the adjustment itself may change meanwhile
+	QThreadPool::globalInstance()->start([receiver = _colorLutReceiver, instance = this, adjustment]() {
+		const QSharedPointer<const hyperion::ColorLut> lut = hyperion::ColorLut::bake(adjustment);
+
+		// The call is only made while the instance exists
+		receiver->invoke([instance, lut]() {
+			instance->handleColorLutBaked(lut);
+		});
+	});
+}
+
+void Hyperion::handleColorLutBaked(const QSharedPointer<const hyperion::ColorLut>& lut)
+{
+	_colorLutsInBake.removeAll(lut->settings());
+
+	// Processing runs on this thread, i.e. the table is swapped in between two frames
+	bool isAssigned = false;
+	for (ColorAdjustment* adjustment : _raw2ledAdjustment->getAdjustments())
+	{
+		if (adjustment->_lut.isNull() && hyperion::ColorLut::Settings(*adjustment) == lut->settings())
+		{
+			adjustment->_lut = lut;
+			isAssigned = true;
+		}
+	}
+
+	if (isAssigned)
+	{
+		qCDebug(instance_flow) << "Swap in color lookup table with" << lut->gridSize() << "grid points per color channel";
+		_colorLuts.append(lut);
+	}
 }
 
 void Hyperion::updateLedLayout(const QJsonArray& ledLayout)
@@ -302,10 +440,8 @@ void Hyperion::updateLedLayout(const QJsonArray& ledLayout)
 
 	_muxer->updateLedColorsLength(_layoutLedCount);
 
-	if (_layoutLedCount < static_cast<int>(_ledBuffer.size()))
-	{
-		std::fill(_ledBuffer.begin() + _layoutLedCount, _ledBuffer.end(), ColorRgb{ 0, 0, 0 });
-	}
+	_rawLedColors.resize(_layoutLedCount);
+	_ledBuffer.fillFrom(ColorRgb::BLACK, _layoutLedCount);
 }
 
 QJsonDocument Hyperion::getSetting(settings::type type) const
@@ -323,6 +459,11 @@ int Hyperion::getLatchTime() const
 	return _ledDeviceWrapper->getLatchTime();
 }
 
+LedDevice::WriteStatistics Hyperion::getLedDeviceWriteStatistics() const
+{
+	return _ledDeviceWrapper->getWriteStatistics();
+}
+
 unsigned Hyperion::addSmoothingConfig(int settlingTime_ms, double ledUpdateFrequency_hz, unsigned updateDelay)
 {
 	return _deviceSmooth->addConfig(settlingTime_ms, ledUpdateFrequency_hz, updateDelay);
@@ -429,6 +570,7 @@ bool Hyperion::setInput(int priority, const QVector<ColorRgb>& ledColors, int ti
 		// if this priority is visible, update immediately
 		if (priority == _muxer->getCurrentPriority())
 		{
+			markInputReceived();
 			update();
 		}
 
@@ -466,7 +608,8 @@ bool Hyperion::setInputImage(int priority, const Image<ColorRgb>& image, int64_t
 		// if this priority is visible, update immediately
 		if (priority == _muxer->getCurrentPriority())
 		{
-			update();
+			markInputReceived();
+			scheduleUpdate();
 		}
 
 		return true;
@@ -474,6 +617,90 @@ bool Hyperion::setInputImage(int priority, const Image<ColorRgb>& image, int64_t
 	return false;
 }
 
+void Hyperion::postInputImage(int priority, const Image<ColorRgb>& image, int64_t timeout_ms, bool clearEffect)
+{
+	if (priority < 0 || priority >= _inputImageInbox->slotCount())
+	{
+		Error(_log, "Image not set, invalid priority: %d", priority);
+		return;
+	}
+	_inputImageInbox->post(priority, { image, timeout_ms, clearEffect });
+}
+
+void Hyperion::deliverInputImage(int priority)
+{
+	InputImage input;
+	if (_inputImageInbox->take(priority, input))
+	{
+		setInputImage(priority, input.image, input.timeout_ms, input.clearEffect);
+	}
+}
+
+void Hyperion::postRegisterInput(int priority, hyperion::Components component, const QString& origin, const QString& owner, unsigned smooth_cfg)
+{
+	postInputCall(_inputImageInbox, _inputCallReceiver, this, priority, [this, priority, component, origin, owner, smooth_cfg]() {
+		registerInput(priority, component, origin, owner, smooth_cfg);
+	});
+}
+
+void Hyperion::postClear(int priority, bool forceClearAll)
+{
+	postInputCall(_inputImageInbox, _inputCallReceiver, this, priority, [this, priority, forceClearAll]() {
+		clear(priority, forceClearAll);
+	});
+}
+
+void Hyperion::postInputCall(const QSharedPointer<InputImageInbox>& inbox, const QSharedPointer<QueuedReceiver>& receiver,
+							 Hyperion* instance, int priority, const std::function<void()>& call)
+{
+	// the delivery already queued for a pending image might run behind the call, so the image is taken along.
+	// Images posted afterwards find their mailbox empty and queue a new delivery behind the call.
+	QVector<QPair<int, InputImage>> pending;
+	const int first = priority < 0 ? 0 : priority;
+	const int last = priority < 0 ? inbox->slotCount() - 1 : priority;
+	for (int slot = first; slot <= last; ++slot)
+	{
+		InputImage input;
+		if (inbox->take(slot, input))
+		{
+			pending.append({ slot, input });
+		}
+	}
+
+	receiver->invoke([instance, pending, call]() {
+		for (const auto& input : pending)
+		{
+			instance->setInputImage(input.first, input.second.image, input.second.timeout_ms, input.second.clearEffect);
+		}
+		call();
+	});
+}
+
+QMap<int, FrameCounters> Hyperion::getInputImageCounters() const
+{
+	QMap<int, FrameCounters> counters;
+	for (int priority = 0; priority < _inputImageInbox->slotCount(); ++priority)
+	{
+		const FrameCounters inputCounters = _inputImageInbox->counters(priority);
+		if (inputCounters.posted > 0)
+		{
+			counters.insert(priority, inputCounters);
+		}
+	}
+
+	if (!_captureCont.isNull())
+	{
+		const QMap<int, FrameCounters> captureCounters = _captureCont->getImageCounters();
+		for (auto it = captureCounters.cbegin(); it != captureCounters.cend(); ++it)
+		{
+			FrameCounters& inputCounters = counters[it.key()];
+			inputCounters.posted += it.value().posted;
+			inputCounters.dropped += it.value().dropped;
+		}
+	}
+	return counters;
+}
+
 bool Hyperion::setInputInactive(int priority)
 {
 	if (!_muxer.isNull())
@@ -542,6 +769,9 @@ ColorAdjustment* Hyperion::getAdjustment(const QString& identifier) const
 
 void Hyperion::adjustmentsUpdated()
 {
+	// Rebake the tables of the changed adjustments on the instance's thread
+	QMetaObject::invokeMethod(this, [this]() { updateColorLuts(); });
+
 	emit adjustmentChanged();
 	refreshUpdate();
 }
@@ -701,70 +931,21 @@ void Hyperion::handleSourceAvailability(int priority)
 	}
 }
 
-void Hyperion::applyBlacklist(QVector<ColorRgb>& ledColors)
-{
-	if (_ledString.hasBlackListedLeds())
-	{
-		for (const auto& id : _ledString.blacklistedLedIds())
-		{
-			if (id < ledColors.size())
-			{
-				ledColors[id] = ColorRgb::BLACK;
-			}
-		}
-	}
-}
-
-void Hyperion::applyColorOrder(QVector<ColorRgb>& ledColors) const
-{
-	assert(ledColors.size() >= _ledStringColorOrder.size());
-
-	// Only apply color order for LEDs defined by layout
-	for (auto i = 0; i < _ledStringColorOrder.size(); ++i)
-	{
-		auto& color = ledColors[i];
-		// correct the color byte order
-		switch (_ledStringColorOrder.at(i))
-		{
-		case ColorOrder::ORDER_RGB:
-			// leave as it is
-			break;
-		case ColorOrder::ORDER_BGR:
-			std::swap(color.red, color.blue);
-			break;
-		case ColorOrder::ORDER_RBG:
-			std::swap(color.green, color.blue);
-			break;
-		case ColorOrder::ORDER_GRB:
-			std::swap(color.red, color.green);
-			break;
-		case ColorOrder::ORDER_GBR:
-			std::swap(color.red, color.green);
-			std::swap(color.green, color.blue);
-			break;
-		case ColorOrder::ORDER_BRG:
-			std::swap(color.red, color.blue);
-			std::swap(color.green, color.blue);
-			break;
-		}
-	}
-}
-
-void Hyperion::writeToLeds()
+void Hyperion::writeToLeds(qint64 captureTime_ns)
 {
 	if (_ledDeviceWrapper->isOn())
 	{
 		// Smoothing is disabled
 		if (!_deviceSmooth->enabled())
 		{
-				emit ledDeviceData(_ledBuffer);
+				emit ledDeviceData(_ledBuffer.current(), captureTime_ns);
 		}
 		else
 		{
 			// device is enabled, feed smoothing in pause mode to maintain a smooth transition back to smooth mode
 			if (!_deviceSmooth->pause())
 			{
-				_deviceSmooth->updateLedValues(_ledBuffer);
+				_deviceSmooth->updateLedValues(_ledBuffer.current(), captureTime_ns);
 			}
 		}
 	}
@@ -778,6 +959,13 @@ void Hyperion::refreshUpdate() const
 }
 
 void Hyperion::update()
+{
+	// Settings, priorities or adjustments may have changed, do not skip the next frame
+	_isFullUpdateRequired.store(true);
+	scheduleUpdate();
+}
+
+void Hyperion::scheduleUpdate()
 {
 	_totalImagesProcessed++;
 	TRACK_SCOPE_SUBCOMPONENT_CATEGORY(instance_update) << "Update output" << (_isUpdatePending.load() ? "will be skipped as another update is pending." : "will be executed.");
@@ -812,50 +1000,114 @@ void Hyperion::handleUpdate()
 	_isUpdatePending.store(false);
 }
 
+void Hyperion::markInputReceived()
+{
+	_inputReceivedTime_ns.store(LatencyMetrics::monotonicTime_ns());
+}
+
 void Hyperion::processUpdate()
 {
-	// Obtain the current priority channel
+	const int64_t inputReceivedTime_ns = _inputReceivedTime_ns.exchange(0);
+
+	// Obtain the current priority channel, the muxer's entry is only valid until the channel is updated
 	const PriorityMuxer::InputInfo& priorityInfo = _muxer->getInputInfo(_muxer->getCurrentPriority());
+	const int priority = priorityInfo.priority;
+	const qint64 captureTime_ns = priorityInfo.captureTime_ns;
 
 	// copy image & process OR copy ledColors from muxer
-	const Image<ColorRgb>& image = priorityInfo.image;
-
-	QVector<ColorRgb> ledColors;
+	const Image<ColorRgb> image = priorityInfo.image;
 
 	if (!image.isNull())
 	{
 		TRACK_SCOPE_SUBCOMPONENT_CATEGORY(instance_update) << "Process update using image with id" << image.id() << "and resolution" << image.width() << "x" << image.height();
 		emit currentImage(image);  // Emit the image signal at the controlled rate
-		ledColors = _imageProcessor->process(image);
+
+		// Identical frames keep the current LED colors, smoothing and device refresh continue independently
+		if (isStaticFrame(priority, image))
+		{
+			TRACK_SCOPE_SUBCOMPONENT_CATEGORY(instance_update) << "Static frame - skip update";
+			_staticFramesSkipped++;
+			_staticFramesSkippedTotal++;
+			return;
+		}
 	}
 	else
 	{
-		ledColors = priorityInfo.ledColors;
-		if (ledColors.empty())
-		{		
+		_lastFramePriority = -1;
+		if (priorityInfo.ledColors.empty())
+		{
 			TRACK_SCOPE_SUBCOMPONENT_CATEGORY(instance_update) << "Empty image and no LED colors provided - skip update";
 			return;
 		}
 	}
 
+	// Fill the buffer not handed out with the previous frame, receivers may still hold that one.
+	// It is only taken for frames being written, so skipped frames leave the buffers untouched.
+	QVector<ColorRgb>& ledColors = _rawLedColors.next();
+
+	if (!image.isNull())
+	{
+		const LatencyTimer timer(_mappingLatency.data());
+		_imageProcessor->process(image, ledColors);
+	}
+	else
+	{
+		const qsizetype copyCount = std::min<qsizetype>(ledColors.size(), priorityInfo.ledColors.size());
+		std::copy_n(priorityInfo.ledColors.cbegin(), copyCount, ledColors.begin());
+		std::fill(ledColors.begin() + copyCount, ledColors.end(), ColorRgb::BLACK);
+	}
+
 	emit rawLedColors(ledColors);
-	applyBlacklist(ledColors);
 
-	// Start transformations
-	_raw2ledAdjustment->applyAdjustment(ledColors);
+	// Copy elements from ledColors to the next device buffer up to its size, LEDs not in the layout stay black.
+	// The raw colors are left untouched, as receivers of rawLedColors share them.
+	QVector<ColorRgb>& ledBuffer = _ledBuffer.next();
+	const qsizetype count = std::min<qsizetype>(ledBuffer.size(), ledColors.size());
+	std::copy_n(ledColors.cbegin(), count, ledBuffer.begin());
+	std::fill(ledBuffer.begin() + count, ledBuffer.end(), ColorRgb::BLACK);
+
+	{
+		const LatencyTimer timer(_adjustmentLatency.data());
+		// Blacklist, color adjustment and color order in a single pass
+		_ledOutput.apply(ledBuffer);
+	}
 
-	applyColorOrder(ledColors);
+	writeToLeds(captureTime_ns);
 
-	// Copy elements from ledColors to _ledBuffer up to the size of _ledBuffer
-	std::copy_n(ledColors.begin(), std::min<qsizetype>(_ledBuffer.size(), ledColors.size()), _ledBuffer.begin());
+	if (inputReceivedTime_ns > 0)
+	{
+		_endToEndLatency->record(std::chrono::steady_clock::now().time_since_epoch() - std::chrono::nanoseconds(inputReceivedTime_ns));
+	}
+}
 
-	writeToLeds();
+bool Hyperion::isStaticFrame(int priority, const Image<ColorRgb>& image)
+{
+	const bool isFullUpdateRequired = _isFullUpdateRequired.exchange(false);
+	const quint64 hash = sampledImageHash(image);
+	const QSize size(image.width(), image.height());
+
+	const bool isStatic = !isFullUpdateRequired
+						  && priority == _lastFramePriority
+						  && size == _lastFrameSize
+						  && hash == _lastFrameHash
+						  && _lastFullUpdateTimer.isValid()
+						  && _lastFullUpdateTimer.elapsed() < STATIC_FRAME_REFRESH_INTERVAL.count();
+
+	if (!isStatic)
+	{
+		_lastFramePriority = priority;
+		_lastFrameSize = size;
+		_lastFrameHash = hash;
+		_lastFullUpdateTimer.start();
+	}
+	return isStatic;
 }
 
 void Hyperion::resetImagesProcessedStatistics()
 {
 	_totalImagesProcessed.store(0);
 	_imagesSkipped.store(0);
+	_staticFramesSkipped.store(0);
 	if (_statisticsTimer)
 	{
 		_statisticsTimer->start();
@@ -866,6 +1118,7 @@ void Hyperion::reportImagesProcessedStatistics()
 {
 	int total = _totalImagesProcessed.exchange(0);
 	int skipped = _imagesSkipped.exchange(0);
+	int staticSkipped = _staticFramesSkipped.exchange(0);
 
 	if (total > 0)
 	{
@@ -881,5 +1134,10 @@ void Hyperion::reportImagesProcessedStatistics()
 			double actual_updates_ps = (total - skipped) / interval_s;
 			Warning(_log, "Skipped %d of %d images (%.2f %%) in the last %d seconds. Actual images processed per second: %.2f", skipped, total, percentage, static_cast<int>(interval_s), actual_updates_ps);
 		}
+
+		if (staticSkipped > 0)
+		{
+			Debug(_log, "Skipped %d static images in the last %d seconds (%llu in total), as they were identical to the previous image", staticSkipped, static_cast<int>(interval_s), static_cast<unsigned long long>(_staticFramesSkippedTotal.load()));
+		}
 	}
 }
@@ -3,10 +3,13 @@
 #include <QSharedPointer>
 #include <QRgb>
 #include <QLoggingCategory>
+#include <QThread>
+#include <QThreadPool>
 
 // Hyperion includes
 #include <hyperion/Hyperion.h>
 #include <hyperion/ImageToLedsMap.h>
+#include <hyperion/ColorHistogram.h>
 
 // Blackborder includes
 #include <blackborder/BlackBorderProcessor.h>
@@ -33,11 +36,28 @@ void ImageProcessor::registerProcessingUnit(
 	qCDebug(imageProcessor_track) << "Size" << width << "x" << height
 								  << "horiz. border:" << horizontalBorder << "vert. border:" << verticalBorder
 								  << "pixel factor:" << _reducedPixelSetFactorFactor << "accuracy level:" << _accuracyLevel
+								  << "threads:" << _processingThreads << "dominant color bits:" << _dominantColorBits
 								  << "#LEDs:" << _ledString.leds().size();
 
 	if (width > 0 && height > 0)
 	{
-		_imageToLedColors = MAKE_TRACKED_SHARED(ImageToLedsMap,
+		const ImageToLedsMapCache::Key key {width, height, horizontalBorder, verticalBorder, _layoutHash, _reducedPixelSetFactorFactor, _accuracyLevel};
+		if (_requestedMapKey.has_value() && _requestedMapKey.value() == key)
+		{
+			return;
+		}
+
+		QSharedPointer<ImageToLedsMap> map = _imageToLedsMapCache.find(key);
+		if (!map.isNull())
+		{
+			_requestedMapKey.reset();
+			activateMap(map);
+		}
+		else if (_imageToLedColors.isNull() || _imageToLedColors->width() == 0 || _imageToLedColors->height() == 0)
+		{
+			// No mapping to continue with, build it right away
+			_requestedMapKey.reset();
+			map = MAKE_TRACKED_SHARED(ImageToLedsMap,
 								_log,
 								width,
 								height,
@@ -46,15 +66,108 @@ void ImageProcessor::registerProcessingUnit(
 								_ledString.leds(),
 								_reducedPixelSetFactorFactor,
 								_accuracyLevel
-		);
+			);
+			_imageToLedsMapCache.insert(key, map);
+			activateMap(map);
+		}
+		else
+		{
+			// Continue with the current mapping until the new one is built in the background
+			_requestedMapKey = key;
+			buildMapInBackground(key);
+		}
 	}
 	else
 	{
 		qCDebug(imageProcessor_track) << "Invalid size, resetting ImageToLedsMap.";
+		_requestedMapKey.reset();
 		_imageToLedColors = MAKE_TRACKED_SHARED(ImageToLedsMap, _log, 0, 0, 0, 0, _ledString.leds());
 	}
 }
 
+void ImageProcessor::updateProcessingUnit()
+{
+	// Keep the size and borders of the pending or current mapping
+	if (_requestedMapKey.has_value())
+	{
+		const ImageToLedsMapCache::Key key = _requestedMapKey.value();
+		registerProcessingUnit(key.width, key.height, key.horizontalBorder, key.verticalBorder);
+	}
+	else if (!_imageToLedColors.isNull())
+	{
+		registerProcessingUnit(_imageToLedColors->width(), _imageToLedColors->height(),
+							   _imageToLedColors->horizontalBorder(), _imageToLedColors->verticalBorder());
+	}
+}
+
+void ImageProcessor::activateMap(const QSharedPointer<hyperion::ImageToLedsMap>& map)
+{
+	map->setThreadCount(_processingThreads);
+	map->setDominantColorBits(_dominantColorBits);
+	_imageToLedColors = map;
+}
+
+void ImageProcessor::buildMapInBackground(const hyperion::ImageToLedsMapCache::Key& key)
+{
+	if (_mapKeysInBuild.contains(key))
+	{
+		return;
+	}
+	_mapKeysInBuild.append(key);
+
+	qCDebug(imageProcessor_track) << "Build mapping for" << key.width << "x" << key.height
+								  << "horiz. border:" << key.horizontalBorder << "vert. border:" << key.verticalBorder << "in background";
+
+	QThread* const targetThread = thread();
+	QThreadPool::globalInstance()->start([receiver = _mapBuildReceiver, processor = this, targetThread, key, log = _log, leds = _ledString.leds()]() {
+		QSharedPointer<ImageToLedsMap> map = MAKE_TRACKED_SHARED(ImageToLedsMap,
+								log,
+								key.width,
+								key.height,
+								key.horizontalBorder,
+								key.verticalBorder,
+								leds,
+								key.reducedPixelSetFactor,
+								key.accuracyLevel
+		);
+		map->moveToThread(targetThread);
+
+		// The call is only made while the processor exists
+		receiver->invoke([processor, key, map]() {
+			processor->handleMapBuilt(key, map);
+		});
+	});
+}
+
+void ImageProcessor::handleMapBuilt(const hyperion::ImageToLedsMapCache::Key& key, const QSharedPointer<hyperion::ImageToLedsMap>& map)
+{
+	_mapKeysInBuild.removeAll(key);
+
+	// Keep results for an outdated layout or pixel set factor out of the cache
+	if (key.layoutHash != _layoutHash || key.reducedPixelSetFactor != _reducedPixelSetFactorFactor || key.accuracyLevel != _accuracyLevel)
+	{
+		qCDebug(imageProcessor_track) << "Discard outdated mapping built in background";
+
+		// Request the mapping again, now for the current layout, pixel set factor and accuracy level
+		if (_requestedMapKey.has_value() && _requestedMapKey.value() == key)
+		{
+			_requestedMapKey.reset();
+			registerProcessingUnit(key.width, key.height, key.horizontalBorder, key.verticalBorder);
+		}
+		return;
+	}
+	_imageToLedsMapCache.insert(key, map);
+
+	// Swap in the mapping, if it is still the requested one. Processing runs on this thread, i.e. never with a partly updated mapping.
+	if (_requestedMapKey.has_value() && _requestedMapKey.value() == key)
+	{
+		qCDebug(imageProcessor_track) << "Swap in mapping for" << key.width << "x" << key.height
+									  << "horiz. border:" << key.horizontalBorder << "vert. border:" << key.verticalBorder;
+		_requestedMapKey.reset();
+		activateMap(map);
+	}
+}
+
 // global transform method
 int ImageProcessor::mappingTypeToInt(const QString& mappingType)
 {
@@ -86,6 +199,10 @@ int ImageProcessor::mappingTypeToInt(const QString& mappingType)
 	{
 		return 6;
 	}
+	else if (mappingType == "multicolor_mean_integral" )
+	{
+		return 7;
+	}
 	return 0;
 }
 // global transform method
@@ -115,6 +232,9 @@ QString ImageProcessor::mappingTypeToStr(int mappingType)
 	case 6:
 		typeText = "unicolor_dominant_advanced";
 		break;
+	case 7:
+		typeText = "multicolor_mean_integral";
+		break;
 	default:
 		typeText = "multicolor_mean";
 		break;
@@ -127,13 +247,18 @@ ImageProcessor::ImageProcessor(const LedString& ledString, const QSharedPointer<
 	: QObject()
 	, _log(nullptr)
 	, _ledString(ledString)
+	, _layoutHash(ImageToLedsMapCache::layoutHash(ledString.leds()))
 	, _borderProcessor(nullptr)
 	, _imageToLedColors(nullptr)
+	, _imageToLedsMapCache()
+	, _mapBuildReceiver(new QueuedReceiver(this))
 	, _mappingType(0)
 	, _userMappingType(0)
 	, _hardMappingType(-1)
 	, _accuracyLevel(0)
 	, _reducedPixelSetFactorFactor(1)
+	, _processingThreads(1)
+	, _dominantColorBits(hyperion::ColorHistogram::DEFAULT_BITS_PER_CHANNEL)
 	, _hyperionWeak(hyperionInstance)
 {
 	QString subComponent{ "__" };
@@ -157,6 +282,9 @@ ImageProcessor::ImageProcessor(const LedString& ledString, const QSharedPointer<
 ImageProcessor::~ImageProcessor()
 {
 	TRACK_SCOPE_SUBCOMPONENT();
+
+	// mappings may still be built in the background
+	_mapBuildReceiver->close();
 }
 
 void ImageProcessor::handleSettingsUpdate(settings::type type, const QJsonDocument& config)
@@ -176,6 +304,12 @@ void ImageProcessor::handleSettingsUpdate(settings::type type, const QJsonDocume
 
 		int accuracyLevel = obj["accuracyLevel"].toInt();
 		setAccuracyLevel(accuracyLevel);
+
+		int processingThreads = obj["processingThreads"].toInt(1);
+		setProcessingThreads(processingThreads);
+
+		int dominantColorBits = obj["dominantColorBits"].toInt(hyperion::ColorHistogram::DEFAULT_BITS_PER_CHANNEL);
+		setDominantColorBits(dominantColorBits);
 	}
 }
 
@@ -183,6 +317,17 @@ void ImageProcessor::setSize(int width, int height)
 {
 	// Check if the existing buffer-image is already the correct dimensions
 	if (!_imageToLedColors.isNull() && _imageToLedColors->width() == width && _imageToLedColors->height() == height)
+	{
+		// Back at the current size, a mapping for another size built in the background is not swapped in anymore
+		if (_requestedMapKey.has_value() && (_requestedMapKey->width != width || _requestedMapKey->height != height))
+		{
+			_requestedMapKey.reset();
+		}
+		return;
+	}
+
+	// ... or a mapping with the correct dimensions is already built in the background
+	if (_requestedMapKey.has_value() && _requestedMapKey->width == width && _requestedMapKey->height == height)
 	{
 		return;
 	}
@@ -203,13 +348,10 @@ void ImageProcessor::setLedString(const LedString& ledString)
 	{
 		qCDebug(imageProcessor_track) << "Update LED-String in image processing unit.";
 		_ledString = ledString;
-
-		// get current width/height
-		int width = _imageToLedColors->width();
-		int height = _imageToLedColors->height();
+		_layoutHash = ImageToLedsMapCache::layoutHash(_ledString.leds());
 
 		// Construct a new buffer and mapping
-		registerProcessingUnit(width, height, 0, 0);
+		updateProcessingUnit();
 	}
 }
 
@@ -236,23 +378,47 @@ void ImageProcessor::setReducedPixelSetFactorFactor(int count)
 	if (currentReducedPixelSetFactor != _reducedPixelSetFactorFactor && !_imageToLedColors.isNull())
 	{
 		qCDebug(imageProcessor_track) << "Set reduced pixel set factor to" << count << "- update image processing unit";
-		int width = _imageToLedColors->width();
-		int height = _imageToLedColors->height();
 
 		// Construct a new buffer and mapping
-		registerProcessingUnit(width, height, 0, 0);
+		updateProcessingUnit();
 	}
 }
 
 void ImageProcessor::setAccuracyLevel(int level)
 {
 	qCDebug(imageProcessor_track) << "Set accuracy level to" << level;
+	const bool isChanged = (level != _accuracyLevel);
 	_accuracyLevel = level;
 	Debug(_log, "Set processing accuracy level to %d", _accuracyLevel);
 
+	if (isChanged && !_imageToLedColors.isNull())
+	{
+		// The accuracy level is part of the mapping, i.e. request one built for the new level
+		updateProcessingUnit();
+	}
+}
+
+void ImageProcessor::setProcessingThreads(int threadCount)
+{
+	qCDebug(imageProcessor_track) << "Set processing threads to" << threadCount;
+	_processingThreads = qMax(1, threadCount);
+	Debug(_log, "Set processing threads to %d", _processingThreads);
+
+	if (!_imageToLedColors.isNull())
+	{
+		_imageToLedColors->setThreadCount(_processingThreads);
+	}
+}
+
+void ImageProcessor::setDominantColorBits(int bitsPerChannel)
+{
+	qCDebug(imageProcessor_track) << "Set dominant color bits to" << bitsPerChannel;
+	_dominantColorBits = qBound(hyperion::ColorHistogram::MIN_BITS_PER_CHANNEL, bitsPerChannel, hyperion::ColorHistogram::MAX_BITS_PER_CHANNEL);
+	Debug(_log, "Set dominant color histogram bits per channel to %d", _dominantColorBits);
+
 	if (!_imageToLedColors.isNull())
 	{
-		_imageToLedColors->setAccuracyLevel(_accuracyLevel);
+		_imageToLedColors->setDominantColorBits(_dominantColorBits);
 	}
 }
 
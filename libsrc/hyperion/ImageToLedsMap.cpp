@@ -1,10 +1,25 @@
 #include <hyperion/ImageToLedsMap.h>
 
+#include <QThread>
+#include <QThreadPool>
+#include <QSemaphore>
+
+#include <utility>
+
 Q_LOGGING_CATEGORY(imageToLedsMap_track, "hyperion.imageToLedsMap.track");
 Q_LOGGING_CATEGORY(imageToLedsMap_calc, "hyperion.imageToLedsMap.calc");
 
 using namespace hyperion;
 
+namespace {
+	// Chunk boundaries are multiples of 64 LEDs (192 bytes of output, i.e. three cache lines),
+	// so that chunks processed in parallel do not write to the same cache lines
+	constexpr int LEDS_PER_CHUNK_ALIGNMENT = 64;
+
+	// Centroid of the unused k-means lanes, farther away from any color than all used centroids
+	constexpr int32_t UNUSED_CENTROID = 1024;
+}
+
 ImageToLedsMap::ImageToLedsMap(
 		QSharedPointer<Logger> log,
 		int width,
@@ -21,7 +36,16 @@ ImageToLedsMap::ImageToLedsMap(
 	, _verticalBorder(verticalBorder)
 	, _nextPixelCount(reducedPixelSetFactor)
 	, _clusterCount()
-	, _colorsMap()
+	, _clusterCentroids()
+	, _kMeansTimeBudget(0)
+	, _dominantColorBits(ColorHistogram::DEFAULT_BITS_PER_CHANNEL)
+	, _kernels(&kernels::accumulateKernels())
+	, _ledAreas()
+	, _spans()
+	, _imageArea()
+	, _ledRects()
+	, _integralImage()
+	, _chunkBounds()
 {
 	TRACK_SCOPE();
 
@@ -34,7 +58,8 @@ ImageToLedsMap::ImageToLedsMap(
 	Q_ASSERT(_height < 10000);
 
 	// Reserve enough space in the map for the leds
-	_colorsMap.reserve(leds.size());
+	_ledAreas.reserve(leds.size());
+	_ledRects.reserve(leds.size());
 
 	const int xOffset      = _verticalBorder;
 	const int actualWidth  = _width  - 2 * _verticalBorder;
@@ -50,7 +75,9 @@ ImageToLedsMap::ImageToLedsMap(
 		// skip leds without area
 		if ((led.maxX_frac-led.minX_frac) < 1e-6 || (led.maxY_frac-led.minY_frac) < 1e-6)
 		{
-			_colorsMap.append(QVector<int>());
+			const auto spanIdx = static_cast<int32_t>(_spans.size());
+			_ledAreas.append(LedArea{spanIdx, spanIdx, 1, 0});
+			_ledRects.append(LedRect{0, 0, 0, 0});
 			continue;
 		}
 
@@ -72,7 +99,7 @@ ImageToLedsMap::ImageToLedsMap(
 			maxY_idx++;
 		}
 
-		// Add all the indices in the above defined rectangle to the indices for this led
+		// Add all the rows of the above defined rectangle as spans for this led
 		const int maxYLedCount = qMin(maxY_idx, yOffset+actualHeight);
 		const int maxXLedCount = qMin(maxX_idx, xOffset+actualWidth);
 
@@ -87,33 +114,51 @@ ImageToLedsMap::ImageToLedsMap(
 			ledsWithForcedSkippedPixels.append(ledCounter);
 		}
 
-		QVector<int> ledColors;
-		ledColors.reserve(totalSize);
-		for (int y = minY_idx; y < maxYLedCount; y += _nextPixelCount)
+		LedArea area {static_cast<int32_t>(_spans.size()), 0, _nextPixelCount, 0};
+		if (minX_idx < maxXLedCount)
 		{
-			for (int x = minX_idx; x < maxXLedCount; x += _nextPixelCount)
+			const int pixelsPerRow = (maxXLedCount - minX_idx + _nextPixelCount - 1) / _nextPixelCount;
+			for (int y = minY_idx; y < maxYLedCount; y += _nextPixelCount)
 			{
-				ledColors.append( y * actualWidth + x);
+				_spans.append(PixelSpan{y, minX_idx, maxXLedCount});
+				area.pixelCount += pixelsPerRow;
 			}
 		}
+		area.spanEnd = static_cast<int32_t>(_spans.size());
 
-		_colorsMap.append(ledColors);
-		qCDebug(imageToLedsMap_track) << "-> LED/light [" << ledCounter << "] pixels:" << totalSize << ", Skipping every" << _nextPixelCount << "pixels =>" << _colorsMap.last().size() << "pixels mapped";	
+		_ledAreas.append(area);
+		if (minX_idx < maxXLedCount && minY_idx < maxYLedCount)
+		{
+			_ledRects.append(LedRect{minX_idx, minY_idx, maxXLedCount, maxYLedCount});
+		}
+		else
+		{
+			_ledRects.append(LedRect{0, 0, 0, 0});
+		}
+		qCDebug(imageToLedsMap_track) << "-> LED/light [" << ledCounter << "] pixels:" << totalSize << ", Skipping every" << _nextPixelCount << "pixels =>" << area.pixelCount << "pixels mapped";
 
-		totalCount += ledColors.size();
+		totalCount += area.pixelCount;
 
 		ledCounter++;
 	}
 
+	// The complete image is a single contiguous span, as rows are stored without padding
+	const auto imageSpanIdx = static_cast<int32_t>(_spans.size());
+	_spans.append(PixelSpan{0, 0, qMax(_width, 0) * qMax(_height, 0)});
+	_imageArea = LedArea{imageSpanIdx, imageSpanIdx + 1, 1, _spans.last().xEnd};
+
+	setThreadCount(1);
+	resetClusterCentroids();
+
 	WarningIf(!ledsWithForcedSkippedPixels.isEmpty(), _log,
 			  "[%d] LED mapping area(s) have a huge number of pixels to be processed. "
 			  "Every %d pixels will be skipped to improve performance. Enable reduced processing to hide this warning.",
 			  ledsWithForcedSkippedPixels.size(), _nextPixelCount);
 
-	qCDebug(imageToLedsMap_track) << "LED areas:" << leds.size() << ", #indicies:" << totalCount
+	qCDebug(imageToLedsMap_track) << "LED areas:" << leds.size() << ", #indicies:" << totalCount << ", #spans:" << _spans.size()
 					 			 << ", H-border:" << horizontalBorder << ", V-border:" << verticalBorder
 								  << ", Reduced pixel factor:" << reducedPixelSetFactor << ", Accuracy:" << accuracyLevel
-								  << ", Image size:" << width << "x" << height;
+								  << ", Image size:" << width << "x" << height << ", Kernels:" << _kernels->name;
 }
 
 ImageToLedsMap::~ImageToLedsMap()
@@ -141,5 +186,108 @@ void ImageToLedsMap::setAccuracyLevel (int accuracyLevel)
 	//Set cluster number for dominant color advanced
 	_clusterCount  = accuracyLevel + 1;
 
+	resetClusterCentroids();
 }
 
+void ImageToLedsMap::resetClusterCentroids()
+{
+	ClusterCentroids initialCentroids;
+	initialCentroids.red.fill(UNUSED_CENTROID);
+	initialCentroids.green.fill(UNUSED_CENTROID);
+	initialCentroids.blue.fill(UNUSED_CENTROID);
+	for (int k = 0; k < _clusterCount; ++k)
+	{
+		initialCentroids.red[k] = DEFAULT_CLUSTER_COLORS[k].red;
+		initialCentroids.green[k] = DEFAULT_CLUSTER_COLORS[k].green;
+		initialCentroids.blue[k] = DEFAULT_CLUSTER_COLORS[k].blue;
+	}
+
+	// One entry per LED area plus one for the whole image
+	_clusterCentroids.fill(initialCentroids, _ledAreas.size() + 1);
+}
+
+void ImageToLedsMap::setDominantColorBits(int bitsPerChannel)
+{
+	_dominantColorBits = qBound(ColorHistogram::MIN_BITS_PER_CHANNEL, bitsPerChannel, ColorHistogram::MAX_BITS_PER_CHANNEL);
+	qCDebug(imageToLedsMap_track) << "Dominant color histogram bits per channel:" << _dominantColorBits;
+}
+
+
+void ImageToLedsMap::setThreadCount(int threadCount)
+{
+	const int ledCount = static_cast<int>(_ledAreas.size());
+	const int maxChunks = qMax(1, (ledCount + LEDS_PER_CHUNK_ALIGNMENT - 1) / LEDS_PER_CHUNK_ALIGNMENT);
+	const int chunkCount = qBound(1, threadCount, maxChunks);
+
+	// Balance the chunks by the number of pixels to be evaluated (plus a fixed cost per LED)
+	qint64 totalCost = 0;
+	for (const LedArea &area : std::as_const(_ledAreas))
+	{
+		totalCost += area.pixelCount + 1;
+	}
+
+	_chunkBounds.clear();
+	_chunkBounds.append(0);
+
+	qint64 cost = 0;
+	int led = 0;
+	for (int chunk = 1; chunk < chunkCount; ++chunk)
+	{
+		const qint64 targetCost = totalCost * chunk / chunkCount;
+		while (led < ledCount && cost < targetCost)
+		{
+			cost += _ledAreas[led].pixelCount + 1;
+			++led;
+		}
+
+		// Round to the chunk alignment and skip empty chunks
+		int bound = ((led + LEDS_PER_CHUNK_ALIGNMENT / 2) / LEDS_PER_CHUNK_ALIGNMENT) * LEDS_PER_CHUNK_ALIGNMENT;
+		bound = qMin(bound, ledCount);
+		if (bound > _chunkBounds.last() && bound < ledCount)
+		{
+			_chunkBounds.append(bound);
+		}
+	}
+	_chunkBounds.append(ledCount);
+
+	qCDebug(imageToLedsMap_track) << "Threads requested:" << threadCount << ", LED chunks:" << _chunkBounds;
+}
+
+QThreadPool& ImageToLedsMap::workerPool()
+{
+	// The calling instance thread processes one chunk itself
+	static QThreadPool pool;
+	static const bool isInitialised = [] {
+		pool.setObjectName("ImageToLedsMapPool");
+		pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+		return true;
+	}();
+	Q_UNUSED(isInitialised);
+
+	return pool;
+}
+
+void ImageToLedsMap::runChunks(const std::function<void(int ledBegin, int ledEnd)> &evaluate) const
+{
+	const int chunkCount = static_cast<int>(_chunkBounds.size()) - 1;
+	if (chunkCount <= 1)
+	{
+		evaluate(0, static_cast<int>(_ledAreas.size()));
+		return;
+	}
+
+	QSemaphore chunksDone;
+	QThreadPool &pool = workerPool();
+	for (int chunk = 1; chunk < chunkCount; ++chunk)
+	{
+		const int ledBegin = _chunkBounds[chunk];
+		const int ledEnd = _chunkBounds[chunk + 1];
+		pool.start([&evaluate, &chunksDone, ledBegin, ledEnd]() {
+			evaluate(ledBegin, ledEnd);
+			chunksDone.release();
+		});
+	}
+
+	evaluate(_chunkBounds[0], _chunkBounds[1]);
+	chunksDone.acquire(chunkCount - 1);
+}
@@ -0,0 +1,93 @@
+#include <hyperion/ImageToLedsMapCache.h>
+#include <hyperion/ImageToLedsMap.h>
+
+#include <QHash>
+
+using namespace hyperion;
+
+namespace {
+
+inline void hashCombine(size_t& seed, size_t value)
+{
+	seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+} // namespace
+
+ImageToLedsMapCache::ImageToLedsMapCache(int capacity)
+	: _entries()
+	, _capacity(qMax(1, capacity))
+	, _hits(0)
+	, _misses(0)
+{
+}
+
+QSharedPointer<ImageToLedsMap> ImageToLedsMapCache::get(const Key& key, const std::function<QSharedPointer<ImageToLedsMap>()>& create)
+{
+	QSharedPointer<ImageToLedsMap> map = find(key);
+	if (map.isNull())
+	{
+		map = create();
+		insert(key, map);
+	}
+	return map;
+}
+
+QSharedPointer<ImageToLedsMap> ImageToLedsMapCache::find(const Key& key)
+{
+	for (int idx = 0; idx < _entries.size(); ++idx)
+	{
+		if (_entries[idx].first == key)
+		{
+			++_hits;
+			qCDebug(imageToLedsMap_track) << "Cache hit for" << key.width << "x" << key.height
+										  << ", H-border:" << key.horizontalBorder << ", V-border:" << key.verticalBorder
+										  << ", hits:" << _hits << ", misses:" << _misses;
+			_entries.move(idx, 0);
+			return _entries.first().second;
+		}
+	}
+
+	++_misses;
+	qCDebug(imageToLedsMap_track) << "Cache miss for" << key.width << "x" << key.height
+								  << ", H-border:" << key.horizontalBorder << ", V-border:" << key.verticalBorder
+								  << ", hits:" << _hits << ", misses:" << _misses;
+	return {};
+}
+
+void ImageToLedsMapCache::insert(const Key& key, const QSharedPointer<ImageToLedsMap>& map)
+{
+	for (int idx = 0; idx < _entries.size(); ++idx)
+	{
+		if (_entries[idx].first == key)
+		{
+			_entries.removeAt(idx);
+			break;
+		}
+	}
+
+	_entries.prepend(qMakePair(key, map));
+	while (_entries.size() > _capacity)
+	{
+		_entries.removeLast();
+	}
+}
+
+void ImageToLedsMapCache::clear()
+{
+	qCDebug(imageToLedsMap_track) << "Clear cache of" << _entries.size() << "mapping(s)";
+	_entries.clear();
+}
+
+size_t ImageToLedsMapCache::layoutHash(const QVector<Led>& leds)
+{
+	size_t seed = static_cast<size_t>(leds.size());
+	for (const Led& led : leds)
+	{
+		hashCombine(seed, qHash(led.minX_frac));
+		hashCombine(seed, qHash(led.maxX_frac));
+		hashCombine(seed, qHash(led.minY_frac));
+		hashCombine(seed, qHash(led.maxY_frac));
+	}
+	return seed;
+}
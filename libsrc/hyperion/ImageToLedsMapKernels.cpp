@@ -0,0 +1,444 @@
+#include <hyperion/ImageToLedsMapKernels.h>
+
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__))
+#define KERNELS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace hyperion;
+using namespace hyperion::kernels;
+
+namespace {
+
+///
+/// Adds per byte lane totals of packed RGB data to the channel sums.
+/// Lane j holds the total of byte position j (modulo 48) of the pixel data, i.e. of channel j % 3.
+///
+template <typename Lane_T>
+inline void addLanes(const Lane_T* lanes, ChannelSums& sums)
+{
+	for (int idx = 0; idx < 48; idx += 3)
+	{
+		sums.red += lanes[idx];
+		sums.green += lanes[idx + 1];
+		sums.blue += lanes[idx + 2];
+	}
+}
+
+inline void sumScalar(const ColorRgb* pixel, int count, ChannelSums& sums)
+{
+	uint64_t red = 0;
+	uint64_t green = 0;
+	uint64_t blue = 0;
+	for (const ColorRgb* end = pixel + count; pixel != end; ++pixel)
+	{
+		red += pixel->red;
+		green += pixel->green;
+		blue += pixel->blue;
+	}
+	sums.red += red;
+	sums.green += green;
+	sums.blue += blue;
+}
+
+inline void sumSquaredScalar(const ColorRgb* pixel, int count, ChannelSums& sums)
+{
+	uint64_t red = 0;
+	uint64_t green = 0;
+	uint64_t blue = 0;
+	for (const ColorRgb* end = pixel + count; pixel != end; ++pixel)
+	{
+		red += static_cast<uint32_t>(pixel->red * pixel->red);
+		green += static_cast<uint32_t>(pixel->green * pixel->green);
+		blue += static_cast<uint32_t>(pixel->blue * pixel->blue);
+	}
+	sums.red += red;
+	sums.green += green;
+	sums.blue += blue;
+}
+
+void sumSpansScalar(const ColorRgb* image, int width, const PixelSpan* spans, int spanCount, ChannelSums& sums)
+{
+	for (const PixelSpan* span = spans; span != spans + spanCount; ++span)
+	{
+		sumScalar(image + static_cast<ptrdiff_t>(span->row) * width + span->xBegin, span->xEnd - span->xBegin, sums);
+	}
+}
+
+void sumSquaredSpansScalar(const ColorRgb* image, int width, const PixelSpan* spans, int spanCount, ChannelSums& sums)
+{
+	for (const PixelSpan* span = spans; span != spans + spanCount; ++span)
+	{
+		sumSquaredScalar(image + static_cast<ptrdiff_t>(span->row) * width + span->xBegin, span->xEnd - span->xBegin, sums);
+	}
+}
+
+// Vectorised kernels process blocks of 16 pixels (48 bytes), the remainder of a span is added by the scalar code.
+// Partial sums are kept in narrow lanes and flushed into the 64bit channel sums before they could overflow.
+// Narrow spans (i.e. small LED areas) do not fill a block and are therefore handled without any vector overhead.
+constexpr int BLOCK_PIXELS = 16;
+// 16bit lanes adding at most 255 per block
+constexpr int MAX_BLOCKS_SUM = 256;
+// 32bit lanes adding at most 255^2 per block
+constexpr int MAX_BLOCKS_SQUARED = 32768;
+
+#ifdef KERNELS_X86
+
+void sumSpansSse2(const ColorRgb* image, int width, const PixelSpan* spans, int spanCount, ChannelSums& sums)
+{
+	const __m128i zero = _mm_setzero_si128();
+	__m128i acc[6] = {zero, zero, zero, zero, zero, zero};
+	int blocks = 0;
+
+	auto flush = [&]() {
+		alignas(16) uint16_t lanes[48];
+		for (int v = 0; v < 6; ++v)
+		{
+			_mm_store_si128(reinterpret_cast<__m128i*>(lanes + 8 * v), acc[v]);
+			acc[v] = zero;
+		}
+		addLanes(lanes, sums);
+		blocks = 0;
+	};
+
+	for (const PixelSpan* span = spans; span != spans + spanCount; ++span)
+	{
+		const ColorRgb* pixel = image + static_cast<ptrdiff_t>(span->row) * width + span->xBegin;
+		int count = span->xEnd - span->xBegin;
+		for (; count >= BLOCK_PIXELS; count -= BLOCK_PIXELS, pixel += BLOCK_PIXELS)
+		{
+			const auto* bytes = reinterpret_cast<const __m128i*>(pixel);
+			for (int v = 0; v < 3; ++v)
+			{
+				const __m128i data = _mm_loadu_si128(bytes + v);
+				acc[2 * v] = _mm_add_epi16(acc[2 * v], _mm_unpacklo_epi8(data, zero));
+				acc[2 * v + 1] = _mm_add_epi16(acc[2 * v + 1], _mm_unpackhi_epi8(data, zero));
+			}
+			if (++blocks == MAX_BLOCKS_SUM)
+			{
+				flush();
+			}
+		}
+		sumScalar(pixel, count, sums);
+	}
+	if (blocks > 0)
+	{
+		flush();
+	}
+}
+
+void sumSquaredSpansSse2(const ColorRgb* image, int width, const PixelSpan* spans, int spanCount, ChannelSums& sums)
+{
+	const __m128i zero = _mm_setzero_si128();
+	__m128i acc[12];
+	std::fill(std::begin(acc), std::end(acc), zero);
+	int blocks = 0;
+
+	auto flush = [&]() {
+		alignas(16) uint32_t lanes[48];
+		for (int v = 0; v < 12; ++v)
+		{
+			_mm_store_si128(reinterpret_cast<__m128i*>(lanes + 4 * v), acc[v]);
+			acc[v] = zero;
+		}
+		addLanes(lanes, sums);
+		blocks = 0;
+	};
+
+	for (const PixelSpan* span = spans; span != spans + spanCount; ++span)
+	{
+		const ColorRgb* pixel = image + static_cast<ptrdiff_t>(span->row) * width + span->xBegin;
+		int count = span->xEnd - span->xBegin;
+		for (; count >= BLOCK_PIXELS; count -= BLOCK_PIXELS, pixel += BLOCK_PIXELS)
+		{
+			const auto* bytes = reinterpret_cast<const __m128i*>(pixel);
+			for (int v = 0; v < 3; ++v)
+			{
+				const __m128i data = _mm_loadu_si128(bytes + v);
+				const __m128i lo = _mm_unpacklo_epi8(data, zero);
+				const __m128i hi = _mm_unpackhi_epi8(data, zero);
+				// Squares of 8bit values fit into unsigned 16bit lanes
+				const __m128i loSquared = _mm_mullo_epi16(lo, lo);
+				const __m128i hiSquared = _mm_mullo_epi16(hi, hi);
+				acc[4 * v] = _mm_add_epi32(acc[4 * v], _mm_unpacklo_epi16(loSquared, zero));
+				acc[4 * v + 1] = _mm_add_epi32(acc[4 * v + 1], _mm_unpackhi_epi16(loSquared, zero));
+				acc[4 * v + 2] = _mm_add_epi32(acc[4 * v + 2], _mm_unpacklo_epi16(hiSquared, zero));
+				acc[4 * v + 3] = _mm_add_epi32(acc[4 * v + 3], _mm_unpackhi_epi16(hiSquared, zero));
+			}
+			if (++blocks == MAX_BLOCKS_SQUARED)
+			{
+				flush();
+			}
+		}
+		sumSquaredScalar(pixel, count, sums);
+	}
+	if (blocks > 0)
+	{
+		flush();
+	}
+}
+
+// Lambdas do not inherit the target attribute, the AVX2 kernels therefore flush via dedicated functions
+TARGET_AVX2 void flushAvx2(__m256i (&acc)[3], ChannelSums& sums)
+{
+	alignas(32) uint16_t lanes[48];
+	for (int v = 0; v < 3; ++v)
+	{
+		_mm256_store_si256(reinterpret_cast<__m256i*>(lanes + 16 * v), acc[v]);
+		acc[v] = _mm256_setzero_si256();
+	}
+	addLanes(lanes, sums);
+}
+
+TARGET_AVX2 void flushAvx2(__m256i (&acc)[6], ChannelSums& sums)
+{
+	alignas(32) uint32_t lanes[48];
+	for (int v = 0; v < 6; ++v)
+	{
+		_mm256_store_si256(reinterpret_cast<__m256i*>(lanes + 8 * v), acc[v]);
+		acc[v] = _mm256_setzero_si256();
+	}
+	addLanes(lanes, sums);
+}
+
+TARGET_AVX2 void sumSpansAvx2(const ColorRgb* image, int width, const PixelSpan* spans, int spanCount, ChannelSums& sums)
+{
+	__m256i acc[3] = {_mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256()};
+	int blocks = 0;
+
+	for (const PixelSpan* span = spans; span != spans + spanCount; ++span)
+	{
+		const ColorRgb* pixel = image + static_cast<ptrdiff_t>(span->row) * width + span->xBegin;
+		int count = span->xEnd - span->xBegin;
+		for (; count >= BLOCK_PIXELS; count -= BLOCK_PIXELS, pixel += BLOCK_PIXELS)
+		{
+			const auto* bytes = reinterpret_cast<const __m128i*>(pixel);
+			for (int v = 0; v < 3; ++v)
+			{
+				acc[v] = _mm256_add_epi16(acc[v], _mm256_cvtepu8_epi16(_mm_loadu_si128(bytes + v)));
+			}
+			if (++blocks == MAX_BLOCKS_SUM)
+			{
+				flushAvx2(acc, sums);
+				blocks = 0;
+			}
+		}
+		sumScalar(pixel, count, sums);
+	}
+	if (blocks > 0)
+	{
+		flushAvx2(acc, sums);
+	}
+}
+
+TARGET_AVX2 void sumSquaredSpansAvx2(const ColorRgb* image, int width, const PixelSpan* spans, int spanCount, ChannelSums& sums)
+{
+	__m256i acc[6];
+	for (__m256i& lane : acc)
+	{
+		lane = _mm256_setzero_si256();
+	}
+	int blocks = 0;
+
+	for (const PixelSpan* span = spans; span != spans + spanCount; ++span)
+	{
+		const ColorRgb* pixel = image + static_cast<ptrdiff_t>(span->row) * width + span->xBegin;
+		int count = span->xEnd - span->xBegin;
+		for (; count >= BLOCK_PIXELS; count -= BLOCK_PIXELS, pixel += BLOCK_PIXELS)
+		{
+			const auto* bytes = reinterpret_cast<const __m128i*>(pixel);
+			for (int v = 0; v < 3; ++v)
+			{
+				const __m256i data = _mm256_cvtepu8_epi16(_mm_loadu_si128(bytes + v));
+				const __m256i squared = _mm256_mullo_epi16(data, data);
+				acc[2 * v] = _mm256_add_epi32(acc[2 * v], _mm256_cvtepu16_epi32(_mm256_castsi256_si128(squared)));
+				acc[2 * v + 1] = _mm256_add_epi32(acc[2 * v + 1], _mm256_cvtepu16_epi32(_mm256_extracti128_si256(squared, 1)));
+			}
+			if (++blocks == MAX_BLOCKS_SQUARED)
+			{
+				flushAvx2(acc, sums);
+				blocks = 0;
+			}
+		}
+		sumSquaredScalar(pixel, count, sums);
+	}
+	if (blocks > 0)
+	{
+		flushAvx2(acc, sums);
+	}
+}
+
+bool cpuSupportsAvx2()
+{
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+	{
+		return false;
+	}
+	__cpuid(info, 1);
+	const bool hasOsXSave = (info[2] & (1 << 27)) != 0;
+	const bool hasAvx = (info[2] & (1 << 28)) != 0;
+	if (!hasOsXSave || !hasAvx || (_xgetbv(0) & 0x6) != 0x6)
+	{
+		return false;
+	}
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif // KERNELS_X86
+
+#ifdef KERNELS_NEON
+
+// vld3q_u8 de-interleaves the channels, the narrow lanes therefore hold a single channel each.
+inline uint64_t horizontalSum(uint32x4_t lanes)
+{
+	uint32_t values[4];
+	vst1q_u32(values, lanes);
+	return static_cast<uint64_t>(values[0]) + values[1] + values[2] + values[3];
+}
+
+// 16bit lanes adding at most 2*255 per block
+constexpr int MAX_BLOCKS_SUM_NEON = 128;
+// 32bit lanes adding at most 4*255^2 per block
+constexpr int MAX_BLOCKS_SQUARED_NEON = 8192;
+
+void sumSpansNeon(const ColorRgb* image, int width, const PixelSpan* spans, int spanCount, ChannelSums& sums)
+{
+	uint16x8_t acc[3] = {vdupq_n_u16(0), vdupq_n_u16(0), vdupq_n_u16(0)};
+	int blocks = 0;
+
+	auto flush = [&]() {
+		sums.red += horizontalSum(vpaddlq_u16(acc[0]));
+		sums.green += horizontalSum(vpaddlq_u16(acc[1]));
+		sums.blue += horizontalSum(vpaddlq_u16(acc[2]));
+		for (uint16x8_t& lane : acc)
+		{
+			lane = vdupq_n_u16(0);
+		}
+		blocks = 0;
+	};
+
+	for (const PixelSpan* span = spans; span != spans + spanCount; ++span)
+	{
+		const ColorRgb* pixel = image + static_cast<ptrdiff_t>(span->row) * width + span->xBegin;
+		int count = span->xEnd - span->xBegin;
+		for (; count >= BLOCK_PIXELS; count -= BLOCK_PIXELS, pixel += BLOCK_PIXELS)
+		{
+			const uint8x16x3_t data = vld3q_u8(reinterpret_cast<const uint8_t*>(pixel));
+			for (int c = 0; c < 3; ++c)
+			{
+				acc[c] = vpadalq_u8(acc[c], data.val[c]);
+			}
+			if (++blocks == MAX_BLOCKS_SUM_NEON)
+			{
+				flush();
+			}
+		}
+		sumScalar(pixel, count, sums);
+	}
+	if (blocks > 0)
+	{
+		flush();
+	}
+}
+
+void sumSquaredSpansNeon(const ColorRgb* image, int width, const PixelSpan* spans, int spanCount, ChannelSums& sums)
+{
+	uint32x4_t acc[3] = {vdupq_n_u32(0), vdupq_n_u32(0), vdupq_n_u32(0)};
+	int blocks = 0;
+
+	auto flush = [&]() {
+		sums.red += horizontalSum(acc[0]);
+		sums.green += horizontalSum(acc[1]);
+		sums.blue += horizontalSum(acc[2]);
+		for (uint32x4_t& lane : acc)
+		{
+			lane = vdupq_n_u32(0);
+		}
+		blocks = 0;
+	};
+
+	for (const PixelSpan* span = spans; span != spans + spanCount; ++span)
+	{
+		const ColorRgb* pixel = image + static_cast<ptrdiff_t>(span->row) * width + span->xBegin;
+		int count = span->xEnd - span->xBegin;
+		for (; count >= BLOCK_PIXELS; count -= BLOCK_PIXELS, pixel += BLOCK_PIXELS)
+		{
+			const uint8x16x3_t data = vld3q_u8(reinterpret_cast<const uint8_t*>(pixel));
+			for (int c = 0; c < 3; ++c)
+			{
+				const uint8x8_t lo = vget_low_u8(data.val[c]);
+				const uint8x8_t hi = vget_high_u8(data.val[c]);
+				acc[c] = vpadalq_u16(acc[c], vmull_u8(lo, lo));
+				acc[c] = vpadalq_u16(acc[c], vmull_u8(hi, hi));
+			}
+			if (++blocks == MAX_BLOCKS_SQUARED_NEON)
+			{
+				flush();
+			}
+		}
+		sumSquaredScalar(pixel, count, sums);
+	}
+	if (blocks > 0)
+	{
+		flush();
+	}
+}
+
+#endif // KERNELS_NEON
+
+const AccumulateKernels SCALAR_KERNELS {"scalar", &sumSpansScalar, &sumSquaredSpansScalar};
+#ifdef KERNELS_X86
+const AccumulateKernels SSE2_KERNELS {"sse2", &sumSpansSse2, &sumSquaredSpansSse2};
+const AccumulateKernels AVX2_KERNELS {"avx2", &sumSpansAvx2, &sumSquaredSpansAvx2};
+#endif
+#ifdef KERNELS_NEON
+const AccumulateKernels NEON_KERNELS {"neon", &sumSpansNeon, &sumSquaredSpansNeon};
+#endif
+
+} // namespace
+
+const AccumulateKernels& hyperion::kernels::scalarKernels()
+{
+	return SCALAR_KERNELS;
+}
+
+QVector<const AccumulateKernels*> hyperion::kernels::availableKernels()
+{
+	QVector<const AccumulateKernels*> available {&SCALAR_KERNELS};
+#ifdef KERNELS_X86
+	available.append(&SSE2_KERNELS);
+	if (cpuSupportsAvx2())
+	{
+		available.append(&AVX2_KERNELS);
+	}
+#endif
+#ifdef KERNELS_NEON
+	available.append(&NEON_KERNELS);
+#endif
+	return available;
+}
+
+const AccumulateKernels& hyperion::kernels::accumulateKernels()
+{
+	static const AccumulateKernels* const selected = availableKernels().last();
+	return *selected;
+}
@@ -0,0 +1,252 @@
+#include <hyperion/LedOutputPipeline.h>
+#include <hyperion/MultiColorAdjustment.h>
+
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__))
+#define KERNELS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define TARGET_SSSE3
+#else
+#define TARGET_SSSE3 __attribute__((target("ssse3")))
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace hyperion;
+using namespace hyperion::kernels;
+
+namespace {
+
+/// Number of LEDs processed per block (1.5 KiB of color data)
+constexpr int BLOCK_LEDS = 512;
+
+void shuffleScalar(ColorRgb* pixels, int count, const ShuffleIndices& indices)
+{
+	for (ColorRgb* pixel = pixels; pixel != pixels + count; ++pixel)
+	{
+		const uint8_t bytes[3] = { pixel->red, pixel->green, pixel->blue };
+		pixel->red = bytes[indices[0]];
+		pixel->green = bytes[indices[1]];
+		pixel->blue = bytes[indices[2]];
+	}
+}
+
+#ifdef KERNELS_X86
+
+// A 16 byte register holds 5 complete pixels, the last byte belongs to the next pixel and is kept as is.
+TARGET_SSSE3 void shuffleSsse3(ColorRgb* pixels, int count, const ShuffleIndices& indices)
+{
+	alignas(16) uint8_t maskBytes[16];
+	for (int pixel = 0; pixel < 5; ++pixel)
+	{
+		for (int channel = 0; channel < 3; ++channel)
+		{
+			maskBytes[pixel * 3 + channel] = static_cast<uint8_t>(pixel * 3 + indices[channel]);
+		}
+	}
+	maskBytes[15] = 15;
+	const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(maskBytes));
+
+	uint8_t* data = reinterpret_cast<uint8_t*>(pixels);
+	// at least 6 pixels are required to read 16 bytes without leaving the run
+	for (; count >= 6; count -= 5, data += 15)
+	{
+		const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(data), _mm_shuffle_epi8(bytes, mask));
+	}
+	shuffleScalar(reinterpret_cast<ColorRgb*>(data), count, indices);
+}
+
+bool cpuSupportsSsse3()
+{
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 1);
+	return (info[2] & (1 << 9)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("ssse3") != 0;
+#endif
+}
+
+#endif // KERNELS_X86
+
+#ifdef KERNELS_NEON
+
+// vld3q_u8 de-interleaves the channels, reordering them is a plain register selection.
+void shuffleNeon(ColorRgb* pixels, int count, const ShuffleIndices& indices)
+{
+	uint8_t* data = reinterpret_cast<uint8_t*>(pixels);
+	for (; count >= 16; count -= 16, data += 48)
+	{
+		const uint8x16x3_t channels = vld3q_u8(data);
+		uint8x16x3_t reordered;
+		reordered.val[0] = channels.val[indices[0]];
+		reordered.val[1] = channels.val[indices[1]];
+		reordered.val[2] = channels.val[indices[2]];
+		vst3q_u8(data, reordered);
+	}
+	shuffleScalar(reinterpret_cast<ColorRgb*>(data), count, indices);
+}
+
+#endif // KERNELS_NEON
+
+const ShuffleKernel SCALAR_SHUFFLE {"scalar", &shuffleScalar};
+#ifdef KERNELS_X86
+const ShuffleKernel SSSE3_SHUFFLE {"ssse3", &shuffleSsse3};
+#endif
+#ifdef KERNELS_NEON
+const ShuffleKernel NEON_SHUFFLE {"neon", &shuffleNeon};
+#endif
+
+} // namespace
+
+const ShuffleKernel& hyperion::kernels::scalarShuffleKernel()
+{
+	return SCALAR_SHUFFLE;
+}
+
+QVector<const ShuffleKernel*> hyperion::kernels::availableShuffleKernels()
+{
+	QVector<const ShuffleKernel*> available {&SCALAR_SHUFFLE};
+#ifdef KERNELS_X86
+	if (cpuSupportsSsse3())
+	{
+		available.append(&SSSE3_SHUFFLE);
+	}
+#endif
+#ifdef KERNELS_NEON
+	available.append(&NEON_SHUFFLE);
+#endif
+	return available;
+}
+
+const ShuffleKernel& hyperion::kernels::shuffleKernel()
+{
+	static const ShuffleKernel* const selected = availableShuffleKernels().last();
+	return *selected;
+}
+
+LedOutputPipeline::LedOutputPipeline()
+	: _shuffleKernel(&kernels::shuffleKernel())
+{
+}
+
+ShuffleIndices LedOutputPipeline::shuffleIndices(ColorOrder order)
+{
+	switch (order)
+	{
+	case ColorOrder::ORDER_RBG:
+		return {0, 2, 1};
+	case ColorOrder::ORDER_GRB:
+		return {1, 0, 2};
+	case ColorOrder::ORDER_GBR:
+		return {1, 2, 0};
+	case ColorOrder::ORDER_BRG:
+		return {2, 0, 1};
+	case ColorOrder::ORDER_BGR:
+		return {2, 1, 0};
+	case ColorOrder::ORDER_RGB:
+	default:
+		return {0, 1, 2};
+	}
+}
+
+void LedOutputPipeline::compile(const QVector<ColorOrder>& colorOrders, const QVector<int>& blacklistedLedIds, const MultiColorAdjustment* adjustment)
+{
+	const int ledCount = colorOrders.size();
+
+	_adjustmentRuns.clear();
+	_keepMask.assign(static_cast<size_t>(ledCount), UINT8_MAX);
+	_shuffleRuns.clear();
+
+	if (adjustment != nullptr)
+	{
+		for (const MultiColorAdjustment::AdjustmentRange& range : adjustment->getAdjustmentRanges())
+		{
+			if (range.begin >= ledCount)
+			{
+				break;
+			}
+			_adjustmentRuns.push_back({range.begin, std::min(range.end, ledCount), range.adjustment});
+		}
+	}
+
+	for (int id : blacklistedLedIds)
+	{
+		if (id >= 0 && id < ledCount)
+		{
+			_keepMask[static_cast<size_t>(id)] = 0;
+		}
+	}
+
+	for (int idx = 0; idx < ledCount; ++idx)
+	{
+		const ColorOrder order = colorOrders[idx];
+		if (order == ColorOrder::ORDER_RGB)
+		{
+			continue;
+		}
+		if (!_shuffleRuns.empty() && _shuffleRuns.back().end == idx && colorOrders[idx - 1] == order)
+		{
+			++_shuffleRuns.back().end;
+		}
+		else
+		{
+			_shuffleRuns.push_back({idx, idx + 1, shuffleIndices(order)});
+		}
+	}
+}
+
+void LedOutputPipeline::apply(QVector<ColorRgb>& ledColors) const
+{
+	const int ledCount = std::min(size(), static_cast<int>(ledColors.size()));
+	ColorRgb* const colors = ledColors.data();
+	auto adjustmentRun = _adjustmentRuns.cbegin();
+	auto shuffleRun = _shuffleRuns.cbegin();
+
+	for (int blockBegin = 0; blockBegin < ledCount; blockBegin += BLOCK_LEDS)
+	{
+		const int blockEnd = std::min(blockBegin + BLOCK_LEDS, ledCount);
+
+		// Blacklisted LEDs are switched off before the adjustment (e.g. backlight) is applied
+		for (int idx = blockBegin; idx < blockEnd; ++idx)
+		{
+			const uint8_t keep = _keepMask[static_cast<size_t>(idx)];
+			colors[idx].red &= keep;
+			colors[idx].green &= keep;
+			colors[idx].blue &= keep;
+		}
+
+		// One dispatch per run of LEDs sharing an adjustment
+		for (; adjustmentRun != _adjustmentRuns.cend() && adjustmentRun->begin < blockEnd; ++adjustmentRun)
+		{
+			const int begin = std::max(adjustmentRun->begin, blockBegin);
+			const int end = std::min(adjustmentRun->end, blockEnd);
+			MultiColorAdjustment::applyAdjustment(*adjustmentRun->adjustment, colors + begin, end - begin);
+			if (adjustmentRun->end > blockEnd)
+			{
+				// continued in the next block
+				break;
+			}
+		}
+
+		// Reorder the channels of the block while it is still cached
+		for (; shuffleRun != _shuffleRuns.cend() && shuffleRun->begin < blockEnd; ++shuffleRun)
+		{
+			const int begin = std::max(shuffleRun->begin, blockBegin);
+			const int end = std::min(shuffleRun->end, blockEnd);
+			_shuffleKernel->shuffle(colors + begin, end - begin, shuffleRun->indices);
+			if (shuffleRun->end > blockEnd)
+			{
+				// continued in the next block
+				break;
+			}
+		}
+	}
+}
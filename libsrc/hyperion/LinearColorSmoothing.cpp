@@ -1,5 +1,6 @@
 #include <hyperion/LinearColorSmoothing.h>
 
+#include <algorithm>
 #include <cmath>
 #include <chrono>
 #include <thread>
@@ -16,29 +17,17 @@
 #include <QTimer>
 
 #include <hyperion/Hyperion.h>
+#include <hyperion/SmoothingKernels.h>
+#include <hyperion/OutputPacer.h>
 
 Q_LOGGING_CATEGORY(smoothing, "hyperion.smoothing")
 
-/// Clamps the rounded values to the byte-interval of [0, 255].
-ALWAYS_INLINE long clampRounded(const floatT x) {
-	return std::min(255L, std::max(0L, std::lroundf(x)));
-}
-
 // Constants
 namespace {
 
 /// The number of microseconds per millisecond = 1000.
 const int64_t MS_PER_MICRO = 1000;
 
-/// The number of bits that are used for shifting the fixed point values
-const int FPShift = (sizeof(uint64_t)*8 - (12 + 9));
-
-/// The number of bits that are reduce the shifting when converting from fixed to floating point. 8 bits = 256 values
-const int SmallShiftBis = sizeof(uint8_t)*8;
-
-/// The number of bits that are used for shifting the fixed point values plus SmallShiftBis
-const int FPShiftSmall = (sizeof(uint64_t)*8 - (12 + 9 + SmallShiftBis));
-
 const char* SETTINGS_KEY_SMOOTHING_TYPE = "type";
 
 const char* SETTINGS_KEY_SETTLING_TIME = "time_ms";
@@ -48,12 +37,52 @@ const char* SETTINGS_KEY_OUTPUT_DELAY = "updateDelay";
 const char* SETTINGS_KEY_DECAY = "decay";
 const char* SETTINGS_KEY_INTERPOLATION_RATE = "interpolationRate";
 const char* SETTINGS_KEY_DITHERING = "dithering";
+const char* SETTINGS_KEY_OUTPUT_PACING = "outputPacing";
 
 const int64_t DEFAULT_SETTLINGTIME = 200;	// in ms
 const int DEFAULT_UPDATEFREQUENCY = 25;		// in Hz
 
 constexpr std::chrono::milliseconds DEFAULT_UPDATEINTERVALL{MS_PER_MICRO/ DEFAULT_UPDATEFREQUENCY};
 const unsigned DEFAULT_OUTPUTDEPLAY = 0;	// in frames
+
+/// Linear weighting of a frame = (end - start) * scale
+struct LinearWeight
+{
+	floatT invWindow;
+
+	ALWAYS_INLINE floatT operator()(const int64_t frameStart, const int64_t frameEnd, const int64_t /*windowStart*/) const
+	{
+		return static_cast<floatT>((frameEnd - frameStart) * invWindow);
+	}
+};
+
+/// Exponential weighting of a frame, the power-based approach for calculating the moving average values for decay != 1
+struct ExponentialWeight
+{
+	floatT invWindow;
+	float decay;
+
+	ALWAYS_INLINE floatT operator()(const int64_t frameStart, const int64_t frameEnd, const int64_t windowStart) const
+	{
+		const floatT s = (frameStart - windowStart) * invWindow;
+		const floatT t = (frameEnd - windowStart) * invWindow;
+
+		return (decay + 1) * (std::pow(t, decay) - std::pow(s, decay));
+	}
+};
+
+/// The LED colors as components
+ALWAYS_INLINE const uint8_t* components(const QVector<ColorRgb>& colors)
+{
+	return reinterpret_cast<const uint8_t*>(colors.constData());
+}
+
+/// Copies the LED colors into the buffer of a queued frame, reusing its memory unless it is still shared
+void assignColors(QVector<ColorRgb>& buffer, const QVector<ColorRgb>& colors)
+{
+	buffer.resize(colors.size());
+	std::copy(colors.cbegin(), colors.cend(), buffer.begin());
+}
 }
 
 using namespace hyperion;
@@ -62,18 +91,21 @@ LinearColorSmoothing::LinearColorSmoothing(const QJsonObject &config, const QSha
 	: QObject()
 	, _smoothConfig(config)
 	, _log(nullptr)
+	, _smoothingLatency(nullptr)
 	, _hyperionWeak(hyperionInstance)
 	, _prioMuxerWeak(nullptr)
 	, _updateInterval(DEFAULT_UPDATEINTERVALL.count())
 	, _settlingTime(DEFAULT_SETTLINGTIME)
 	, _timer(nullptr)
+	, _isOutputPacing(false)
+	, _outputPacer(nullptr)
+	, _targetCaptureTime_ns(0)
 	, _outputDelay(DEFAULT_OUTPUTDEPLAY)
 	, _pause(false)
 	, _currentConfigId(SmoothingConfigID::SYSTEM)
 	, _enabled(false)
 	, _enabledSystemCfg(false)
 	, _smoothingType(SmoothingType::Linear)
-	, tempValues(std::vector<uint64_t>())
 {
 	QString subComponent{ "__" };
 	QSharedPointer<Hyperion> hyperion = _hyperionWeak.toStrongRef();
@@ -84,6 +116,7 @@ LinearColorSmoothing::LinearColorSmoothing(const QJsonObject &config, const QSha
 	}
 	_log= Logger::getInstance("SMOOTHING", subComponent);
 	TRACK_SCOPE_SUBCOMPONENT();
+	_smoothingLatency = LatencyMetrics::getInstance().histogram(LatencyMetrics::STAGE_SMOOTHING, subComponent);
 
 	// init cfg (default)
 	updateConfig(SmoothingConfigID::SYSTEM, DEFAULT_SETTLINGTIME, DEFAULT_UPDATEFREQUENCY, DEFAULT_OUTPUTDEPLAY);
@@ -94,6 +127,10 @@ LinearColorSmoothing::LinearColorSmoothing(const QJsonObject &config, const QSha
 LinearColorSmoothing::~LinearColorSmoothing()
 {
 	TRACK_SCOPE_SUBCOMPONENT();
+	if (!_outputPacer.isNull())
+	{
+		_outputPacer->stop();
+	}
 }
 
 void LinearColorSmoothing::start()
@@ -104,6 +141,15 @@ void LinearColorSmoothing::start()
 	_timer.reset(new QTimer());
 	_timer->setTimerType(Qt::PreciseTimer);
 
+	// The pacing thread is stopped before the instance, so it must not hold a strong reference
+	Hyperion* hyperion = _hyperionWeak.toStrongRef().data();
+	_outputPacer.reset(new OutputPacer(
+		[hyperion](const QVector<ColorRgb>& ledColors, qint64 captureTime_ns) {
+			emit hyperion->ledDeviceData(ledColors, captureTime_ns);
+		},
+		LatencyMetrics::getInstance().histogram(LatencyMetrics::STAGE_OUTPUT_JITTER, hyperion->property("instance").toString()),
+		_log));
+
 	//Start in pause mode, a new priority will activate smoothing (either start-effect or grabber)
 	setPause(true);
 
@@ -123,6 +169,7 @@ void LinearColorSmoothing::stop()
 
 	setEnable(false);
 	_timer->stop();
+	_outputPacer->stop();
 
 	Info(_log, "LinearColorSmoothing stopped");
 }
@@ -156,11 +203,14 @@ void LinearColorSmoothing::updateSettings(const QJsonObject &config)
 		_cfgList[SmoothingConfigID::SYSTEM] = cfg;
 		DebugIf(_enabled,_log,"%s", QSTRING_CSTR(getConfig(SmoothingConfigID::SYSTEM)));
 
+		_isOutputPacing = config[SETTINGS_KEY_OUTPUT_PACING].toBool(false);
+
 		// if current id is 0, we need to apply the settings (forced)
 		if (_currentConfigId == SmoothingConfigID::SYSTEM)
 		{
 			selectConfig(SmoothingConfigID::SYSTEM, true);
 		}
+		updateOutputPacing();
 }
 
 void LinearColorSmoothing::handleSettingsUpdate(settings::type type, const QJsonDocument &config)
@@ -181,10 +231,11 @@ void LinearColorSmoothing::handlePriorityUpdate(int priority)
 	}
 }
 
-int LinearColorSmoothing::write(const QVector<ColorRgb> &ledValues)
+int LinearColorSmoothing::write(const QVector<ColorRgb> &ledValues, qint64 captureTime_ns)
 {
 	_targetTime = micros() + (MS_PER_MICRO * _settlingTime);
 	_targetValues = ledValues;
+	_targetCaptureTime_ns = captureTime_ns;
 
 	rememberFrame(ledValues);
 
@@ -205,7 +256,7 @@ int LinearColorSmoothing::write(const QVector<ColorRgb> &ledValues)
 	return 0;
 }
 
-int LinearColorSmoothing::updateLedValues(const QVector<ColorRgb> &ledValues)
+int LinearColorSmoothing::updateLedValues(const QVector<ColorRgb> &ledValues, qint64 captureTime_ns)
 {
 	int retval = 0;
 	if (!_enabled)
@@ -214,7 +265,7 @@ int LinearColorSmoothing::updateLedValues(const QVector<ColorRgb> &ledValues)
 	}
 	else
 	{
-		retval = write(ledValues);
+		retval = write(ledValues, captureTime_ns);
 	}
 	return retval;
 }
@@ -228,13 +279,12 @@ void LinearColorSmoothing::intitializeComponentVectors(const size_t ledCount)
 
 		const size_t len = 3 * ledCount;
 
-		meanValues = std::vector<floatT>(len, 0.0F);
-		residualErrors = std::vector<floatT>(len, 0.0F);
-		tempValues = std::vector<uint64_t>(len, 0L);
+		meanValues = std::vector<uint32_t>(len, 0);
+		residualErrors = std::vector<int32_t>(len, 0);
 	}
 
-	// Zero the temp vector
-	std::fill(tempValues.begin(), tempValues.end(), 0L);
+	// Zero the mean values to accumulate the frames
+	std::fill(meanValues.begin(), meanValues.end(), 0);
 }
 
 void LinearColorSmoothing::writeDirect()
@@ -269,31 +319,10 @@ void LinearColorSmoothing::assembleAndDitherFrame()
 	}
 
 	// The number of LEDs present in each frame
-	const size_t N = _targetValues.size();
-
-	for (size_t i = 0; i < N; ++i)
-	{
-		// Add residuals for error diffusion (temporal dithering)
-		const floatT fr = meanValues[3 * i + 0] + residualErrors[3 * i + 0];
-		const floatT fg = meanValues[3 * i + 1] + residualErrors[3 * i + 1];
-		const floatT fb = meanValues[3 * i + 2] + residualErrors[3 * i + 2];
+	const size_t N = std::min(_ledCount, static_cast<size_t>(_previousValues.size()));
 
-		// Convert to to 8-bit value
-		const long ir = clampRounded(fr);
-		const long ig = clampRounded(fg);
-		const long ib = clampRounded(fb);
-
-		// Update the colors
-		ColorRgb &prev = _previousValues[i];
-		prev.red = static_cast<uint8_t>(ir);
-		prev.green = static_cast<uint8_t>(ig);
-		prev.blue = static_cast<uint8_t>(ib);
-
-		// Determine the component errors
-		residualErrors[3 * i + 0] = fr - ir;
-		residualErrors[3 * i + 1] = fg - ig;
-		residualErrors[3 * i + 2] = fb - ib;
-	}
+	// Add residuals for error diffusion (temporal dithering), convert to 8-bit values and keep the component errors
+	smoothing::smoothingKernels().dither(meanValues.data(), residualErrors.data(), static_cast<int>(3 * N), reinterpret_cast<uint8_t*>(_previousValues.data()));
 }
 
 void LinearColorSmoothing::assembleFrame()
@@ -304,46 +333,14 @@ void LinearColorSmoothing::assembleFrame()
 	}
 
 	// The number of LEDs present in each frame
-	const size_t N = _targetValues.size();
-
-	for (size_t i = 0; i < N; ++i)
-	{
-		// Convert to to 8-bit value
-		const long ir = clampRounded(meanValues[3 * i + 0]);
-		const long ig = clampRounded(meanValues[3 * i + 1]);
-		const long ib = clampRounded(meanValues[3 * i + 2]);
+	const size_t N = std::min(_ledCount, static_cast<size_t>(_previousValues.size()));
 
-		// Update the colors
-		ColorRgb &prev = _previousValues[i];
-		prev.red = static_cast<uint8_t>(ir);
-		prev.green = static_cast<uint8_t>(ig);
-		prev.blue = static_cast<uint8_t>(ib);
-	}
+	// Convert to 8-bit values
+	smoothing::smoothingKernels().assemble(meanValues.data(), static_cast<int>(3 * N), reinterpret_cast<uint8_t*>(_previousValues.data()));
 }
 
-ALWAYS_INLINE void LinearColorSmoothing::aggregateComponents(const QVector<ColorRgb>& colors, std::vector<uint64_t>& weighted, const floatT weight) {
-	// Determine the integer-scale by converting the weight to fixed point
-	const uint64_t scale = (static_cast<uint64_t>(1L)<<FPShift) * static_cast<double>(weight);
-
-	const size_t N = colors.size();
-
-	for (size_t i = 0; i < N; ++i)
-	{
-		const ColorRgb &color = colors[i];
-
-		// Scale the colors
-		const uint64_t red = scale * color.red;
-		const uint64_t green = scale * color.green;
-		const uint64_t blue = scale * color.blue;
-
-		// Accumulate in the vector
-		weighted[3 * i + 0] += red;
-		weighted[3 * i + 1] += green;
-		weighted[3 * i + 2] += blue;
-	}
-}
-
-void LinearColorSmoothing::interpolateFrame()
+template <typename WeightFunc>
+void LinearColorSmoothing::interpolateFrame(const WeightFunc& weightFrame)
 {
 	const int64_t now = micros();
 
@@ -366,30 +363,36 @@ void LinearColorSmoothing::interpolateFrame()
 
 	// To calculate the mean component we iterate over all relevant frames;
 	// from the most recent to the oldest frame that still clips our moving-average window given by time (now)
-	for (auto it = _frameQueue.rbegin(); it != _frameQueue.rend() && frameEnd > windowStart; ++it)
+	for (size_t i = _frameQueue.size(); i-- > 0 && frameEnd > windowStart;)
 	{
 		// Starting time of a frame in the window is clipped to the window start
-		frameStart = std::max(windowStart, it->time);
+		frameStart = std::max(windowStart, _frameQueue[i].time);
 
 		// Weight the current frame relative to the overall window based on start and end times
-		const floatT weight = _weightFrame(frameStart, frameEnd, windowStart);
-		fs += weight;
-
-		// Aggregate the RGB components of this frame's LED colors using the individual weighting
-		aggregateComponents(it->colors, tempValues, weight);
+		fs += weightFrame(frameStart, frameEnd, windowStart);
 
 		// The previous (earlier) frame display has ended when the current frame stared to show,
 		// so we can use this as the frame-end time for next iteration
 		frameEnd = frameStart;
 	}
 
-	/// The inverse scaling factor for the color components, clamped to (0, 1.0]; 1.0 for fs < 1, 1 : fs otherwise
-	const floatT inv_fs = ((fs < 1.0F) ? 1.0F : 1.0F / fs) / (1 << SmallShiftBis);
+	/// The scaling factor of the weights to fixed point, normalizing them for the window; 1.0 for fs < 1, 1 : fs otherwise
+	const floatT scale = ((fs < 1.0F) ? 1.0F : 1.0F / fs) * smoothing::FIXED_ONE;
+
+	const smoothing::SmoothingKernels& kernels = smoothing::smoothingKernels();
 
-	// Normalize the mean component values for the window (fs)
-	for (size_t i = 0; i < 3 * N; ++i)
+	// Aggregate the RGB components of the frames' LED colors using the individual normalized weighting
+	frameEnd = now;
+	for (size_t i = _frameQueue.size(); i-- > 0 && frameEnd > windowStart;)
 	{
-		meanValues[i] = (tempValues[i] >> FPShiftSmall) * inv_fs;
+		const REMEMBERED_FRAME& frame = _frameQueue[i];
+		frameStart = std::max(windowStart, frame.time);
+
+		const floatT weight = std::max(weightFrame(frameStart, frameEnd, windowStart) * scale, 0.0F);
+		const size_t count = std::min(N, static_cast<size_t>(frame.colors.size()));
+		kernels.accumulate(components(frame.colors), static_cast<int>(3 * count), static_cast<uint32_t>(weight), meanValues.data());
+
+		frameEnd = frameStart;
 	}
 
 	_previousInterpolationTime = now;
@@ -411,7 +414,14 @@ void LinearColorSmoothing::performDecay(const int64_t now) {
 	// Check whether a new interpolation frame is due
 	if (interpolatePending)
 	{
-		interpolateFrame();
+		if (_isLinearDecay)
+		{
+			interpolateFrame(LinearWeight {_invWindow});
+		}
+		else
+		{
+			interpolateFrame(ExponentialWeight {_invWindow, static_cast<float>(_decay)});
+		}
 		++_interpolationCounter;
 
 		// Assemble the frame now when no dithering is applied
@@ -466,27 +476,19 @@ void LinearColorSmoothing::performDecay(const int64_t now) {
 void LinearColorSmoothing::performLinear(const int64_t now) {
 	const int64_t deltaTime = _targetTime - now;
 	const float k = 1.0F - 1.0F * deltaTime / (_targetTime - _previousWriteTime);
-	const size_t N = _previousValues.size();
-
-	for (size_t i = 0; i < N; ++i)
-	{
-		const ColorRgb &target = _targetValues[i];
-		ColorRgb &prev         = _previousValues[i];
-
-		const int reddif   = target.red   - prev.red;
-		const int greendif = target.green - prev.green;
-		const int bluedif  = target.blue  - prev.blue;
+	const size_t N = std::min(_previousValues.size(), _targetValues.size());
 
-		prev.red   += (reddif   < 0 ? -1:1) * std::ceil(k * std::abs(reddif));
-		prev.green += (greendif < 0 ? -1:1) * std::ceil(k * std::abs(greendif));
-		prev.blue  += (bluedif  < 0 ? -1:1) * std::ceil(k * std::abs(bluedif));
-	}
+	// Move every component by the fraction k of its difference to the target, rounded up
+	const uint32_t factor = (k > 0.0F) ? static_cast<uint32_t>(std::lround(std::min(k, 1.0F) * (1 << smoothing::STEP_FRACTION_BITS))) : 0;
+	smoothing::smoothingKernels().step(components(_targetValues), static_cast<int>(3 * N), factor, reinterpret_cast<uint8_t*>(_previousValues.data()));
 
 	writeFrame();
 }
 
 void LinearColorSmoothing::updateLeds()
 {
+	const LatencyTimer timer(_smoothingLatency.data());
+
 	const int64_t now = micros();
 	const int64_t deltaTime = _targetTime - now;
 
@@ -516,22 +518,20 @@ void LinearColorSmoothing::rememberFrame(const QVector<ColorRgb> &ledColors)
 	// Maintain the queue by removing outdated frames
 	const int64_t windowStart = now - (MS_PER_MICRO * _settlingTime);
 
-	int p = -1; // Start with -1 instead of 0, so we keep the last frame at least partially clipping the window
+	size_t p = 0;
 
-	// As the frames are ordered chronologically we scan from the front (oldest) till we find the first fresh frame
-	for (auto it = _frameQueue.begin(); it != _frameQueue.end() && it->time < windowStart; ++it)
+	// As the frames are ordered chronologically we scan from the front (oldest) till we find the first fresh frame,
+	// keeping the last outdated frame as it is still partially clipping the window
+	while (p + 1 < _frameQueue.size() && _frameQueue[p + 1].time < windowStart)
 	{
 		++p;
 	}
+	_frameQueue.popFront(p);
 
-	if (p > 0)
-	{
-		_frameQueue.erase(_frameQueue.begin(), _frameQueue.begin() + p);
-	}
-
-	// Append the latest frame at back of the queue
-	const REMEMBERED_FRAME frame = REMEMBERED_FRAME(now, ledColors);
-	_frameQueue.push_back(frame);
+	// Append the latest frame at back of the queue, reusing the buffer of a removed frame
+	REMEMBERED_FRAME& frame = _frameQueue.pushBack();
+	frame.time = now;
+	assignColors(frame.colors, ledColors);
 }
 
 
@@ -542,7 +542,6 @@ void LinearColorSmoothing::clearRememberedFrames()
 	_ledCount = 0;
 	meanValues.clear();
 	residualErrors.clear();
-	tempValues.clear();
 }
 
 void LinearColorSmoothing::queueColors(const QVector<ColorRgb> &ledColors)
@@ -554,17 +553,15 @@ void LinearColorSmoothing::queueColors(const QVector<ColorRgb> &ledColors)
 		// No output delay => immediate write
 		if (!_pause)
 		{
-			QSharedPointer<Hyperion> hyperion = _hyperionWeak.toStrongRef();
-			if (hyperion)
-			{
-				emit hyperion->ledDeviceData(ledColors);
-			}
+			outputColors(ledColors, _targetCaptureTime_ns);
 		}
 	}
 	else
 	{
 		// Push new colors in the delay-buffer
-		_outputQueue.push_back(ledColors);
+		OUTPUT_FRAME& frame = _outputQueue.pushBack();
+		assignColors(frame.colors, ledColors);
+		frame.captureTime_ns = _targetCaptureTime_ns;
 
 		// If the delay-buffer is filled pop the front and write to device
 		if (!_outputQueue.empty())
@@ -573,18 +570,46 @@ void LinearColorSmoothing::queueColors(const QVector<ColorRgb> &ledColors)
 			{
 				if (!_pause)
 				{
-					QSharedPointer<Hyperion> hyperion = _hyperionWeak.toStrongRef();
-					if (hyperion)
-					{
-						emit hyperion->ledDeviceData(_outputQueue.front());
-					}
+					outputColors(_outputQueue.front().colors, _outputQueue.front().captureTime_ns);
 				}
-				_outputQueue.pop_front();
+				_outputQueue.popFront();
 			}
 		}
 	}
 }
 
+void LinearColorSmoothing::outputColors(const QVector<ColorRgb> &ledColors, qint64 captureTime_ns)
+{
+	if (!_outputPacer.isNull() && _outputPacer->isRunning())
+	{
+		_outputPacer->post(ledColors, captureTime_ns);
+		return;
+	}
+
+	QSharedPointer<Hyperion> hyperion = _hyperionWeak.toStrongRef();
+	if (hyperion)
+	{
+		emit hyperion->ledDeviceData(ledColors, captureTime_ns);
+	}
+}
+
+void LinearColorSmoothing::updateOutputPacing()
+{
+	if (_outputPacer.isNull())
+	{
+		return;
+	}
+
+	if (_isOutputPacing && _enabled && _updateInterval > 0)
+	{
+		_outputPacer->start(std::chrono::milliseconds(_updateInterval));
+	}
+	else
+	{
+		_outputPacer->stop();
+	}
+}
+
 void LinearColorSmoothing::clearQueuedColors()
 {
 	_timer->stop();
@@ -612,6 +637,8 @@ void LinearColorSmoothing::setEnable(bool enable)
 		{
 			clearQueuedColors();
 		}
+		updateOutputPacing();
+
 		// update comp register
 		QSharedPointer<Hyperion> hyperion = _hyperionWeak.toStrongRef();
 		if (hyperion)
@@ -687,27 +714,8 @@ bool LinearColorSmoothing::selectConfig(int cfgID, bool force)
 		_decay = _cfgList[cfgID]._decay;
 		_invWindow = 1.0F / (MS_PER_MICRO * _settlingTime);
 
-		// Set _weightFrame based on the given decay
-		const float decay = _decay;
-		const floatT inv_window = _invWindow;
-
-		// For decay != 1 use power-based approach for calculating the moving average values
-		if(std::abs(decay - 1.0F) > std::numeric_limits<float>::epsilon()) {
-			// Exponential Decay
-			_weightFrame = [inv_window,decay](const int64_t fs, const int64_t fe, const int64_t ws) {
-				const floatT s = (fs - ws) * inv_window;
-				const floatT t = (fe - ws) * inv_window;
-
-				return (decay + 1) * (std::pow(t, decay) - std::pow(s, decay));
-			};
-		} else {
-			// For decay == 1 use linear interpolation of the moving average values
-			// Linear Decay
-			_weightFrame = [inv_window](const int64_t fs, const int64_t fe, const int64_t /*ws*/) {
-				// Linear weighting = (end - start) * scale
-				return static_cast<floatT>((fe - fs) * inv_window);
-			};
-		}
+		// For decay != 1 use power-based approach for calculating the moving average values, linear interpolation otherwise
+		_isLinearDecay = std::abs(static_cast<float>(_decay) - 1.0F) <= std::numeric_limits<float>::epsilon();
 
 		_renderedStatTime = micros();
 		_renderedCounter = 0;
@@ -740,7 +748,14 @@ bool LinearColorSmoothing::selectConfig(int cfgID, bool force)
 					_timer->start(_updateInterval);
 				}
 			}
+			updateOutputPacing();
 		}
+
+		// Size the queues for the frames of a settling time at the update frequency and the configured output delay,
+		// the remembered frames are kept as they may still clip the window
+		_frameQueue.setCapacity(std::max(static_cast<size_t>(_settlingTime / std::max(_updateInterval, 1)) + 2, _frameQueue.size()));
+		_outputQueue.setCapacity(_outputDelay + 1);
+
 		_currentConfigId = cfgID;
 		DebugIf(_enabled, _log,"%s", QSTRING_CSTR(getConfig(_currentConfigId)));
 
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <utility>
 
 // Hyperion includes
 
@@ -51,6 +52,27 @@ void MultiColorAdjustment::setAdjustmentForLed(const QString& adjutmentId, int s
 	}
 }
 
+void MultiColorAdjustment::updateAdjustmentRanges()
+{
+	_adjustmentRanges.clear();
+	for (int iLed = 0; iLed < static_cast<int>(_ledAdjustments.size()); ++iLed)
+	{
+		ColorAdjustment* adjustment = _ledAdjustments[iLed];
+		if (adjustment == nullptr)
+		{
+			continue;
+		}
+		if (!_adjustmentRanges.isEmpty() && _adjustmentRanges.last().end == iLed && _adjustmentRanges.last().adjustment == adjustment)
+		{
+			++_adjustmentRanges.last().end;
+		}
+		else
+		{
+			_adjustmentRanges.append({iLed, iLed + 1, adjustment});
+		}
+	}
+}
+
 bool MultiColorAdjustment::verifyAdjustments() const
 {
 	bool isAdjustmentDefined = true;
@@ -96,69 +118,127 @@ void MultiColorAdjustment::setBacklightEnabled(bool enable)
 
 void MultiColorAdjustment::applyAdjustment(QVector<ColorRgb>& ledColors)
 {
-	const size_t itCnt = qMin(_ledAdjustments.size(), ledColors.size());
-	for (size_t i=0; i<itCnt; ++i)
+	// LEDs without adjustment are not part of any range (do nothing)
+	const int ledCount = static_cast<int>(ledColors.size());
+	for (const AdjustmentRange& range : std::as_const(_adjustmentRanges))
 	{
-		ColorAdjustment* adjustment = _ledAdjustments[i];
-		if (adjustment == nullptr)
+		if (range.begin >= ledCount)
 		{
-			// No transform set for this LED (do nothing)
-			continue;
+			break;
 		}
-		ColorRgb& color = ledColors[i];
+		applyAdjustment(*range.adjustment, ledColors.data() + range.begin, qMin(range.end, ledCount) - range.begin);
+	}
+}
+
+void MultiColorAdjustment::applyAdjustment(ColorAdjustment& adjustment, ColorRgb& color)
+{
+	const hyperion::ColorLut* const lut = adjustment._lut.data();
+	if (lut != nullptr)
+	{
+		lut->apply(color);
+	}
+	else
+	{
+		calculateAdjustment(adjustment, color);
+	}
 
-		uint8_t ored   = color.red;
-		uint8_t ogreen = color.green;
-		uint8_t oblue  = color.blue;
-		uint8_t B_RGB = 0;
-		uint8_t B_CMY = 0;
-		uint8_t B_W = 0;
+	adjustment._rgbTransform.applyBacklight(color.red, color.green, color.blue);
+}
 
-		if (!adjustment->_okhsvTransform.isIdentity())
+void MultiColorAdjustment::applyAdjustment(ColorAdjustment& adjustment, ColorRgb* colors, int count)
+{
+	const hyperion::ColorLut* const lut = adjustment._lut.data();
+	if (lut != nullptr)
+	{
+		for (ColorRgb* color = colors; color != colors + count; ++color)
+		{
+			lut->apply(*color);
+		}
+	}
+	else
+	{
+		for (ColorRgb* color = colors; color != colors + count; ++color)
 		{
-			adjustment->_okhsvTransform.transform(ored, ogreen, oblue);
+			calculateAdjustment(adjustment, *color);
 		}
+	}
 
-		adjustment->_rgbTransform.applyGamma(ored,ogreen,oblue);
-		adjustment->_rgbTransform.getBrightnessComponents(B_RGB, B_CMY, B_W);
-
-		uint32_t nr_ng = static_cast<uint32_t>((UINT8_MAX - ored) * (UINT8_MAX - ogreen));
-		uint32_t r_ng  = static_cast<uint32_t>(ored * (UINT8_MAX - ogreen));
-		uint32_t nr_g  = static_cast<uint32_t>((UINT8_MAX - ored) * ogreen);
-		uint32_t r_g   = static_cast<uint32_t>(ored * ogreen);
-
-		uint8_t black   = static_cast<uint8_t>(nr_ng * (UINT8_MAX - oblue) / DOUBLE_UINT8_MAX_SQUARED);
-		uint8_t red     = static_cast<uint8_t>(r_ng * (UINT8_MAX - oblue) / DOUBLE_UINT8_MAX_SQUARED);
-		uint8_t green   = static_cast<uint8_t>(nr_g * (UINT8_MAX - oblue) / DOUBLE_UINT8_MAX_SQUARED);
-		uint8_t blue    = static_cast<uint8_t>(nr_ng * (oblue) / DOUBLE_UINT8_MAX_SQUARED);
-		uint8_t cyan    = static_cast<uint8_t>(nr_g * (oblue) / DOUBLE_UINT8_MAX_SQUARED);
-		uint8_t magenta = static_cast<uint8_t>(r_ng * (oblue) / DOUBLE_UINT8_MAX_SQUARED);
-		uint8_t yellow  = static_cast<uint8_t>(r_g * (UINT8_MAX - oblue) / DOUBLE_UINT8_MAX_SQUARED);
-		uint8_t white   = static_cast<uint8_t>(r_g * (oblue) / DOUBLE_UINT8_MAX_SQUARED);
-
-		uint8_t OR, OG, OB;  // Original Colors
-		uint8_t RR, RG, RB;  // Red Adjustments
-		uint8_t GR, GG, GB;  // Green Adjustments
-		uint8_t BR, BG, BB;  // Blue Adjustments
-		uint8_t CR, CG, CB;  // Cyan Adjustments
-		uint8_t MR, MG, MB;  // Magenta Adjustments
-		uint8_t YR, YG, YB;  // Yellow Adjustments
-		uint8_t WR, WG, WB;  // White Adjustments
-
-		adjustment->_rgbBlackAdjustment.apply  (black  , UINT8_MAX, OR, OG, OB);
-		adjustment->_rgbRedAdjustment.apply    (red    , B_RGB, RR, RG, RB);
-		adjustment->_rgbGreenAdjustment.apply  (green  , B_RGB, GR, GG, GB);
-		adjustment->_rgbBlueAdjustment.apply   (blue   , B_RGB, BR, BG, BB);
-		adjustment->_rgbCyanAdjustment.apply   (cyan   , B_CMY, CR, CG, CB);
-		adjustment->_rgbMagentaAdjustment.apply(magenta, B_CMY, MR, MG, MB);
-		adjustment->_rgbYellowAdjustment.apply (yellow , B_CMY, YR, YG, YB);
-		adjustment->_rgbWhiteAdjustment.apply  (white  , B_W  , WR, WG, WB);
-
-		color.red   = OR + RR + GR + BR + CR + MR + YR + WR;
-		color.green = OG + RG + GG + BG + CG + MG + YG + WG;
-		color.blue  = OB + RB + GB + BB + CB + MB + YB + WB;
-
-		adjustment->_rgbTransform.applyTemperature(color);
-		adjustment->_rgbTransform.applyBacklight(color.red, color.green, color.blue);
+	adjustment._rgbTransform.applyBacklight(colors, count);
+}
+
+void MultiColorAdjustment::calculateAdjustment(ColorAdjustment& adjustment, ColorRgb& color)
+{
+	if (!adjustment._okhsvTransform.isIdentity())
+	{
+		adjustment._okhsvTransform.transform(color.red, color.green, color.blue);
 	}
+
+	adjustment._rgbTransform.applyGamma(color.red, color.green, color.blue);
+
+	calculateChannelAdjustment(adjustment, color);
+}
+
+void MultiColorAdjustment::calculateChannelAdjustment(ColorAdjustment& adjustment, ColorRgb& color)
+{
+	const uint8_t ored   = color.red;
+	const uint8_t ogreen = color.green;
+	const uint8_t oblue  = color.blue;
+	uint8_t B_RGB = 0;
+	uint8_t B_CMY = 0;
+	uint8_t B_W = 0;
+
+	adjustment._rgbTransform.getBrightnessComponents(B_RGB, B_CMY, B_W);
+
+	uint32_t nr_ng = static_cast<uint32_t>((UINT8_MAX - ored) * (UINT8_MAX - ogreen));
+	uint32_t r_ng  = static_cast<uint32_t>(ored * (UINT8_MAX - ogreen));
+	uint32_t nr_g  = static_cast<uint32_t>((UINT8_MAX - ored) * ogreen);
+	uint32_t r_g   = static_cast<uint32_t>(ored * ogreen);
+
+	uint8_t black   = static_cast<uint8_t>(nr_ng * (UINT8_MAX - oblue) / DOUBLE_UINT8_MAX_SQUARED);
+	uint8_t red     = static_cast<uint8_t>(r_ng * (UINT8_MAX - oblue) / DOUBLE_UINT8_MAX_SQUARED);
+	uint8_t green   = static_cast<uint8_t>(nr_g * (UINT8_MAX - oblue) / DOUBLE_UINT8_MAX_SQUARED);
+	uint8_t blue    = static_cast<uint8_t>(nr_ng * (oblue) / DOUBLE_UINT8_MAX_SQUARED);
+	uint8_t cyan    = static_cast<uint8_t>(nr_g * (oblue) / DOUBLE_UINT8_MAX_SQUARED);
+	uint8_t magenta = static_cast<uint8_t>(r_ng * (oblue) / DOUBLE_UINT8_MAX_SQUARED);
+	uint8_t yellow  = static_cast<uint8_t>(r_g * (UINT8_MAX - oblue) / DOUBLE_UINT8_MAX_SQUARED);
+	uint8_t white   = static_cast<uint8_t>(r_g * (oblue) / DOUBLE_UINT8_MAX_SQUARED);
+
+	uint8_t OR, OG, OB;  // Original Colors
+	uint8_t RR, RG, RB;  // Red Adjustments
+	uint8_t GR, GG, GB;  // Green Adjustments
+	uint8_t BR, BG, BB;  // Blue Adjustments
+	uint8_t CR, CG, CB;  // Cyan Adjustments
+	uint8_t MR, MG, MB;  // Magenta Adjustments
+	uint8_t YR, YG, YB;  // Yellow Adjustments
+	uint8_t WR, WG, WB;  // White Adjustments
+
+	adjustment._rgbBlackAdjustment.apply  (black  , UINT8_MAX, OR, OG, OB);
+	adjustment._rgbRedAdjustment.apply    (red    , B_RGB, RR, RG, RB);
+	adjustment._rgbGreenAdjustment.apply  (green  , B_RGB, GR, GG, GB);
+	adjustment._rgbBlueAdjustment.apply   (blue   , B_RGB, BR, BG, BB);
+	adjustment._rgbCyanAdjustment.apply   (cyan   , B_CMY, CR, CG, CB);
+	adjustment._rgbMagentaAdjustment.apply(magenta, B_CMY, MR, MG, MB);
+	adjustment._rgbYellowAdjustment.apply (yellow , B_CMY, YR, YG, YB);
+	adjustment._rgbWhiteAdjustment.apply  (white  , B_W  , WR, WG, WB);
+
+	color.red   = OR + RR + GR + BR + CR + MR + YR + WR;
+	color.green = OG + RG + GG + BG + CG + MG + YG + WG;
+	color.blue  = OB + RB + GB + BB + CB + MB + YB + WB;
+
+	adjustment._rgbTransform.applyTemperature(color);
+}
+
+const QVector<ColorAdjustment*>& MultiColorAdjustment::getAdjustments() const
+{
+	return _adjustment;
+}
+
+const QVector<ColorAdjustment*>& MultiColorAdjustment::getLedAdjustments() const
+{
+	return _ledAdjustments;
+}
+
+const QVector<MultiColorAdjustment::AdjustmentRange>& MultiColorAdjustment::getAdjustmentRanges() const
+{
+	return _adjustmentRanges;
 }
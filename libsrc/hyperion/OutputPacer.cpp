@@ -0,0 +1,200 @@
+#include <hyperion/OutputPacer.h>
+
+#include <cerrno>
+#include <utility>
+
+#if defined(__linux__)
+#include <time.h>
+#endif
+
+#include <utils/Logger.h>
+
+namespace hyperion {
+
+namespace {
+
+/// Interval of the statistics written to the log
+constexpr qint64 STATISTICS_INTERVAL_NS = 30LL * 1000 * 1000 * 1000;
+
+/// Fraction of the phase error corrected per deadline once in phase, smooths the producer's jitter
+constexpr qint64 PHASE_CORRECTION_DIVISOR = 8;
+
+} // namespace
+
+OutputPacer::OutputPacer(OutputFunc output, const QSharedPointer<LatencyHistogram>& jitter, const QSharedPointer<Logger>& log)
+	: _output(std::move(output))
+	, _jitter(jitter)
+	, _log(log)
+	, _interval(0)
+{
+}
+
+OutputPacer::~OutputPacer()
+{
+	stop();
+}
+
+void OutputPacer::start(std::chrono::microseconds interval)
+{
+	if (isRunning())
+	{
+		if (interval == _interval)
+		{
+			return;
+		}
+		stop();
+	}
+
+	_interval = interval;
+	_isStopRequested.store(false);
+	_ticks.store(0);
+	_idleTicks.store(0);
+	_missedDeadlines.store(0);
+	_framesAtStart = _frames.counters();
+
+	const qint64 interval_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count();
+	_thread = std::thread(&OutputPacer::run, this, interval_ns);
+
+	Debug(_log, "Output pacing started, interval [%lld us]", static_cast<long long>(interval.count()));
+}
+
+void OutputPacer::stop()
+{
+	if (!isRunning())
+	{
+		return;
+	}
+
+	_isStopRequested.store(true);
+	_thread.join();
+
+	// drop the frame not sent, a restart must not send an outdated frame
+	Frame frame;
+	_frames.take(frame);
+
+	logStatistics();
+	Debug(_log, "Output pacing stopped");
+}
+
+void OutputPacer::post(const QVector<ColorRgb>& ledColors, qint64 captureTime_ns)
+{
+	_frames.post({ ledColors, captureTime_ns, LatencyMetrics::monotonicTime_ns() });
+}
+
+OutputPacer::Statistics OutputPacer::statistics() const
+{
+	Statistics statistics;
+	statistics.ticks = _ticks.load(std::memory_order_relaxed);
+	statistics.idleTicks = _idleTicks.load(std::memory_order_relaxed);
+	statistics.missedDeadlines = _missedDeadlines.load(std::memory_order_relaxed);
+	statistics.replacedFrames = _frames.counters().dropped - _framesAtStart.dropped;
+	return statistics;
+}
+
+void OutputPacer::run(qint64 interval_ns)
+{
+	Frame frame;
+	qint64 deadline_ns = LatencyMetrics::monotonicTime_ns() + interval_ns;
+	qint64 statisticsTime_ns = deadline_ns + STATISTICS_INTERVAL_NS;
+	bool isInPhase = false;
+
+	while (!_isStopRequested.load(std::memory_order_relaxed))
+	{
+		sleepUntil(deadline_ns);
+
+		qint64 now_ns = LatencyMetrics::monotonicTime_ns();
+		if (!_jitter.isNull())
+		{
+			_jitter->record(std::chrono::nanoseconds(now_ns - deadline_ns));
+		}
+		_ticks.fetch_add(1, std::memory_order_relaxed);
+
+		qint64 phaseShift_ns = 0;
+		if (_frames.take(frame))
+		{
+			_output(frame.ledColors, frame.captureTime_ns);
+			now_ns = LatencyMetrics::monotonicTime_ns();
+
+			phaseShift_ns = phaseError(frame, deadline_ns, interval_ns);
+			if (isInPhase)
+			{
+				phaseShift_ns /= PHASE_CORRECTION_DIVISOR;
+			}
+			isInPhase = true;
+		}
+		else
+		{
+			_idleTicks.fetch_add(1, std::memory_order_relaxed);
+			// a producer resuming after a pause posts in another phase
+			isInPhase = false;
+		}
+
+		deadline_ns += interval_ns + phaseShift_ns;
+		if (deadline_ns <= now_ns)
+		{
+			// behind schedule, skip the deadlines passed but keep the phase
+			const qint64 missed = (now_ns - deadline_ns) / interval_ns + 1;
+			_missedDeadlines.fetch_add(static_cast<quint64>(missed), std::memory_order_relaxed);
+			deadline_ns += missed * interval_ns;
+		}
+
+		if (now_ns >= statisticsTime_ns)
+		{
+			logStatistics();
+			statisticsTime_ns = now_ns + STATISTICS_INTERVAL_NS;
+		}
+	}
+}
+
+void OutputPacer::logStatistics() const
+{
+	const Statistics statistics = this->statistics();
+	if (statistics.ticks == 0)
+	{
+		return;
+	}
+
+	if (_jitter.isNull())
+	{
+		Debug(_log, "Output pacing - sent frames [%llu], idle [%llu], replaced [%llu], missed deadlines [%llu]",
+			  statistics.ticks - statistics.idleTicks, statistics.idleTicks, statistics.replacedFrames, statistics.missedDeadlines);
+		return;
+	}
+
+	const LatencyHistogram::Snapshot jitter = _jitter->snapshot();
+	Debug(_log, "Output pacing - sent frames [%llu], idle [%llu], replaced [%llu], missed deadlines [%llu], jitter mean [%llu us], p99 [%llu us], max [%llu us]",
+		  statistics.ticks - statistics.idleTicks, statistics.idleTicks, statistics.replacedFrames, statistics.missedDeadlines,
+		  jitter.count > 0 ? jitter.sum_us / jitter.count : 0, jitter.percentile(0.99), jitter.max_us);
+}
+
+qint64 OutputPacer::phaseError(const Frame& frame, qint64 deadline_ns, qint64 interval_ns)
+{
+	qint64 error_ns = (frame.postTime_ns + interval_ns / 2 - deadline_ns) % interval_ns;
+	if (error_ns > interval_ns / 2)
+	{
+		error_ns -= interval_ns;
+	}
+	else if (error_ns < -interval_ns / 2)
+	{
+		error_ns += interval_ns;
+	}
+	return error_ns;
+}
+
+void OutputPacer::sleepUntil(qint64 deadline_ns)
+{
+#if defined(__linux__)
+	// steady_clock is CLOCK_MONOTONIC on Linux, the deadline is absolute so an interrupted sleep is simply repeated
+	constexpr qint64 NS_PER_SECOND = 1000LL * 1000 * 1000;
+	timespec deadline;
+	deadline.tv_sec = static_cast<time_t>(deadline_ns / NS_PER_SECOND);
+	deadline.tv_nsec = static_cast<long>(deadline_ns % NS_PER_SECOND);
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR)
+	{
+	}
+#else
+	std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(deadline_ns))));
+#endif
+}
+
+} // end namespace hyperion
@@ -1,8 +1,9 @@
 // STL includes
+#include <algorithm>
+#include <functional>
 #include <limits>
 
 // qt incl
-#include <QDateTime>
 #include <QTimer>
 
 // Hyperion includes
@@ -10,6 +11,7 @@
 
 // utils
 #include <utils/Logger.h>
+#include <utils/LatencyMetrics.h>
 
 const int PriorityMuxer::FG_PRIORITY = 1;
 const int PriorityMuxer::BG_PRIORITY = 254;
@@ -19,6 +21,23 @@ const int PriorityMuxer::TIMEOUT_NOT_ACTIVE_PRIO = -100;
 const int PriorityMuxer::REMOVE_CLEARED_PRIO = -101;
 const int PriorityMuxer::ENDLESS = -1;
 
+namespace {
+
+/// Interval of prioritiesChanged() while channels count down their timeout
+constexpr int COUNTDOWN_INTERVAL_MS = 1000;
+
+/// Effect or color running with timeout > 0, the remaining time is listed
+bool isCountingDown(const PriorityMuxer::InputInfo& input)
+{
+	return input.priority < PriorityMuxer::BG_PRIORITY && input.timeoutTime_ms > 0 &&
+		   ( input.componentId == hyperion::COMP_EFFECT ||
+			 input.componentId == hyperion::COMP_COLOR ||
+			 (input.componentId == hyperion::COMP_IMAGE && input.owner != "Streaming")
+			 );
+}
+
+} // namespace
+
 PriorityMuxer::PriorityMuxer(int ledCount, QObject * parent)
 	: QObject(parent)
 	  , _log(nullptr)
@@ -26,10 +45,12 @@ PriorityMuxer::PriorityMuxer(int ledCount, QObject * parent)
 	  , _previousPriority(_currentPriority)
 	  , _manualSelectedPriority(MANUAL_SELECTED_PRIORITY)
 	  , _prevVisComp (hyperion::Components::COMP_COLOR)
+	  , _scheduledTimeout_ms{}
+	  , _hasClearedInputs(false)
+	  , _isUpdateEnabled(true)
 	  , _sourceAutoSelectEnabled(true)
 	  , _updateTimer(nullptr)
 	  , _timer(nullptr)
-	  , _blockTimer(nullptr)
 {
 	QString subComponent = parent->property("instance").toString();
 	_log= Logger::getInstance("MUXER", subComponent);
@@ -46,7 +67,9 @@ PriorityMuxer::PriorityMuxer(int ledCount, QObject * parent)
 	_lowestPriorityInfo.owner          = "";
 	_lowestPriorityInfo.smooth_cfg	   = 0;
 
-	_activeInputs[PriorityMuxer::LOWEST_PRIORITY] = _lowestPriorityInfo;
+	_inputs[PriorityMuxer::LOWEST_PRIORITY] = _lowestPriorityInfo;
+	_registered.set(PriorityMuxer::LOWEST_PRIORITY);
+	_deadlines.reserve(PRIORITY_SLOTS);
 }
 
 PriorityMuxer::~PriorityMuxer()
@@ -54,6 +77,11 @@ PriorityMuxer::~PriorityMuxer()
 	TRACK_SCOPE_SUBCOMPONENT();
 }
 
+int64_t PriorityMuxer::currentTime_ms()
+{
+	return LatencyMetrics::monotonicTime_ns() / 1000000;
+}
+
 void PriorityMuxer::start()
 {
 	Info(_log, "Priority-Muxer starting...");
@@ -61,18 +89,16 @@ void PriorityMuxer::start()
 	// adapt to 1s interval for COLOR and EFFECT timeouts > -1 (endless)
 	_timer.reset(new QTimer());
 	connect(_timer.get(), &QTimer::timeout, this, &PriorityMuxer::timeTrigger);
-	_timer->setSingleShot(true);
-
-	_blockTimer.reset(new QTimer());
-	_blockTimer->setSingleShot(true);
+	_timer->setInterval(COUNTDOWN_INTERVAL_MS);
 
-	connect(this, &PriorityMuxer::signalTimeTrigger, this, &PriorityMuxer::timeTrigger);
-
-	// start muxer timer
+	// start muxer timer, woken up at the next deadline
 	_updateTimer.reset(new QTimer());
 	connect(_updateTimer.get(), &QTimer::timeout, this, &PriorityMuxer::updatePriorities);
-	_updateTimer->setInterval(250);
-	_updateTimer->start();
+	_updateTimer->setSingleShot(true);
+	_updateTimer->setTimerType(Qt::PreciseTimer);
+
+	_isUpdateEnabled = true;
+	updatePriorities();
 }
 
 void PriorityMuxer::stop()
@@ -81,15 +107,22 @@ void PriorityMuxer::stop()
 
 	setEnable(false);
 	_timer->stop();
-	_blockTimer->stop();
-	_updateTimer->stop();
 
 	Info(_log, "Priority-Muxer stopped");
 }
 
 void PriorityMuxer::setEnable(bool enable)
 {
-	enable ? _updateTimer->start() : _updateTimer->stop();
+	_isUpdateEnabled = enable;
+	if (enable)
+	{
+		// catch up on the deadlines passed while disabled
+		updatePriorities();
+	}
+	else if (!_updateTimer.isNull())
+	{
+		_updateTimer->stop();
+	}
 }
 
 bool PriorityMuxer::setSourceAutoSelectEnabled(bool enable, bool update)
@@ -97,7 +130,7 @@ bool PriorityMuxer::setSourceAutoSelectEnabled(bool enable, bool update)
 	if(_sourceAutoSelectEnabled != enable)
 	{
 		// on disable we need to make sure the last priority call to setPriority is still valid
-		if(!enable && !_activeInputs.contains(_manualSelectedPriority))
+		if(!enable && !isRegistered(_manualSelectedPriority))
 		{
 			Warning(_log, "Can't disable auto selection, as the last manual selected priority (%d) is no longer available", _manualSelectedPriority);
 			return false;
@@ -109,7 +142,7 @@ bool PriorityMuxer::setSourceAutoSelectEnabled(bool enable, bool update)
 		// update _currentPriority if called from external
 		if(update)
 		{
-			emit prioritiesChanged(_currentPriority,_activeInputs);
+			emit prioritiesChanged(_currentPriority, getInputInfo());
 		}
 
 		return true;
@@ -119,7 +152,7 @@ bool PriorityMuxer::setSourceAutoSelectEnabled(bool enable, bool update)
 
 bool PriorityMuxer::setPriority(int priority)
 {
-	if(_activeInputs.contains(priority))
+	if(isRegistered(priority))
 	{
 		_manualSelectedPriority = priority;
 		// update auto select state -> update _currentPriority
@@ -131,58 +164,77 @@ bool PriorityMuxer::setPriority(int priority)
 
 void PriorityMuxer::updateLedColorsLength(int ledCount)
 {
-	for (auto infoIt = _activeInputs.begin(); infoIt != _activeInputs.end();)
+	for (int priority = 0; priority < PRIORITY_SLOTS; ++priority)
 	{
-		if (!infoIt->ledColors.empty())
+		InputInfo& input = _inputs[priority];
+		if (_registered.test(priority) && !input.ledColors.empty())
 		{
-			infoIt->ledColors.fill(infoIt->ledColors.at(0), ledCount);
+			input.ledColors.fill(input.ledColors.at(0), ledCount);
 		}
-		++infoIt;
 	}
 
 	if (_lowestPriorityInfo.ledColors.size() != static_cast<qsizetype>(ledCount))
 	{
 		_lowestPriorityInfo.ledColors.fill(ColorRgb::BLACK, ledCount);
-		_activeInputs[PriorityMuxer::LOWEST_PRIORITY].ledColors = _lowestPriorityInfo.ledColors;
+		_inputs[PriorityMuxer::LOWEST_PRIORITY].ledColors = _lowestPriorityInfo.ledColors;
 	}
 }
 
 QList<int> PriorityMuxer::getPriorities() const
 {
-	return _activeInputs.keys();
+	QList<int> priorities;
+	for (int priority = 0; priority < PRIORITY_SLOTS; ++priority)
+	{
+		if (_registered.test(priority))
+		{
+			priorities.append(priority);
+		}
+	}
+	return priorities;
 }
 
 bool PriorityMuxer::hasPriority(int priority) const
 {
-	return (priority == PriorityMuxer::LOWEST_PRIORITY) ? true : _activeInputs.contains(priority);
+	return (priority == PriorityMuxer::LOWEST_PRIORITY) ? true : isRegistered(priority);
 }
 
-PriorityMuxer::InputsMap PriorityMuxer::getInputInfo() const
+bool PriorityMuxer::isRegistered(int priority) const
 {
-    return _activeInputs;
+	return priority >= 0 && priority < PRIORITY_SLOTS && _registered.test(priority);
 }
 
-PriorityMuxer::InputInfo PriorityMuxer::getInputInfo(int priority) const
+PriorityMuxer::InputsMap PriorityMuxer::getInputInfo() const
 {
-	auto elemIt = _activeInputs.constFind(priority);
-	if (elemIt == _activeInputs.end())
+	InputsMap inputs;
+	for (int priority = 0; priority < PRIORITY_SLOTS; ++priority)
 	{
-		elemIt = _activeInputs.constFind(PriorityMuxer::LOWEST_PRIORITY);
-		if (elemIt == _activeInputs.end())
+		if (_registered.test(priority))
 		{
-			// fallback
-			return _lowestPriorityInfo;
+			inputs.insert(priority, _inputs[priority]);
 		}
 	}
-	return elemIt.value();
+	return inputs;
+}
+
+const PriorityMuxer::InputInfo& PriorityMuxer::getInputInfo(int priority) const
+{
+	if (isRegistered(priority))
+	{
+		return _inputs[priority];
+	}
+	if (_registered.test(PriorityMuxer::LOWEST_PRIORITY))
+	{
+		return _inputs[PriorityMuxer::LOWEST_PRIORITY];
+	}
+	// fallback
+	return _lowestPriorityInfo;
 }
 
 hyperion::Components PriorityMuxer::getComponentOfPriority(int priority) const
 {
-	auto it = _activeInputs.constFind(priority);
-	if (it != _activeInputs.constEnd())
+	if (isRegistered(priority))
 	{
-		return it->componentId;
+		return _inputs[priority].componentId;
 	}
 	else
 	{
@@ -190,28 +242,64 @@ hyperion::Components PriorityMuxer::getComponentOfPriority(int priority) const
 	}
 }
 
+void PriorityMuxer::setTimeout(int priority, int64_t timeout_ms)
+{
+	_inputs[priority].timeoutTime_ms = timeout_ms;
+
+	if (!_timer.isNull() && !_timer->isActive() && isCountingDown(_inputs[priority]))
+	{
+		_timer->start();
+	}
+
+	// An extended timeout is rescheduled when the earlier deadline is due, only earlier deadlines are added
+	int64_t& scheduled = _scheduledTimeout_ms[priority];
+	if (timeout_ms > 0 && (scheduled == 0 || timeout_ms < scheduled))
+	{
+		scheduled = timeout_ms;
+		_deadlines.push_back({timeout_ms, priority});
+		std::push_heap(_deadlines.begin(), _deadlines.end(), std::greater<>());
+		if (_deadlines.front().time_ms == timeout_ms)
+		{
+			scheduleUpdate();
+		}
+	}
+}
+
+void PriorityMuxer::removeInput(int priority)
+{
+	_inputs[priority] = InputInfo();
+	_registered.reset(priority);
+	_scheduledTimeout_ms[priority] = 0;
+}
+
 void PriorityMuxer::registerInput(int priority, hyperion::Components component, const QString& origin, const QString& owner, unsigned smooth_cfg)
 {
 	TRACK_SCOPE_SUBCOMPONENT() << "Priority:" << priority << ",component:" << hyperion::componentToIdString(component) << ",origin:" << origin << ",owner:" << owner << ",smooth_cfg:" << smooth_cfg;
+	if (priority < 0 || priority > PriorityMuxer::LOWEST_PRIORITY)
+	{
+		Error(_log,"Cannot register input '%s/%s' with invalid priority %d", QSTRING_CSTR(origin), hyperion::componentToIdString(component), priority);
+		return;
+	}
+
 	// detect new registers
 	bool newInput = false;
 
-	if (!_activeInputs.contains(priority))
+	if (!_registered.test(priority))
 	{
 		newInput = true;
 	}
-	else if(_prevVisComp == component || _activeInputs[priority].componentId == component)
+	else if(_prevVisComp == component || _inputs[priority].componentId == component)
 	{
-		if (_activeInputs[priority].owner != owner)
+		if (_inputs[priority].owner != owner)
 		{
 			newInput = true;
 		}
 	}
 
 	TRACK_SCOPE_SUBCOMPONENT() << "Priority:" << priority << ",component:" << hyperion::componentToIdString(component) << ",origin:" << origin << ",owner:" << owner << ",smooth_cfg:" << smooth_cfg << ",newInput:" << newInput;
-	InputInfo& input     = _activeInputs[priority];
+	_registered.set(priority);
+	InputInfo& input     = _inputs[priority];
 	input.priority       = priority;
-	input.timeoutTime_ms = newInput ? TIMEOUT_NOT_ACTIVE_PRIO : input.timeoutTime_ms;
 	input.componentId    = component;
 	input.origin         = origin;
 	input.smooth_cfg     = smooth_cfg;
@@ -219,6 +307,7 @@ void PriorityMuxer::registerInput(int priority, hyperion::Components component,
 
 	if (newInput)
 	{
+		setTimeout(priority, TIMEOUT_NOT_ACTIVE_PRIO);
 		Debug(_log,"Register new input '%s/%s' (%s) with priority %d as inactive", QSTRING_CSTR(origin), hyperion::componentToIdString(component), QSTRING_CSTR(owner), priority);
 	}
 	else
@@ -229,13 +318,13 @@ void PriorityMuxer::registerInput(int priority, hyperion::Components component,
 
 bool PriorityMuxer::setInput(int priority, const QVector<ColorRgb>& ledColors, int64_t timeout_ms)
 {
-	if(!_activeInputs.contains(priority))
+	if(!isRegistered(priority))
 	{
 		Error(_log,"setInput() used without registerInput() for priority '%d', probably the priority reached timeout",priority);
 		return false;
 	}
 
-	InputInfo& input = _activeInputs[priority];
+	InputInfo& input = _inputs[priority];
 	// detect active <-> inactive changes
 	bool activeChange = false;
 	bool active = true;
@@ -243,11 +332,11 @@ bool PriorityMuxer::setInput(int priority, const QVector<ColorRgb>& ledColors, i
 	// calculate final timeout
 	if (timeout_ms >= 0)
 	{
-		timeout_ms = QDateTime::currentMSecsSinceEpoch() + timeout_ms;
+		timeout_ms = currentTime_ms() + timeout_ms;
 	}
 	else if (input.timeoutTime_ms >= 0)
 	{
-		timeout_ms = QDateTime::currentMSecsSinceEpoch();
+		timeout_ms = currentTime_ms();
 	}
 
 	if(input.timeoutTime_ms == TIMEOUT_NOT_ACTIVE_PRIO && timeout_ms != TIMEOUT_NOT_ACTIVE_PRIO)
@@ -274,9 +363,10 @@ bool PriorityMuxer::setInput(int priority, const QVector<ColorRgb>& ledColors, i
 	}
 
 	// update input
-	input.timeoutTime_ms = timeout_ms;
+	setTimeout(priority, timeout_ms);
 	input.ledColors      = ledColors;
 	input.image.reset();
+	input.captureTime_ns = LatencyMetrics::monotonicTime_ns();
 
 	// emit active change
 	if(activeChange)
@@ -284,7 +374,7 @@ bool PriorityMuxer::setInput(int priority, const QVector<ColorRgb>& ledColors, i
 		if (_currentPriority <= priority || !_sourceAutoSelectEnabled)
 		{
 			Debug(_log, "Priority %d is now %s", priority, active ? "active" : "inactive");
-			emit prioritiesChanged(_currentPriority,_activeInputs);
+			emit prioritiesChanged(_currentPriority, getInputInfo());
 		}
 		updatePriorities();
 	}
@@ -295,13 +385,13 @@ bool PriorityMuxer::setInput(int priority, const QVector<ColorRgb>& ledColors, i
 bool PriorityMuxer::setInputImage(int priority, const Image<ColorRgb>& image, int64_t timeout_ms)
 {
 	qCDebug(image_track) << "Image [" << image.id() << "], Priority:" << priority << ",timeout:" << timeout_ms << "ms";
-	if(!_activeInputs.contains(priority))
+	if(!isRegistered(priority))
 	{
 		Error(_log,"setInputImage() used without registerInput() for priority '%d', probably the priority reached timeout",priority);
 		return false;
 	}
 
-	InputInfo& input = _activeInputs[priority];
+	InputInfo& input = _inputs[priority];
 	// detect active <-> inactive changes
 	bool activeChange = false;
 	bool active = true;
@@ -309,11 +399,11 @@ bool PriorityMuxer::setInputImage(int priority, const Image<ColorRgb>& image, in
 	// calculate final timeout
 	if (timeout_ms >= 0)
 	{
-		timeout_ms = QDateTime::currentMSecsSinceEpoch() + timeout_ms;
+		timeout_ms = currentTime_ms() + timeout_ms;
 	}
 	else if (input.timeoutTime_ms >= 0)
 	{
-		timeout_ms = QDateTime::currentMSecsSinceEpoch();
+		timeout_ms = currentTime_ms();
 	}
 
 	if(input.timeoutTime_ms == TIMEOUT_NOT_ACTIVE_PRIO && timeout_ms != TIMEOUT_NOT_ACTIVE_PRIO)
@@ -326,9 +416,11 @@ bool PriorityMuxer::setInputImage(int priority, const Image<ColorRgb>& image, in
 		activeChange = true;
 	}
 	// update input
-	input.timeoutTime_ms = timeout_ms;
+	setTimeout(priority, timeout_ms);
 	input.image          = image;
 	input.ledColors.clear();
+	// Images not stamped by their source are timed from here
+	input.captureTime_ns = image.captureTime() > 0 ? image.captureTime() : LatencyMetrics::monotonicTime_ns();
 
 	qCDebug(image_track) << "Image [" << image.id() << "] assigned to priority:" << priority << ",timeout:" << timeout_ms << "ms";
 	// emit active change
@@ -337,7 +429,7 @@ bool PriorityMuxer::setInputImage(int priority, const Image<ColorRgb>& image, in
 		if (_currentPriority <= priority || !_sourceAutoSelectEnabled)
 		{
 			Debug(_log, "Priority %d is now %s", priority, active ? "active" : "inactive");
-			emit prioritiesChanged(_currentPriority,_activeInputs);
+			emit prioritiesChanged(_currentPriority, getInputInfo());
 		}
 		updatePriorities();
 	}
@@ -354,9 +446,14 @@ bool PriorityMuxer::setInputInactive(int priority)
 
 bool PriorityMuxer::clearInput(int priority)
 {
-	if (priority < PriorityMuxer::LOWEST_PRIORITY)
+	if (priority >= 0 && priority < PriorityMuxer::LOWEST_PRIORITY)
 	{
-		_activeInputs[priority].timeoutTime_ms = REMOVE_CLEARED_PRIO;
+		if (_registered.test(priority))
+		{
+			setTimeout(priority, REMOVE_CLEARED_PRIO);
+			_hasClearedInputs = true;
+			scheduleUpdate();
+		}
 		return true;
 	}
 	return false;
@@ -367,19 +464,28 @@ void PriorityMuxer::clearAll(bool forceClearAll)
 	if (forceClearAll)
 	{
 		_previousPriority = _currentPriority;
-		_activeInputs.clear();
+		for (int priority = 0; priority < PRIORITY_SLOTS; ++priority)
+		{
+			if (_registered.test(priority))
+			{
+				removeInput(priority);
+			}
+		}
+		_deadlines.clear();
+		_hasClearedInputs = false;
 		_currentPriority = PriorityMuxer::LOWEST_PRIORITY;
-		_activeInputs[_currentPriority] = _lowestPriorityInfo;
+		_inputs[_currentPriority] = _lowestPriorityInfo;
+		_registered.set(_currentPriority);
 		updatePriorities();
 	}
 	else
 	{
-		for(auto key : _activeInputs.keys())
+		for (int priority = 0; priority < PriorityMuxer::LOWEST_PRIORITY - 1; ++priority)
 		{
-			const InputInfo info = getInputInfo(key);
-			if ((info.componentId == hyperion::COMP_COLOR || info.componentId == hyperion::COMP_EFFECT || info.componentId == hyperion::COMP_IMAGE) && key < PriorityMuxer::LOWEST_PRIORITY-1)
+			const hyperion::Components componentId = _inputs[priority].componentId;
+			if (_registered.test(priority) && (componentId == hyperion::COMP_COLOR || componentId == hyperion::COMP_EFFECT || componentId == hyperion::COMP_IMAGE))
 			{
-				clearInput(key);
+				clearInput(priority);
 			}
 		}
 	}
@@ -387,69 +493,68 @@ void PriorityMuxer::clearAll(bool forceClearAll)
 
 void PriorityMuxer::updatePriorities()
 {
-	const int64_t now = QDateTime::currentMSecsSinceEpoch();
-	int newPriority;
+	const int64_t now = currentTime_ms();
 	bool priorityChanged {false};
 
-	_activeInputs.contains(0) ? newPriority = 0 : newPriority = PriorityMuxer::LOWEST_PRIORITY;
+	if (_hasClearedInputs)
+	{
+		_hasClearedInputs = false;
+		for (int priority = 0; priority < PRIORITY_SLOTS; ++priority)
+		{
+			if (_registered.test(priority) && _inputs[priority].timeoutTime_ms == REMOVE_CLEARED_PRIO)
+			{
+				removeInput(priority);
 
-	bool timeElapsed {false};
-	QMutableMapIterator<int, PriorityMuxer::InputInfo> i(_activeInputs);
-	while (i.hasNext()) {
-		i.next();
+				Debug(_log,"Removed source priority %d", priority);
+				priorityChanged = true;
+			}
+		}
+	}
+
+	while (!_deadlines.empty() && _deadlines.front().time_ms <= now)
+	{
+		std::pop_heap(_deadlines.begin(), _deadlines.end(), std::greater<>());
+		const Deadline deadline = _deadlines.back();
+		_deadlines.pop_back();
 
-		if ( i.value().timeoutTime_ms == REMOVE_CLEARED_PRIO )
+		// skip outdated deadlines, the channel's timeout was changed or it was removed
+		int64_t& scheduled = _scheduledTimeout_ms[deadline.priority];
+		if (scheduled != deadline.time_ms)
 		{
-			int tPrio = i.value().priority;
-			i.remove();
+			continue;
+		}
+		scheduled = 0;
 
-			Debug(_log,"Removed source priority %d", tPrio);
-			priorityChanged = true;
+		const int64_t timeout_ms = _inputs[deadline.priority].timeoutTime_ms;
+		if (timeout_ms > now)
+		{
+			// extended in the meantime
+			setTimeout(deadline.priority, timeout_ms);
 		}
-		else
+		else if (timeout_ms > 0)
 		{
-			if (i.value().timeoutTime_ms > 0 && i.value().timeoutTime_ms <= now)
-			{
-				//Stop timer for deleted items to avoid additional priority update
-				_timer->stop();
-				int tPrio = i.value().priority;
-				i.remove();
+			removeInput(deadline.priority);
 
-				Debug(_log,"Timeout clear for priority %d",tPrio);
-				priorityChanged = true;
-			}
-			else
-			{
-				// timeoutTime of TIMEOUT_NOT_ACTIVE_PRIO is awaiting data (inactive); skip
-				if(i.value().timeoutTime_ms > TIMEOUT_NOT_ACTIVE_PRIO)
-				{
-					newPriority = qMin(newPriority, i.value().priority);
-				}
-
-				// call timeTrigger when effect or color is running with timeout > 0, blacklist prio 255
-				if (i.value().priority < BG_PRIORITY &&
-					 i.value().timeoutTime_ms > 0 &&
-					 ( i.value().componentId == hyperion::COMP_EFFECT ||
-					   i.value().componentId == hyperion::COMP_COLOR ||
-					   (i.value().componentId == hyperion::COMP_IMAGE && i.value().owner != "Streaming")
-					   )
-					 )
-				{
-					timeElapsed = true;
-				}
-			}
+			Debug(_log,"Timeout clear for priority %d", deadline.priority);
+			priorityChanged = true;
 		}
 	}
 
-	if (timeElapsed)
+	// timeoutTime of TIMEOUT_NOT_ACTIVE_PRIO is awaiting data (inactive); skip
+	int newPriority = _registered.test(0) ? 0 : PriorityMuxer::LOWEST_PRIORITY;
+	for (int priority = 1; priority < newPriority; ++priority)
 	{
-		emit signalTimeTrigger(); // signal to prevent Threading issues
+		if (_registered.test(priority) && _inputs[priority].timeoutTime_ms > TIMEOUT_NOT_ACTIVE_PRIO)
+		{
+			newPriority = priority;
+			break;
+		}
 	}
 
 	// evaluate, if manual selected priority is still available
 	if(!_sourceAutoSelectEnabled)
 	{
-		if(_activeInputs.contains(_manualSelectedPriority))
+		if(isRegistered(_manualSelectedPriority))
 		{
 			newPriority = _manualSelectedPriority;
 		}
@@ -479,19 +584,60 @@ void PriorityMuxer::updatePriorities()
 
 	if (priorityChanged)
 	{
-		emit prioritiesChanged(_currentPriority,_activeInputs);
+		emit prioritiesChanged(_currentPriority, getInputInfo());
 	}
+
+	updateCountdown();
+	scheduleUpdate();
 }
 
-void PriorityMuxer::timeTrigger()
+void PriorityMuxer::scheduleUpdate()
 {
-	if(_blockTimer->isActive())
+	if (_updateTimer.isNull() || !_isUpdateEnabled)
+	{
+		return;
+	}
+
+	if (_hasClearedInputs)
+	{
+		_updateTimer->start(0);
+	}
+	else if (!_deadlines.empty())
 	{
-		_timer->start(500);
+		const int64_t remaining_ms = std::max<int64_t>(_deadlines.front().time_ms - currentTime_ms(), 0);
+		_updateTimer->start(static_cast<int>(std::min<int64_t>(remaining_ms, std::numeric_limits<int>::max())));
 	}
 	else
 	{
-		_blockTimer->start(1000);
-		emit prioritiesChanged(_currentPriority,_activeInputs);
+		_updateTimer->stop();
+	}
+}
+
+void PriorityMuxer::updateCountdown()
+{
+	if (_timer.isNull())
+	{
+		return;
 	}
+
+	bool isAnyCountingDown {false};
+	for (int priority = 0; priority < BG_PRIORITY && !isAnyCountingDown; ++priority)
+	{
+		isAnyCountingDown = _registered.test(priority) && isCountingDown(_inputs[priority]);
+	}
+
+	if (!isAnyCountingDown)
+	{
+		_timer->stop();
+	}
+	else if (!_timer->isActive())
+	{
+		_timer->start();
+	}
+}
+
+void PriorityMuxer::timeTrigger()
+{
+	updateCountdown();
+	emit prioritiesChanged(_currentPriority, getInputInfo());
 }
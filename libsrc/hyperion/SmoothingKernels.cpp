@@ -0,0 +1,317 @@
+#include <hyperion/SmoothingKernels.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__))
+#define KERNELS_X86
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace hyperion;
+using namespace hyperion::smoothing;
+
+namespace {
+
+/// Added before the fraction bits are shifted out to round to nearest
+constexpr uint32_t FIXED_HALF = FIXED_ONE >> 1;
+
+/// Added before the fraction bits of a step are shifted out to round up
+constexpr uint32_t STEP_ROUND_UP = (1U << STEP_FRACTION_BITS) - 1;
+
+void accumulateScalar(const uint8_t* components, int count, uint32_t weight, uint32_t* sums)
+{
+	for (int i = 0; i < count; ++i)
+	{
+		sums[i] += weight * components[i];
+	}
+}
+
+void assembleScalar(const uint32_t* means, int count, uint8_t* components)
+{
+	for (int i = 0; i < count; ++i)
+	{
+		components[i] = static_cast<uint8_t>(std::min((means[i] + FIXED_HALF) >> FRACTION_BITS, 255U));
+	}
+}
+
+void ditherScalar(const uint32_t* means, int32_t* residuals, int count, uint8_t* components)
+{
+	for (int i = 0; i < count; ++i)
+	{
+		const int32_t value = static_cast<int32_t>(means[i]) + residuals[i];
+		const int32_t rounded = std::min(std::max((value + static_cast<int32_t>(FIXED_HALF)) >> FRACTION_BITS, 0), 255);
+		components[i] = static_cast<uint8_t>(rounded);
+		residuals[i] = value - rounded * static_cast<int32_t>(FIXED_ONE);
+	}
+}
+
+void stepScalar(const uint8_t* target, int count, uint32_t factor, uint8_t* components)
+{
+	for (int i = 0; i < count; ++i)
+	{
+		const int difference = target[i] - components[i];
+		const uint32_t step = (factor * static_cast<uint32_t>(std::abs(difference)) + STEP_ROUND_UP) >> STEP_FRACTION_BITS;
+		components[i] = static_cast<uint8_t>(difference < 0 ? components[i] - step : components[i] + step);
+	}
+}
+
+#ifdef KERNELS_X86
+
+// 16 components per iteration, the remainder is handled by the scalar kernels.
+// SSE2 lacks a 32bit multiplication, the weight (at most 2^22) is therefore split into 16bit halves.
+void accumulateSse2(const uint8_t* components, int count, uint32_t weight, uint32_t* sums)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i weightLow = _mm_set1_epi16(static_cast<int16_t>(weight & 0xFFFF));
+	const __m128i weightHigh = _mm_set1_epi16(static_cast<int16_t>(weight >> 16));
+
+	int i = 0;
+	for (; i + 16 <= count; i += 16)
+	{
+		const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(components + i));
+		const __m128i words[2] = { _mm_unpacklo_epi8(bytes, zero), _mm_unpackhi_epi8(bytes, zero) };
+		for (int half = 0; half < 2; ++half)
+		{
+			// product = low + (high << 16), the upper half stays below 2^15
+			const __m128i low = _mm_mullo_epi16(words[half], weightLow);
+			const __m128i high = _mm_add_epi16(_mm_mulhi_epu16(words[half], weightLow), _mm_mullo_epi16(words[half], weightHigh));
+
+			__m128i* sum = reinterpret_cast<__m128i*>(sums + i + half * 8);
+			_mm_storeu_si128(sum, _mm_add_epi32(_mm_loadu_si128(sum), _mm_unpacklo_epi16(low, high)));
+			_mm_storeu_si128(sum + 1, _mm_add_epi32(_mm_loadu_si128(sum + 1), _mm_unpackhi_epi16(low, high)));
+		}
+	}
+	accumulateScalar(components + i, count - i, weight, sums + i);
+}
+
+void assembleSse2(const uint32_t* means, int count, uint8_t* components)
+{
+	const __m128i half = _mm_set1_epi32(static_cast<int32_t>(FIXED_HALF));
+
+	int i = 0;
+	for (; i + 16 <= count; i += 16)
+	{
+		__m128i rounded[4];
+		for (int lane = 0; lane < 4; ++lane)
+		{
+			const __m128i mean = _mm_loadu_si128(reinterpret_cast<const __m128i*>(means + i + lane * 4));
+			rounded[lane] = _mm_srli_epi32(_mm_add_epi32(mean, half), FRACTION_BITS);
+		}
+		// the unsigned saturation clamps to 255
+		const __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(rounded[0], rounded[1]), _mm_packs_epi32(rounded[2], rounded[3]));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(components + i), bytes);
+	}
+	assembleScalar(means + i, count - i, components + i);
+}
+
+void ditherSse2(const uint32_t* means, int32_t* residuals, int count, uint8_t* components)
+{
+	const __m128i half = _mm_set1_epi32(static_cast<int32_t>(FIXED_HALF));
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i max = _mm_set1_epi16(255);
+
+	int i = 0;
+	for (; i + 16 <= count; i += 16)
+	{
+		__m128i values[4];
+		__m128i rounded[4];
+		for (int lane = 0; lane < 4; ++lane)
+		{
+			const __m128i mean = _mm_loadu_si128(reinterpret_cast<const __m128i*>(means + i + lane * 4));
+			const __m128i residual = _mm_loadu_si128(reinterpret_cast<const __m128i*>(residuals + i + lane * 4));
+			values[lane] = _mm_add_epi32(mean, residual);
+			rounded[lane] = _mm_srai_epi32(_mm_add_epi32(values[lane], half), FRACTION_BITS);
+		}
+
+		const __m128i words[2] = {
+			_mm_min_epi16(_mm_max_epi16(_mm_packs_epi32(rounded[0], rounded[1]), zero), max),
+			_mm_min_epi16(_mm_max_epi16(_mm_packs_epi32(rounded[2], rounded[3]), zero), max)
+		};
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(components + i), _mm_packus_epi16(words[0], words[1]));
+
+		for (int lane = 0; lane < 4; ++lane)
+		{
+			const __m128i clamped = (lane & 1) == 0 ? _mm_unpacklo_epi16(words[lane >> 1], zero) : _mm_unpackhi_epi16(words[lane >> 1], zero);
+			const __m128i residual = _mm_sub_epi32(values[lane], _mm_slli_epi32(clamped, FRACTION_BITS));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(residuals + i + lane * 4), residual);
+		}
+	}
+	ditherScalar(means + i, residuals + i, count - i, components + i);
+}
+
+void stepSse2(const uint8_t* target, int count, uint32_t factor, uint8_t* components)
+{
+	if (factor >= (1U << STEP_FRACTION_BITS))
+	{
+		std::memcpy(components, target, static_cast<size_t>(count));
+		return;
+	}
+
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i one = _mm_set1_epi16(1);
+	const __m128i fraction = _mm_set1_epi16(static_cast<int16_t>(factor));
+
+	int i = 0;
+	for (; i + 16 <= count; i += 16)
+	{
+		const __m128i targets = _mm_loadu_si128(reinterpret_cast<const __m128i*>(target + i));
+		const __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(components + i));
+		const __m128i up = _mm_subs_epu8(targets, current);
+		const __m128i down = _mm_subs_epu8(current, targets);
+		const __m128i difference = _mm_or_si128(up, down);
+
+		// step = ceil(factor * difference), i.e. the upper half of the product plus one for a non zero lower half
+		__m128i steps[2];
+		for (int half = 0; half < 2; ++half)
+		{
+			const __m128i words = half == 0 ? _mm_unpacklo_epi8(difference, zero) : _mm_unpackhi_epi8(difference, zero);
+			const __m128i isExact = _mm_cmpeq_epi16(_mm_mullo_epi16(words, fraction), zero);
+			steps[half] = _mm_add_epi16(_mm_mulhi_epu16(words, fraction), _mm_andnot_si128(isExact, one));
+		}
+		const __m128i step = _mm_packus_epi16(steps[0], steps[1]);
+
+		// the step does not exceed the difference, only one of up and down is non zero
+		const __m128i moved = _mm_sub_epi8(_mm_add_epi8(current, _mm_min_epu8(step, up)), _mm_min_epu8(step, down));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(components + i), moved);
+	}
+	stepScalar(target + i, count - i, factor, components + i);
+}
+
+#endif // KERNELS_X86
+
+#ifdef KERNELS_NEON
+
+void accumulateNeon(const uint8_t* components, int count, uint32_t weight, uint32_t* sums)
+{
+	int i = 0;
+	for (; i + 16 <= count; i += 16)
+	{
+		const uint8x16_t bytes = vld1q_u8(components + i);
+		const uint16x8_t words[2] = { vmovl_u8(vget_low_u8(bytes)), vmovl_u8(vget_high_u8(bytes)) };
+		for (int half = 0; half < 2; ++half)
+		{
+			uint32_t* sum = sums + i + half * 8;
+			vst1q_u32(sum, vmlaq_n_u32(vld1q_u32(sum), vmovl_u16(vget_low_u16(words[half])), weight));
+			vst1q_u32(sum + 4, vmlaq_n_u32(vld1q_u32(sum + 4), vmovl_u16(vget_high_u16(words[half])), weight));
+		}
+	}
+	accumulateScalar(components + i, count - i, weight, sums + i);
+}
+
+void assembleNeon(const uint32_t* means, int count, uint8_t* components)
+{
+	const uint32x4_t half = vdupq_n_u32(FIXED_HALF);
+
+	int i = 0;
+	for (; i + 16 <= count; i += 16)
+	{
+		uint16x4_t rounded[4];
+		for (int lane = 0; lane < 4; ++lane)
+		{
+			rounded[lane] = vqmovn_u32(vshrq_n_u32(vaddq_u32(vld1q_u32(means + i + lane * 4), half), FRACTION_BITS));
+		}
+		const uint8x8_t low = vqmovn_u16(vcombine_u16(rounded[0], rounded[1]));
+		const uint8x8_t high = vqmovn_u16(vcombine_u16(rounded[2], rounded[3]));
+		vst1q_u8(components + i, vcombine_u8(low, high));
+	}
+	assembleScalar(means + i, count - i, components + i);
+}
+
+void ditherNeon(const uint32_t* means, int32_t* residuals, int count, uint8_t* components)
+{
+	const int32x4_t half = vdupq_n_s32(static_cast<int32_t>(FIXED_HALF));
+	const int32x4_t zero = vdupq_n_s32(0);
+	const int32x4_t max = vdupq_n_s32(255);
+
+	int i = 0;
+	for (; i + 16 <= count; i += 16)
+	{
+		uint16x4_t rounded[4];
+		for (int lane = 0; lane < 4; ++lane)
+		{
+			const int32x4_t value = vaddq_s32(vreinterpretq_s32_u32(vld1q_u32(means + i + lane * 4)), vld1q_s32(residuals + i + lane * 4));
+			const int32x4_t clamped = vminq_s32(vmaxq_s32(vshrq_n_s32(vaddq_s32(value, half), FRACTION_BITS), zero), max);
+			vst1q_s32(residuals + i + lane * 4, vsubq_s32(value, vshlq_n_s32(clamped, FRACTION_BITS)));
+			rounded[lane] = vqmovun_s32(clamped);
+		}
+		const uint8x8_t low = vqmovn_u16(vcombine_u16(rounded[0], rounded[1]));
+		const uint8x8_t high = vqmovn_u16(vcombine_u16(rounded[2], rounded[3]));
+		vst1q_u8(components + i, vcombine_u8(low, high));
+	}
+	ditherScalar(means + i, residuals + i, count - i, components + i);
+}
+
+void stepNeon(const uint8_t* target, int count, uint32_t factor, uint8_t* components)
+{
+	if (factor >= (1U << STEP_FRACTION_BITS))
+	{
+		std::memcpy(components, target, static_cast<size_t>(count));
+		return;
+	}
+
+	const uint16x4_t fraction = vdup_n_u16(static_cast<uint16_t>(factor));
+	const uint32x4_t roundUp = vdupq_n_u32(STEP_ROUND_UP);
+
+	int i = 0;
+	for (; i + 16 <= count; i += 16)
+	{
+		const uint8x16_t targets = vld1q_u8(target + i);
+		const uint8x16_t current = vld1q_u8(components + i);
+		const uint8x16_t difference = vabdq_u8(targets, current);
+
+		const uint16x8_t words[2] = { vmovl_u8(vget_low_u8(difference)), vmovl_u8(vget_high_u8(difference)) };
+		uint16x4_t steps[4];
+		for (int quarter = 0; quarter < 4; ++quarter)
+		{
+			const uint16x4_t part = (quarter & 1) == 0 ? vget_low_u16(words[quarter >> 1]) : vget_high_u16(words[quarter >> 1]);
+			steps[quarter] = vmovn_u32(vshrq_n_u32(vaddq_u32(vmull_u16(part, fraction), roundUp), STEP_FRACTION_BITS));
+		}
+		const uint8x16_t step = vcombine_u8(vmovn_u16(vcombine_u16(steps[0], steps[1])), vmovn_u16(vcombine_u16(steps[2], steps[3])));
+
+		// the step does not exceed the difference, only one of up and down is non zero
+		const uint8x16_t up = vminq_u8(step, vqsubq_u8(targets, current));
+		const uint8x16_t down = vminq_u8(step, vqsubq_u8(current, targets));
+		vst1q_u8(components + i, vsubq_u8(vaddq_u8(current, up), down));
+	}
+	stepScalar(target + i, count - i, factor, components + i);
+}
+
+#endif // KERNELS_NEON
+
+const SmoothingKernels SCALAR_KERNELS {"scalar", &accumulateScalar, &assembleScalar, &ditherScalar, &stepScalar};
+#ifdef KERNELS_X86
+const SmoothingKernels SSE2_KERNELS {"sse2", &accumulateSse2, &assembleSse2, &ditherSse2, &stepSse2};
+#endif
+#ifdef KERNELS_NEON
+const SmoothingKernels NEON_KERNELS {"neon", &accumulateNeon, &assembleNeon, &ditherNeon, &stepNeon};
+#endif
+
+} // namespace
+
+const SmoothingKernels& hyperion::smoothing::scalarKernels()
+{
+	return SCALAR_KERNELS;
+}
+
+QVector<const SmoothingKernels*> hyperion::smoothing::availableKernels()
+{
+	QVector<const SmoothingKernels*> available {&SCALAR_KERNELS};
+#ifdef KERNELS_X86
+	available.append(&SSE2_KERNELS);
+#endif
+#ifdef KERNELS_NEON
+	available.append(&NEON_KERNELS);
+#endif
+	return available;
+}
+
+const SmoothingKernels& hyperion::smoothing::smoothingKernels()
+{
+	static const SmoothingKernels* const selected = availableKernels().last();
+	return *selected;
+}
@@ -46,6 +46,9 @@ namespace {
 	constexpr std::chrono::seconds DEFAULT_ENABLE_ATTEMPTS_INTERVAL{ 5 };
 	constexpr std::chrono::milliseconds SWITCH_OFF_WAIT_TIMEOUT{ 5000 };
 
+	constexpr qint64 NS_PER_MS{ 1000000 };
+	constexpr std::chrono::nanoseconds WRITE_STATISTICS_INTERVAL{ std::chrono::seconds(30) };
+
 } //End of constants
 
 LedDevice::LedDevice(const QJsonObject& deviceConfig, QObject* parent)
@@ -65,7 +68,7 @@ LedDevice::LedDevice(const QJsonObject& deviceConfig, QObject* parent)
 	, _isOn(false)
 	, _isDeviceInError(false)
 	, _isDeviceRecoverable(false)
-	, _lastWriteTime(QDateTime::currentDateTime())
+	, _lastWriteTime_ns(0)
 	, _enableAttemptsTimer(nullptr)
 	, _enableAttemptTimerInterval(DEFAULT_ENABLE_ATTEMPTS_INTERVAL)
 	, _enableAttempts(0)
@@ -122,6 +125,7 @@ void LedDevice::stop()
 	this->disable();
 	waitForPendingSwitchOff();
 	this->stopRefreshTimer();
+	this->cancelLatchedUpdate();
 	Info(_log, "Stopped LedDevice '%s'", QSTRING_CSTR(_activeDeviceType));
 	emit isStopped();
 }
@@ -149,6 +153,7 @@ void LedDevice::setInError(const QString& errorMsg, bool isRecoverable)
 	_isDeviceReady = false;
 	_isEnabled = false;
 	this->stopRefreshTimer();
+	this->cancelLatchedUpdate();
 
 	if (isRecoverable)
 	{
@@ -225,6 +230,8 @@ void LedDevice::disable()
 	_isEnabled = false;
 	this->stopEnableAttemptsTimer();
 	this->stopRefreshTimer();
+	this->cancelLatchedUpdate();
+	_rateIntervalStart_ns.store(0, std::memory_order_relaxed);
 
 	switchOff();
 	close();
@@ -328,13 +335,16 @@ void LedDevice::stopEnableAttemptsTimer()
 	}
 }
 
-int LedDevice::updateLeds(const QVector<ColorRgb>& ledValues)
+int LedDevice::updateLeds(const QVector<ColorRgb>& ledValues, qint64 captureTime_ns)
 {
 	trackDevice(leddevice_write, "Update LED values on") << (_isLedUpdatePending.load() ? ", but skipping update as an LED update is pending." : "will be executed.");
+	_updatesRequested.fetch_add(1, std::memory_order_relaxed);
+
 	// Take the LED update into a shared buffer and return quickly
 	{
 		QMutexLocker locker(&_ledBufferMutex);
 		_ledUpdateBuffer = ledValues;
+		_ledUpdateCaptureTime_ns = captureTime_ns;
 	}
 
 	// If a frame processing is NOT already scheduled, schedule one.
@@ -349,17 +359,19 @@ int LedDevice::updateLeds(const QVector<ColorRgb>& ledValues)
 void LedDevice::processLedUpdate()
 {
 	QVector<ColorRgb> valuesToProcess;
+	qint64 captureTime_ns = 0;
 	{
 		QMutexLocker locker(&_ledBufferMutex);
 		valuesToProcess = _ledUpdateBuffer;
+		captureTime_ns = _ledUpdateCaptureTime_ns;
 	}
 
-	writeLedUpdate(valuesToProcess);
+	writeLedUpdate(valuesToProcess, captureTime_ns);
 
 	_isLedUpdatePending.store(false);
 }
 
-int LedDevice::writeLedUpdate(const QVector<ColorRgb>& ledValues)
+int LedDevice::writeLedUpdate(const QVector<ColorRgb>& ledValues, qint64 captureTime_ns)
 {
 	if (!_isEnabled || !_isOn || !_isDeviceReady || _isDeviceInError)
 	{
@@ -372,25 +384,117 @@ int LedDevice::writeLedUpdate(const QVector<ColorRgb>& ledValues)
 		return -1;
 	}
 
-	qint64 const elapsedTimeMs = _lastWriteTime.msecsTo(QDateTime::currentDateTime());
-	trackDevice(leddevice_write, "Writing LED values to") << QString("Time since last write: %1 ms, Latch time: %2 ms, number of LEDs: %3")
-									.arg(elapsedTimeMs)
+	const qint64 now_ns = LatencyMetrics::monotonicTime_ns();
+	const qint64 latchEnd_ns = _lastWriteTime_ns + _latchTime_ms * NS_PER_MS;
+
+	// No time since the last write to report before the first one
+	const QString sinceLastWrite = _lastWriteTime_ns > 0 ? QString("Time since last write: %1 ms, ").arg((now_ns - _lastWriteTime_ns) / NS_PER_MS) : QString();
+	trackDevice(leddevice_write, "Writing LED values to") << QString("%1Latch time: %2 ms, number of LEDs: %3")
+									.arg(sinceLastWrite)
 									.arg(_latchTime_ms)
 									.arg(ledValues.size());
 
-	if (_latchTime_ms > 0 && elapsedTimeMs < _latchTime_ms)
+	if (_latchTime_ms > 0 && now_ns < latchEnd_ns)
 	{
-		// Skip write as elapsedTime < latchTime
-		if (_isRefreshEnabled)
+		// Defer the write until the latch time expired, a newer update replaces the deferred one
+		if (_isLatchedUpdatePending)
 		{
-			//Stop timer to allow for next non-refresh update
-			this->stopRefreshTimer();
+			_updatesReplaced.fetch_add(1, std::memory_order_relaxed);
+		}
+		else
+		{
+			_updatesDeferred.fetch_add(1, std::memory_order_relaxed);
+			_isLatchedUpdatePending = true;
+
+			if (_latchTimer.isNull())
+			{
+				_latchTimer.reset(new QTimer());
+				_latchTimer->setTimerType(Qt::PreciseTimer);
+				_latchTimer->setSingleShot(true);
+				connect(_latchTimer.get(), &QTimer::timeout, this, &LedDevice::writeLatchedUpdate);
+			}
+			_latchTimer->start(static_cast<int>((latchEnd_ns - now_ns + NS_PER_MS - 1) / NS_PER_MS));
+
+			if (_isRefreshEnabled)
+			{
+				//Stop timer to allow for next non-refresh update
+				this->stopRefreshTimer();
+			}
 		}
+		_latchedLedValues = ledValues;
+		_latchedCaptureTime_ns = captureTime_ns;
+		_latchedSince_ns = now_ns;
 		return 0;
 	}
 
-	int const result = write(ledValues);
-	_lastWriteTime = QDateTime::currentDateTime();
+	// The update supersedes a deferred one
+	cancelLatchedUpdate();
+
+	return writeLedValues(ledValues, captureTime_ns, 0);
+}
+
+void LedDevice::writeLatchedUpdate()
+{
+	if (!_isLatchedUpdatePending)
+	{
+		return;
+	}
+
+	if (!_isEnabled || !_isOn || !_isDeviceReady || _isDeviceInError)
+	{
+		cancelLatchedUpdate();
+		return;
+	}
+
+	const qint64 now_ns = LatencyMetrics::monotonicTime_ns();
+	const qint64 latchEnd_ns = _lastWriteTime_ns + _latchTime_ms * NS_PER_MS;
+	if (now_ns < latchEnd_ns)
+	{
+		// Timer fired early, wait for the remainder of the latch time
+		_latchTimer->start(static_cast<int>((latchEnd_ns - now_ns + NS_PER_MS - 1) / NS_PER_MS));
+		return;
+	}
+
+	_isLatchedUpdatePending = false;
+	const QVector<ColorRgb> ledValues = std::move(_latchedLedValues);
+	writeLedValues(ledValues, _latchedCaptureTime_ns, now_ns - _latchedSince_ns);
+}
+
+void LedDevice::cancelLatchedUpdate()
+{
+	if (!_latchTimer.isNull())
+	{
+		_latchTimer->stop();
+	}
+	_isLatchedUpdatePending = false;
+	_latchedLedValues.clear();
+}
+
+int LedDevice::writeLedValues(const QVector<ColorRgb>& ledValues, qint64 captureTime_ns, qint64 latchDelay_ns)
+{
+	if (_writeLatency.isNull())
+	{
+		_writeLatency = LatencyMetrics::getInstance().histogram(LatencyMetrics::STAGE_DEVICE_WRITE, _log->getSubName(), _activeDeviceType);
+		_captureToLedLatency = LatencyMetrics::getInstance().histogram(LatencyMetrics::STAGE_CAPTURE_TO_LED, _log->getSubName(), _activeDeviceType);
+		_latchDelay = LatencyMetrics::getInstance().histogram(LatencyMetrics::STAGE_LATCH_DELAY, _log->getSubName(), _activeDeviceType);
+	}
+
+	int result = 0;
+	{
+		const LatencyTimer timer(_writeLatency.data());
+		result = write(ledValues);
+	}
+	_lastWriteTime_ns = LatencyMetrics::monotonicTime_ns();
+
+	if (result >= 0)
+	{
+		_updatesWritten.fetch_add(1, std::memory_order_relaxed);
+		_latchDelay->record(std::chrono::nanoseconds(latchDelay_ns));
+		if (captureTime_ns > 0)
+		{
+			_captureToLedLatency->record(std::chrono::nanoseconds(_lastWriteTime_ns - captureTime_ns));
+		}
+	}
 
 	// if device requires refreshing, save Led-Values and restart the timer
 	if (_isRefreshEnabled && _isEnabled)
@@ -399,9 +503,66 @@ int LedDevice::writeLedUpdate(const QVector<ColorRgb>& ledValues)
 		this->startRefreshTimer();
 	}
 
+	updateWriteRates(_lastWriteTime_ns);
+
 	return result;
 }
 
+void LedDevice::updateWriteRates(qint64 now_ns)
+{
+	const quint64 requested = _updatesRequested.load(std::memory_order_relaxed);
+	const quint64 written = _updatesWritten.load(std::memory_order_relaxed);
+	const quint64 deferred = _updatesDeferred.load(std::memory_order_relaxed);
+
+	const qint64 intervalStart_ns = _rateIntervalStart_ns.load(std::memory_order_relaxed);
+	if (intervalStart_ns > 0)
+	{
+		const qint64 elapsed_ns = now_ns - intervalStart_ns;
+		if (elapsed_ns < WRITE_STATISTICS_INTERVAL.count())
+		{
+			return;
+		}
+
+		const double elapsed_s = static_cast<double>(elapsed_ns) / 1e9;
+		const double requestedRate_hz = static_cast<double>(requested - _rateIntervalRequested) / elapsed_s;
+		const double achievedRate_hz = static_cast<double>(written - _rateIntervalWritten) / elapsed_s;
+		_requestedRate_hz.store(requestedRate_hz, std::memory_order_relaxed);
+		_achievedRate_hz.store(achievedRate_hz, std::memory_order_relaxed);
+
+		if (deferred != _rateIntervalDeferred)
+		{
+			const LatencyHistogram::Snapshot latchDelay = _latchDelay->snapshot();
+			Debug(_log, "Write rate requested [%.1f Hz], achieved [%.1f Hz], updates deferred by latch time [%llu], latch delay mean [%llu us], max [%llu us]",
+				  requestedRate_hz, achievedRate_hz, deferred - _rateIntervalDeferred,
+				  latchDelay.count > 0 ? latchDelay.sum_us / latchDelay.count : 0, latchDelay.max_us);
+		}
+	}
+
+	_rateIntervalStart_ns.store(now_ns, std::memory_order_relaxed);
+	_rateIntervalRequested = requested;
+	_rateIntervalWritten = written;
+	_rateIntervalDeferred = deferred;
+}
+
+LedDevice::WriteStatistics LedDevice::getWriteStatistics() const
+{
+	WriteStatistics statistics;
+
+	// Rates are outdated, if nothing was written for more than a statistics interval
+	const qint64 intervalStart_ns = _rateIntervalStart_ns.load(std::memory_order_relaxed);
+	if (intervalStart_ns > 0 && LatencyMetrics::monotonicTime_ns() - intervalStart_ns < 2 * WRITE_STATISTICS_INTERVAL.count())
+	{
+		statistics.requestedRate_hz = _requestedRate_hz.load(std::memory_order_relaxed);
+		statistics.achievedRate_hz = _achievedRate_hz.load(std::memory_order_relaxed);
+	}
+	statistics.requested = _updatesRequested.load(std::memory_order_relaxed);
+	statistics.written = _updatesWritten.load(std::memory_order_relaxed);
+	statistics.deferred = _updatesDeferred.load(std::memory_order_relaxed);
+	statistics.replaced = _updatesReplaced.load(std::memory_order_relaxed);
+
+	return statistics;
+}
+
 int LedDevice::rewriteLEDs()
 {
 	trackDevice(leddevice_write, "Rewriting LED values") << (_isLedUpdatePending.load() ? ", but skipping update as an LED update is pending." : "will be executed.");
@@ -736,6 +897,10 @@ QJsonObject LedDevice::addAuthorization(const QJsonObject& /*params*/)
 void LedDevice::setLogger(QSharedPointer<Logger> log)
 {
 	_log = log;
+
+	// Report the write latencies for the instance of the new logger
+	_writeLatency.reset();
+	_captureToLedLatency.reset();
 }
 
 void LedDevice::setLedCount(int ledCount)
@@ -184,6 +184,12 @@ int LedDeviceWrapper::getLatchTime() const
 	return value;
 }
 
+LedDevice::WriteStatistics LedDeviceWrapper::getWriteStatistics() const
+{
+	// The statistics are atomics, no need to block the device's thread
+	return _ledDevice.isNull() ? LedDevice::WriteStatistics() : _ledDevice->getWriteStatistics();
+}
+
 bool LedDeviceWrapper::isEnabled() const
 {
 	return _isEnabled;
@@ -63,6 +63,12 @@ bool LedDeviceUdpArtNet::init(const QJsonObject &deviceConfig)
 		Error(_log, "channelsPerFixture must be at least %d. Setting to %d.", _ledChannelsPerFixture, _ledChannelsPerFixture);
 		_artnet_channelsPerFixture = _ledChannelsPerFixture;
 	}
+	else if (_artnet_channelsPerFixture > DMX_MAX)
+	{
+		Error(_log, "channelsPerFixture must not exceed %d. Setting to %d.", DMX_MAX, DMX_MAX);
+		_artnet_channelsPerFixture = DMX_MAX;
+	}
+	_packets.clear();
 
 	return true;
 }
@@ -83,7 +89,7 @@ int LedDeviceUdpArtNet::open()
 }
 
 // populates the headers
-void LedDeviceUdpArtNet::prepare(unsigned this_universe, unsigned this_sequence, unsigned this_dmxChannelCount)
+void LedDeviceUdpArtNet::prepare(artnet_header_t& header, unsigned this_universe, unsigned this_sequence, unsigned this_dmxChannelCount)
 {
 	// WTF? why do the specs say:
 	// "This value should be an even number in the range 2 – 512. "
@@ -92,82 +98,106 @@ void LedDeviceUdpArtNet::prepare(unsigned this_universe, unsigned this_sequence,
 		this_dmxChannelCount++;
 	}
 
-	memcpy(artnet_packet.header.ID, "Art-Net\0", 8);
-	artnet_packet.header.OpCode = qToLittleEndian<quint16>(0x5000);
-	artnet_packet.header.ProtVer = qToBigEndian<quint16>(14);
-	artnet_packet.header.Sequence = static_cast<quint8>(this_sequence);
-	artnet_packet.header.Physical = 0;
-	artnet_packet.header.SubUni = this_universe & 0xFF;
-	artnet_packet.header.Net = (this_universe >> 8) & 0x7F;
-	artnet_packet.header.Length = qToBigEndian<quint16>(static_cast<quint16>(this_dmxChannelCount));
+	memcpy(header.ID, "Art-Net\0", 8);
+	header.OpCode = qToLittleEndian<quint16>(0x5000);
+	header.ProtVer = qToBigEndian<quint16>(14);
+	header.Sequence = static_cast<quint8>(this_sequence);
+	header.Physical = 0;
+	header.SubUni = this_universe & 0xFF;
+	header.Net = (this_universe >> 8) & 0x7F;
+	header.Length = qToBigEndian<quint16>(static_cast<quint16>(this_dmxChannelCount));
 
 }
 
-int LedDeviceUdpArtNet::write(const QVector<ColorRgb> &ledValues)
+void LedDeviceUdpArtNet::prepareUniverses(int ledCount)
 {
-	int retVal = 0;
-	int thisUniverse = _artnet_universe;
-
-	/*
-	This field is incremented in the range 0x01 to 0xff to allow the receiving node to resequence packets.
-	The Sequence field is set to 0x00 to disable this feature.
-	*/
-	if (_artnet_seq++ == 0)
+	const int fixturesPerUniverse = DMX_MAX / _artnet_channelsPerFixture;
+	const int universeCount = (ledCount + fixturesPerUniverse - 1) / fixturesPerUniverse;
+
+	_artnet_ledCount = ledCount;
+	_artnet_headers.resize(static_cast<size_t>(universeCount));
+	_packets.resize(static_cast<size_t>(universeCount));
+
+	// Channels not used by a fixture stay zero
+	_artnet_data.fill(0, universeCount * DMX_MAX);
+
+	// Universes are laid out anew, so all are sent with the next frame
+	resetPacketStates();
+
+	for (int universeIdx = 0; universeIdx < universeCount; ++universeIdx)
 	{
-		_artnet_seq = 1;
+		const int fixtureCount = qMin(fixturesPerUniverse, ledCount - universeIdx * fixturesPerUniverse);
+		const int dmxCount = fixtureCount * _artnet_channelsPerFixture;
+
+		artnet_header_t& header = _artnet_headers[static_cast<size_t>(universeIdx)];
+		prepare(header, static_cast<unsigned>(_artnet_universe + universeIdx), 0, static_cast<unsigned>(dmxCount));
+
+		UdpPacket& packet = _packets[static_cast<size_t>(universeIdx)];
+		packet.header = reinterpret_cast<const uint8_t*>(&header);
+		packet.headerSize = sizeof(artnet_header_t);
+		packet.payload = _artnet_data.constData() + universeIdx * DMX_MAX;
+		packet.payloadSize = static_cast<size_t>(dmxCount);
 	}
+}
 
-	int dmxIdx = 0; // offset into the current dmx packet
+int LedDeviceUdpArtNet::write(const QVector<ColorRgb> &ledValues)
+{
+	if (ledValues.size() != _artnet_ledCount || _packets.empty())
+	{
+		prepareUniverses(ledValues.size());
+	}
 
-	memset(artnet_packet.raw, 0, sizeof(artnet_packet.raw));
+	const int fixturesPerUniverse = DMX_MAX / _artnet_channelsPerFixture;
+	uint8_t* universeData = _artnet_data.data();
+	int fixtureIdx = 0; // fixture in the current universe
 
 	for (const ColorRgb& color : ledValues)
 	{
-		// Check if this LED would overflow the DMX packet
-		if (dmxIdx + _artnet_channelsPerFixture > DMX_MAX)
+		// Continue with the next universe, if this LED would overflow the DMX packet
+		if (fixtureIdx == fixturesPerUniverse)
 		{
-			// Send current packet before continuing
-			prepare(thisUniverse, _artnet_seq, dmxIdx);
-
-			if (writeBytes(18 + dmxIdx, artnet_packet.raw) < 0)
-			{
-				retVal = -1;
-			}
-
-			memset(artnet_packet.raw, 0, sizeof(artnet_packet.raw));
-			thisUniverse++;
-			dmxIdx = 0;
+			universeData += DMX_MAX;
+			fixtureIdx = 0;
 		}
 
+		uint8_t* dmx = universeData + fixtureIdx * _artnet_channelsPerFixture;
 		if (_whiteAlgorithm == RGBW::WhiteAlgorithm::WHITE_OFF)
 		{
-			artnet_packet.Data[dmxIdx++] = color.red;
-			artnet_packet.Data[dmxIdx++] = color.green;
-			artnet_packet.Data[dmxIdx++] = color.blue;
+			dmx[0] = color.red;
+			dmx[1] = color.green;
+			dmx[2] = color.blue;
 		}
 		else
 		{
 			RGBW::Rgb_to_Rgbw(color, &_temp_rgbw, _whiteAlgorithm);
-			artnet_packet.Data[dmxIdx++] = _temp_rgbw.red;
-			artnet_packet.Data[dmxIdx++] = _temp_rgbw.green;
-			artnet_packet.Data[dmxIdx++] = _temp_rgbw.blue;
-			artnet_packet.Data[dmxIdx++] = _temp_rgbw.white;
+			dmx[0] = _temp_rgbw.red;
+			dmx[1] = _temp_rgbw.green;
+			dmx[2] = _temp_rgbw.blue;
+			dmx[3] = _temp_rgbw.white;
 		}
 
-		// Skip extra channels if fixture needs more than RGB/RGBW
-		dmxIdx += (_artnet_channelsPerFixture - _ledChannelsPerFixture);
+		// Extra channels stay zero, if fixture needs more than RGB/RGBW
+		++fixtureIdx;
 	}
 
-	// Send the last packet if there's any data
-	if (dmxIdx > 0)
+	_sendPackets.clear();
+	for (size_t universeIdx = 0; universeIdx < _packets.size(); ++universeIdx)
 	{
-		prepare(thisUniverse, _artnet_seq, dmxIdx);
-
-		if (writeBytes(18 + dmxIdx, artnet_packet.raw) < 0)
+		// Unchanged universes are skipped with delta updates
+		if (!isPacketDue(universeIdx, _packets[universeIdx]))
 		{
-			retVal = -1;
+			continue;
 		}
+
+		/*
+		This field is incremented in the range 0x01 to 0xff to allow the receiving node to resequence packets.
+		The Sequence field is set to 0x00 to disable this feature.
+		*/
+		uint8_t& sequence = _artnet_headers[universeIdx].Sequence;
+		sequence = (sequence == 0xFF) ? 1 : static_cast<uint8_t>(sequence + 1);
+
+		_sendPackets.push_back(_packets[universeIdx]);
 	}
 
-	return retVal;
+	return writePackets(_sendPackets);
 }
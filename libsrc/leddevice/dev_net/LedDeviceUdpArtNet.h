@@ -8,6 +8,8 @@
 #include <QJsonObject>
 #include <QVector>
 
+#include <vector>
+
 #include <utils/RgbToRgbw.h>
 
 /**
@@ -92,12 +94,30 @@ private:
 	///
 	/// @brief Generate Art-Net communication header
 	///
-	void prepare(unsigned this_universe, unsigned this_sequence, unsigned this_dmxChannelCount);
+	/// @param[out] header The header to populate
+	/// @param[in] this_universe The packet's universe
+	/// @param[in] this_sequence The packet's sequence number
+	/// @param[in] this_dmxChannelCount The number of DMX channels in the packet
+	///
+	void prepare(artnet_header_t& header, unsigned this_universe, unsigned this_sequence, unsigned this_dmxChannelCount);
+
+	///
+	/// @brief Generate the headers and DMX data buffers of all universes
+	///
+	/// @param[in] ledCount The number of LEDs to be sent
+	///
+	void prepareUniverses(int ledCount);
 
 	int _ledChannelsPerFixture = 3;
 
-	artnet_packet_t artnet_packet{};
-	uint8_t _artnet_seq = 1;
+	/// Headers per universe, followed by their DMX data in a buffer of DMX_MAX channels per universe
+	std::vector<artnet_header_t> _artnet_headers;
+	QVector<uint8_t> _artnet_data;
+	std::vector<UdpPacket> _packets;
+	/// Packets of the universes sent per frame
+	std::vector<UdpPacket> _sendPackets;
+	int _artnet_ledCount = 0;
+
 	int _artnet_channelsPerFixture = _ledChannelsPerFixture;
 	int _artnet_universe = 1;
 
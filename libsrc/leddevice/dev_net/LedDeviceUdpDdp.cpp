@@ -154,7 +154,7 @@ bool LedDeviceUdpDdp::init(const QJsonObject &deviceConfig)
 	}	
 	p.dataSize = DDP::LEDPixelFormat::Pixel8;
 
-	_ddpData.resize(DDP::HEADER_LEN + DDP::CHANNELS_PER_PACKET);
+	_ddpData.resize(DDP::HEADER_LEN);
 	_ddpData[0] = DDP::flags1::VER1; // flags1
 	_ddpData[1] = 0;				 // flags2
 	_ddpData[2] = qToBigEndian<uint8_t>(p.toRawByte());	 // type
@@ -186,57 +186,76 @@ int LedDeviceUdpDdp::open()
 
 int LedDeviceUdpDdp::write(const QVector<ColorRgb> &ledValues)
 {
-	int rc {0};
-
 	int channelCount;
-	const char* dataPtr = nullptr;
+	const uint8_t* dataPtr = nullptr;
 
 	if (_whiteAlgorithm == RGBW::WhiteAlgorithm::WHITE_OFF)
 	{
 		channelCount = _ledRGBCount; // 1 channel for every R,G,B value
-		dataPtr =reinterpret_cast<const char*>(ledValues.data());
+		dataPtr = reinterpret_cast<const uint8_t*>(ledValues.data());
 	}
 	else
 	{
 		channelCount = _ledRGBWCount; // 1 channel for every R,G,B,W value
 
-		QVector<ColorRgbw> rgbwLedValues;
-		rgbwLedValues.resize(_ledCount);
+		_rgbwLedValues.resize(_ledCount);
 		for (uint i = 0; i < _ledCount; ++i)
 		{
-			RGBW::Rgb_to_Rgbw(ledValues[i], &rgbwLedValues[i], _whiteAlgorithm);
+			RGBW::Rgb_to_Rgbw(ledValues[i], &_rgbwLedValues[i], _whiteAlgorithm);
 		}
-		dataPtr = reinterpret_cast<const char*>(rgbwLedValues.data());
+		dataPtr = reinterpret_cast<const uint8_t*>(_rgbwLedValues.constData());
 	}
 
 	int packetCount = (channelCount + DDP::CHANNELS_PER_PACKET - 1) / DDP::CHANNELS_PER_PACKET;
 	int channel = 0;
 
-	_ddpData[0] = DDP::flags1::VER1;
+	// One header per packet, prebuilt from the first one holding type and id
+	if (_ddpData.size() < packetCount * DDP::HEADER_LEN)
+	{
+		int offset = _ddpData.size();
+		_ddpData.resize(packetCount * DDP::HEADER_LEN);
+		for (; offset < _ddpData.size(); offset += DDP::HEADER_LEN)
+		{
+			memcpy(_ddpData.data() + offset, _ddpData.constData(), DDP::HEADER_LEN);
+		}
+	}
+	_packets.clear();
+	char* lastHeader = nullptr;
 
 	for (int currentPacket = 0; currentPacket < packetCount; ++currentPacket)
 	{
-		_packageSequenceNumber &= 0x0F;
-
 		const bool isLastPacket = (currentPacket == packetCount - 1);
 		const int packetSize = isLastPacket ? (channelCount - channel) : DDP::CHANNELS_PER_PACKET;
 
-		/*0*/_ddpData[0] = DDP::flags1::VER1 | (isLastPacket ? DDP::flags1::PUSH : 0);
-		/*1*/_ddpData[1] = static_cast<char>(_packageSequenceNumber++ & 0x0F);
-		/*4*/qToBigEndian<quint32>(static_cast<quint32>(channel), _ddpData.data() + 4);
-		/*8*/qToBigEndian<quint16>(static_cast<quint16>(packetSize), _ddpData.data() + 8);
-
-		_ddpData.replace(DDP::HEADER_LEN, packetSize, dataPtr + channel, packetSize);
-		_ddpData.resize(DDP::HEADER_LEN + packetSize);
-
-		rc = writeBytes(_ddpData);
+		// The payload points at the color data, packets are gathered when sent
+		char* header = _ddpData.data() + currentPacket * DDP::HEADER_LEN;
+		const UdpPacket packet { reinterpret_cast<const uint8_t*>(header), DDP::HEADER_LEN, dataPtr + channel, static_cast<size_t>(packetSize) };
+		const int offset = channel;
+		channel += packetSize;
 
-		if (rc != 0)
+		// Unchanged packets are skipped with delta updates
+		if (!isPacketDue(static_cast<size_t>(currentPacket), packet))
 		{
-			break;
+			continue;
 		}
-		channel += packetSize;
+
+		_packageSequenceNumber &= 0x0F;
+
+		/*0*/header[0] = DDP::flags1::VER1;
+		/*1*/header[1] = static_cast<char>(_packageSequenceNumber++ & 0x0F);
+		/*4*/qToBigEndian<quint32>(static_cast<quint32>(offset), header + 4);
+		/*8*/qToBigEndian<quint16>(static_cast<quint16>(packetSize), header + 8);
+
+		_packets.push_back(packet);
+		lastHeader = header;
 	}
-	return rc;
+
+	// The receiver displays the frame with the last packet sent
+	if (lastHeader != nullptr)
+	{
+		lastHeader[0] = DDP::flags1::VER1 | DDP::flags1::PUSH;
+	}
+
+	return writePackets(_packets);
 }
 
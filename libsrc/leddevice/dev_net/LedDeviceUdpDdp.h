@@ -61,8 +61,15 @@ protected:
 
 private:
 
+	/// The headers of the packets of a frame, prebuilt from the first one
 	QByteArray  _ddpData;
 
+	/// The packets sent per frame, pointing at their header and the color data
+	std::vector<UdpPacket> _packets;
+
+	/// The colors of a frame, if a white channel is used
+	QVector<ColorRgbw> _rgbwLedValues;
+
 	int _packageSequenceNumber;
 	RGBW::WhiteAlgorithm _whiteAlgorithm;	
 };
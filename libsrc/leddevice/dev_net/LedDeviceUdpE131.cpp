@@ -83,6 +83,7 @@ bool LedDeviceUdpE131::init(const QJsonObject &deviceConfig)
 	Debug(_log, "whiteAlgorithm : %s", QSTRING_CSTR(whiteAlgorithmStr));
 	_dmxChannelCount = (_whiteAlgorithm == RGBW::WhiteAlgorithm::WHITE_OFF) ? _ledRGBCount : _ledRGBWCount;
 	_ledBuffer.resize(_dmxChannelCount);
+	_e131_packets.clear();
 
 	if (_json_cid.isEmpty())
 	{
@@ -118,92 +119,121 @@ int LedDeviceUdpE131::open()
 }
 
 // populates the headers
-void LedDeviceUdpE131::prepare(uint16_t this_universe, uint16_t this_dmxChannelCount)
+void LedDeviceUdpE131::prepare(e131_packet_t& packet, uint16_t this_universe, uint16_t this_dmxChannelCount)
 {
-	memset(_e131_packet.raw, 0, sizeof(_e131_packet.raw));
+	memset(packet.raw, 0, sizeof(packet.raw));
 
 	/* Root Layer */
-	_e131_packet.frame.preamble_size = htons(16);
-	_e131_packet.frame.postamble_size = 0;
-	memcpy (_e131_packet.frame.acn_id, _acn_id, 12);
-	_e131_packet.frame.root_flength = htons(0x7000 | (110+this_dmxChannelCount) );
-	_e131_packet.frame.root_vector = htonl(VECTOR_ROOT_E131_DATA);
-	memcpy (_e131_packet.frame.cid, _e131_cid.toRfc4122().constData() , sizeof(_e131_packet.frame.cid) );
+	packet.frame.preamble_size = htons(16);
+	packet.frame.postamble_size = 0;
+	memcpy (packet.frame.acn_id, _acn_id, 12);
+	packet.frame.root_flength = htons(0x7000 | (110+this_dmxChannelCount) );
+	packet.frame.root_vector = htonl(VECTOR_ROOT_E131_DATA);
+	memcpy (packet.frame.cid, _e131_cid.toRfc4122().constData() , sizeof(packet.frame.cid) );
 	/* Frame Layer */
-	_e131_packet.frame.frame_flength = htons(0x7000 | (88+this_dmxChannelCount));
-	_e131_packet.frame.frame_vector = htonl(VECTOR_E131_DATA_PACKET);
-	snprintf (_e131_packet.frame.source_name, sizeof(_e131_packet.frame.source_name), "%s", QSTRING_CSTR(_e131_source_name) );
-	_e131_packet.frame.priority = 100;
-	_e131_packet.frame.reserved = htons(0);
-	_e131_packet.frame.sequence_number = 0;
-	_e131_packet.frame.options = 0;	// Bit 7 =  Preview_Data
+	packet.frame.frame_flength = htons(0x7000 | (88+this_dmxChannelCount));
+	packet.frame.frame_vector = htonl(VECTOR_E131_DATA_PACKET);
+	snprintf (packet.frame.source_name, sizeof(packet.frame.source_name), "%s", QSTRING_CSTR(_e131_source_name) );
+	packet.frame.priority = 100;
+	packet.frame.reserved = htons(0);
+	packet.frame.sequence_number = 0;
+	packet.frame.options = 0;	// Bit 7 =  Preview_Data
 					// Bit 6 =  Stream_Terminated
 					// Bit 5 = Force_Synchronization
-	_e131_packet.frame.universe = htons(this_universe);
+	packet.frame.universe = htons(this_universe);
 
 	/* DMX Layer */
-	_e131_packet.frame.dmp_flength = htons(0x7000 | (11+this_dmxChannelCount));
-	_e131_packet.frame.dmp_vector = VECTOR_DMP_SET_PROPERTY;
-	_e131_packet.frame.type = 0xa1;
-	_e131_packet.frame.first_address = htons(0);
-	_e131_packet.frame.address_increment = htons(1);
-	_e131_packet.frame.property_value_count = htons(1+this_dmxChannelCount);
-
-	_e131_packet.frame.property_values[0] = 0;	// start code
+	packet.frame.dmp_flength = htons(0x7000 | (11+this_dmxChannelCount));
+	packet.frame.dmp_vector = VECTOR_DMP_SET_PROPERTY;
+	packet.frame.type = 0xa1;
+	packet.frame.first_address = htons(0);
+	packet.frame.address_increment = htons(1);
+	packet.frame.property_value_count = htons(1+this_dmxChannelCount);
+
+	packet.frame.property_values[0] = 0;	// start code
 }
 
-int LedDeviceUdpE131::write(const QVector<ColorRgb> &ledValues)
+void LedDeviceUdpE131::prepareUniverses()
 {
-	int retVal = 0;
-	uint16_t thisChannelCount = 0;
+	const int universeCount = (_dmxChannelCount + _e131_dmx_max - 1) / _e131_dmx_max;
 
-	uint8_t* rawDataPtr = _ledBuffer.data();
+	_e131_packets.resize(static_cast<size_t>(universeCount));
+	_packets.resize(static_cast<size_t>(universeCount));
+	resetPacketStates();
 
-	int currentChannel = 0;
-	for (const ColorRgb& color : ledValues)
+	for (int universeIdx = 0; universeIdx < universeCount; ++universeIdx)
 	{
-		if (_whiteAlgorithm == RGBW::WhiteAlgorithm::WHITE_OFF)
-		{
-			rawDataPtr[currentChannel++] = color.red;
-			rawDataPtr[currentChannel++] = color.green;
-			rawDataPtr[currentChannel++] = color.blue;
-		}
-		else
-		{
-			RGBW::Rgb_to_Rgbw(color, &_temp_rgbw, _whiteAlgorithm);
-			rawDataPtr[currentChannel++] = _temp_rgbw.red;
-			rawDataPtr[currentChannel++] = _temp_rgbw.green;
-			rawDataPtr[currentChannel++] = _temp_rgbw.blue;
-			rawDataPtr[currentChannel++] = _temp_rgbw.white;
-		}
+		const int rawIdx = universeIdx * _e131_dmx_max;
+		const uint16_t thisChannelCount = static_cast<uint16_t>((_dmxChannelCount - rawIdx < _e131_dmx_max) ? _dmxChannelCount - rawIdx : _e131_dmx_max);
+		// is this the last packet? ? ^^ last packet : ^^ earlier packets
+
+		e131_packet_t& packet = _e131_packets[static_cast<size_t>(universeIdx)];
+		prepare(packet, static_cast<uint16_t>(_e131_universe + universeIdx), thisChannelCount);
+
+		// Header including the start code, followed by the universe's channels
+		UdpPacket& udpPacket = _packets[static_cast<size_t>(universeIdx)];
+		udpPacket.header = packet.raw;
+		udpPacket.headerSize = E131_DMP_DATA + 1;
+		udpPacket.payloadSize = thisChannelCount;
 	}
+}
 
-	_e131_seq++;
+int LedDeviceUdpE131::write(const QVector<ColorRgb> &ledValues)
+{
+	const uint8_t* rawDataPtr = _ledBuffer.data();
 
-	for (auto rawIdx = 0; rawIdx < _dmxChannelCount; rawIdx++)
+	if (_whiteAlgorithm == RGBW::WhiteAlgorithm::WHITE_OFF && ledValues.size() * 3 >= _dmxChannelCount)
+	{
+		// RGB channels are sent straight from the colors
+		rawDataPtr = reinterpret_cast<const uint8_t*>(ledValues.data());
+	}
+	else
 	{
-		if (rawIdx % _e131_dmx_max == 0) // start of new packet
+		int currentChannel = 0;
+		for (const ColorRgb& color : ledValues)
 		{
-			thisChannelCount = static_cast<uint16_t>((_dmxChannelCount - rawIdx < _e131_dmx_max) ? _dmxChannelCount - rawIdx : _e131_dmx_max);
-			// is this the last packet? ? ^^ last packet : ^^ earlier packets
-
-			prepare(static_cast<uint16_t>(_e131_universe + rawIdx / _e131_dmx_max), thisChannelCount);
-			_e131_packet.frame.sequence_number = _e131_seq;
+			if (_whiteAlgorithm == RGBW::WhiteAlgorithm::WHITE_OFF)
+			{
+				_ledBuffer[currentChannel++] = color.red;
+				_ledBuffer[currentChannel++] = color.green;
+				_ledBuffer[currentChannel++] = color.blue;
+			}
+			else
+			{
+				RGBW::Rgb_to_Rgbw(color, &_temp_rgbw, _whiteAlgorithm);
+				_ledBuffer[currentChannel++] = _temp_rgbw.red;
+				_ledBuffer[currentChannel++] = _temp_rgbw.green;
+				_ledBuffer[currentChannel++] = _temp_rgbw.blue;
+				_ledBuffer[currentChannel++] = _temp_rgbw.white;
+			}
 		}
+	}
 
-		_e131_packet.frame.property_values[1 + rawIdx % _e131_dmx_max] = rawDataPtr[rawIdx];
+	if (_e131_packets.empty())
+	{
+		prepareUniverses();
+	}
 
-		// is this the last byte of last packet || last byte of other packets
-		if ((rawIdx == _dmxChannelCount - 1) || (rawIdx % _e131_dmx_max == _e131_dmx_max - 1))
+	_sendPackets.clear();
+	for (size_t universeIdx = 0; universeIdx < _packets.size(); ++universeIdx)
+	{
+		_packets[universeIdx].payload = rawDataPtr + universeIdx * _e131_dmx_max;
+
+		// Unchanged universes are skipped with delta updates
+		if (!isPacketDue(universeIdx, _packets[universeIdx]))
 		{
-			qCDebug(leddevice_write) << QString("send packet: rawidx %1 dmxchannelcount %2 universe: %3, packetsz %4")
-											.arg(rawIdx)
-											.arg(_dmxChannelCount)
-											.arg(_e131_universe + rawIdx / _e131_dmx_max)
-											.arg(thisChannelCount);
-			retVal &= writeBytes(E131_DMP_DATA + 1 + thisChannelCount, _e131_packet.raw);
+			continue;
 		}
+
+		// Receivers track the sequence per universe, it only advances when the universe is sent
+		_e131_packets[universeIdx].frame.sequence_number++;
+		_sendPackets.push_back(_packets[universeIdx]);
+
+		qCDebug(leddevice_write) << QString("send packet: dmxchannelcount %1 universe: %2, packetsz %3")
+										.arg(_dmxChannelCount)
+										.arg(_e131_universe + universeIdx)
+										.arg(_packets[universeIdx].payloadSize);
 	}
 
-	return retVal;
+	return writePackets(_sendPackets);
 }
@@ -10,6 +10,8 @@
 #include <QJsonObject>
 #include <QVector>
 
+#include <vector>
+
 /**
  *
  * https://raw.githubusercontent.com/forkineye/ESPixelStick/master/_E131.h
@@ -140,17 +142,24 @@ private:
 	int write(const QVector<ColorRgb> & ledValues) override;	
 
 	///
-	/// @brief Writes the RGB-Color values to the LEDs.
+	/// @brief Generate E1.31 communication header
 	///
-	/// @param[in] ledValues The RGB-color per LED
-	/// @return Zero on success, else negative
+	/// @param[out] packet The packet to populate
+	/// @param[in] this_universe The packet's universe
+	/// @param[in] this_dmxChannelCount The number of DMX channels in the packet
 	///
-	/// @brief Generate E1.31 communication header
+	void prepare(e131_packet_t& packet, uint16_t this_universe, uint16_t this_dmxChannelCount);
+
+	///
+	/// @brief Generate the headers of all universes, only the sequence numbers change per frame
 	///
-	void prepare(uint16_t this_universe, uint16_t this_dmxChannelCount);
+	void prepareUniverses();
 
-	e131_packet_t _e131_packet;
-	uint8_t _e131_seq = 0;
+	/// Headers per universe, the DMX data is sent from the color buffer
+	std::vector<e131_packet_t> _e131_packets;
+	std::vector<UdpPacket> _packets;
+	/// Packets of the universes sent per frame
+	std::vector<UdpPacket> _sendPackets;
 	uint16_t _e131_universe = 1;
 	uint16_t _e131_dmx_max;
 	uint8_t _acn_id[12] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00 };
@@ -1,12 +1,18 @@
 #include "ProviderUdp.h"
 
 // STL includes
+#include <cerrno>
 #include <cstring>
 #include <cstdio>
 #include <iostream>
 #include <exception>
 // Linux includes
 #include <fcntl.h>
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
 
 
 #include <QStringList>
@@ -14,6 +20,47 @@
 #include <QHostInfo>
 
 #include <utils/NetUtils.h>
+#include <utils/LatencyMetrics.h>
+
+// Constants
+namespace {
+
+const char CONFIG_DELTA_UPDATES[] = "deltaUpdates";
+const char CONFIG_KEEP_ALIVE_TIME[] = "keepAliveTime";
+
+// Unchanged packets are resent with the first write after the keep-alive time, the cap leaves margin for the
+// interval between writes below the network data loss timeout of E1.31 receivers (2.5 seconds)
+const int DEFAULT_KEEP_ALIVE_TIME_MS = 1000;
+const int MIN_KEEP_ALIVE_TIME_MS = 100;
+const int MAX_KEEP_ALIVE_TIME_MS = 1000;
+
+constexpr qint64 NS_PER_MS { 1000000 };
+
+// Hashes a payload word by word, to detect changed packets
+quint64 hashPayload(const uint8_t* data, size_t size)
+{
+	constexpr quint64 MULTIPLIER { 0x9E3779B97F4A7C15ULL };
+
+	quint64 hash = size * MULTIPLIER;
+	size_t i = 0;
+	for (; i + sizeof(quint64) <= size; i += sizeof(quint64))
+	{
+		quint64 word;
+		memcpy(&word, data + i, sizeof(word));
+		hash = (hash ^ word) * MULTIPLIER;
+		hash ^= hash >> 32;
+	}
+
+	quint64 tail = 0;
+	if (i < size)
+	{
+		memcpy(&tail, data + i, size - i);
+	}
+	hash = (hash ^ tail) * MULTIPLIER;
+	return hash ^ (hash >> 29);
+}
+
+} // namespace
 
 ProviderUdp::ProviderUdp(const QJsonObject& deviceConfig)
 	: LedDevice(deviceConfig)
@@ -21,6 +68,28 @@ ProviderUdp::ProviderUdp(const QJsonObject& deviceConfig)
 	  , _udpSocket(nullptr)
 {
 	_latchTime_ms = 0;
+	_isDeltaUpdates = false;
+	_keepAliveTime_ns = DEFAULT_KEEP_ALIVE_TIME_MS * NS_PER_MS;
+}
+
+bool ProviderUdp::init(const QJsonObject &deviceConfig)
+{
+	if (!LedDevice::init(deviceConfig))
+	{
+		return false;
+	}
+
+	_isDeltaUpdates = deviceConfig[CONFIG_DELTA_UPDATES].toBool(false);
+	const int keepAliveTime_ms = qBound(MIN_KEEP_ALIVE_TIME_MS, deviceConfig[CONFIG_KEEP_ALIVE_TIME].toInt(DEFAULT_KEEP_ALIVE_TIME_MS), MAX_KEEP_ALIVE_TIME_MS);
+	_keepAliveTime_ns = keepAliveTime_ms * NS_PER_MS;
+	resetPacketStates();
+
+	if (_isDeltaUpdates)
+	{
+		Debug(_log, "Delta updates     : enabled, keep-alive every %d ms", keepAliveTime_ms);
+	}
+
+	return true;
 }
 
 int ProviderUdp::open()
@@ -62,12 +131,72 @@ int ProviderUdp::open()
 		}
 	}
 
+	if (prepareBatchSend())
+	{
+		Debug(_log, "Packets are sent in batches");
+	}
+	resetPacketStates();
+
 	return 0;
 }
 
+bool ProviderUdp::prepareBatchSend()
+{
+	_batchSender.reset();
+
+#if defined(__linux__)
+	const qintptr socketDescriptor = _udpSocket->socketDescriptor();
+	if (socketDescriptor < 0 || !_ipAddress.scopeId().isEmpty())
+	{
+		return false;
+	}
+
+	// Address the destination in the socket's family, i.e. IPv4 addresses are mapped for dual-stack sockets
+	sockaddr_storage local {};
+	socklen_t localSize = sizeof(local);
+	if (getsockname(static_cast<int>(socketDescriptor), reinterpret_cast<sockaddr*>(&local), &localSize) != 0)
+	{
+		return false;
+	}
+
+	const bool isIPv4 = _ipAddress.protocol() == QAbstractSocket::IPv4Protocol;
+	if (local.ss_family == AF_INET && isIPv4)
+	{
+		sockaddr_in destination {};
+		destination.sin_family = AF_INET;
+		destination.sin_port = htons(static_cast<quint16>(_port));
+		destination.sin_addr.s_addr = htonl(_ipAddress.toIPv4Address());
+		return _batchSender.setDestination(socketDescriptor, &destination, sizeof(destination));
+	}
+
+	if (local.ss_family == AF_INET6)
+	{
+		sockaddr_in6 destination {};
+		destination.sin6_family = AF_INET6;
+		destination.sin6_port = htons(static_cast<quint16>(_port));
+		if (isIPv4)
+		{
+			const quint32 ipv4 = htonl(_ipAddress.toIPv4Address());
+			destination.sin6_addr.s6_addr[10] = 0xFF;
+			destination.sin6_addr.s6_addr[11] = 0xFF;
+			memcpy(&destination.sin6_addr.s6_addr[12], &ipv4, sizeof(ipv4));
+		}
+		else
+		{
+			const Q_IPV6ADDR ipv6 = _ipAddress.toIPv6Address();
+			memcpy(destination.sin6_addr.s6_addr, ipv6.c, sizeof(ipv6.c));
+		}
+		return _batchSender.setDestination(socketDescriptor, &destination, sizeof(destination));
+	}
+#endif
+
+	return false;
+}
+
 int ProviderUdp::close()
 {
 	_isDeviceReady = false;
+	_batchSender.reset();
 
 	if (!_udpSocket.isNull())
 	{
@@ -95,6 +224,77 @@ int ProviderUdp::writeBytes(const unsigned size, const uint8_t* data)
 	return  rc;
 }
 
+int ProviderUdp::writePackets(const std::vector<UdpPacket>& packets)
+{
+	if (_batchSender.isReady())
+	{
+		const size_t packetsSent = _batchSender.send(packets);
+		if (packetsSent == packets.size())
+		{
+			return 0;
+		}
+
+		const int error = errno;
+		Warning(_log, "%s", QSTRING_CSTR(QString("(%1:%2) Write Error: (%3) %4, %5 of %6 packets sent").arg(_ipAddress.toString()).arg(_port).arg(error).arg(strerror(error)).arg(packetsSent).arg(packets.size())));
+		resetPacketStates();
+		return -1;
+	}
+
+	int rc = 0;
+	for (const UdpPacket& packet : packets)
+	{
+		_packetBuffer.resize(static_cast<int>(packet.headerSize + packet.payloadSize));
+		memcpy(_packetBuffer.data(), packet.header, packet.headerSize);
+		if (packet.payloadSize > 0)
+		{
+			memcpy(_packetBuffer.data() + packet.headerSize, packet.payload, packet.payloadSize);
+		}
+
+		if (writeBytes(_packetBuffer) < 0)
+		{
+			rc = -1;
+		}
+	}
+
+	if (rc < 0)
+	{
+		resetPacketStates();
+	}
+	return rc;
+}
+
+bool ProviderUdp::isPacketDue(size_t index, const UdpPacket& packet)
+{
+	if (!_isDeltaUpdates)
+	{
+		return true;
+	}
+
+	if (index >= _packetStates.size())
+	{
+		_packetStates.resize(index + 1);
+	}
+
+	PacketState& state = _packetStates[index];
+	const quint64 payloadHash = hashPayload(packet.payload, packet.payloadSize);
+	const qint64 now_ns = LatencyMetrics::monotonicTime_ns();
+
+	if (state.isSent && state.payloadHash == payloadHash && now_ns - state.sendTime_ns < _keepAliveTime_ns)
+	{
+		return false;
+	}
+
+	state.payloadHash = payloadHash;
+	state.sendTime_ns = now_ns;
+	state.isSent = true;
+	return true;
+}
+
+void ProviderUdp::resetPacketStates()
+{
+	_packetStates.clear();
+}
+
 int ProviderUdp::writeBytes(const QByteArray& bytes)
 {
 	int rc = 0;
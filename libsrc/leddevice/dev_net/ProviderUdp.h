@@ -1,8 +1,12 @@
 #ifndef PROVIDERUDP_H
 #define PROVIDERUDP_H
 
+// STL includes
+#include <vector>
+
 // LedDevice includes
 #include <leddevice/LedDevice.h>
+#include "UdpBatchSender.h"
 
 // Qt includes
 #include <QHostAddress>
@@ -28,6 +32,14 @@ public:
 
 protected:
 
+	///
+	/// @brief Initialise the UDP device's configuration
+	///
+	/// @param[in] deviceConfig the JSON device configuration
+	/// @return True, if success
+	///
+	bool init(const QJsonObject &deviceConfig) override;
+
 	///
 	/// @brief Opens the output device.
 	///
@@ -61,6 +73,40 @@ protected:
 	///
 	int writeBytes(const QByteArray& bytes);
 
+	/// A datagram gathered from a protocol header and a payload, e.g. a universe's header and its color data
+	using UdpPacket = UdpBatchSender::Packet;
+
+	///
+	/// @brief Writes the given packets to the UDP-device
+	///
+	/// On Linux all packets are sent with a single system call (sendmmsg), gathering every datagram from its header
+	/// and payload buffers. Otherwise every packet is assembled and written as a datagram of its own.
+	///
+	/// @param[in] packets The packets
+	///
+	/// @return Zero on success, else negative
+	///
+	int writePackets(const std::vector<UdpPacket>& packets);
+
+	///
+	/// @brief Decides, if a packet of a frame is to be sent
+	///
+	/// With delta updates enabled, a packet is only due if its payload changed since it was last sent or its
+	/// keep-alive time has passed. Packets are identified by their index within a frame. A packet reported as due
+	/// is expected to be sent, else the states are to be reset. Without delta updates every packet is due.
+	///
+	/// @param[in] index The packet's index within the frame, e.g. its universe
+	/// @param[in] packet The packet
+	///
+	/// @return True, if the packet is to be sent
+	///
+	bool isPacketDue(size_t index, const UdpPacket& packet);
+
+	///
+	/// @brief Forgets the payloads sent, i.e. all packets of the next frame are due
+	///
+	void resetPacketStates();
+
 	///
 	QString _hostName;
 	int _port;
@@ -69,7 +115,32 @@ protected:
 
 private:	
 
+	///
+	/// @brief Sets up sending batches of packets to the resolved address via the socket
+	///
+	/// @return True, if batches can be sent, else packets are written by the Qt socket
+	///
+	bool prepareBatchSend();
+
 	QHostAddress _ipAddress;
+
+	UdpBatchSender _batchSender;
+
+	/// Packet assembled for the Qt socket, if batches cannot be sent
+	QByteArray _packetBuffer;
+
+	/// Payload last sent per packet of a frame, for delta updates
+	struct PacketState
+	{
+		quint64 payloadHash {0};
+		qint64 sendTime_ns {0};
+		bool isSent {false};
+	};
+	std::vector<PacketState> _packetStates;
+
+	/// Send changed packets only, unchanged ones are resent after the keep-alive time
+	bool _isDeltaUpdates;
+	qint64 _keepAliveTime_ns;
 };
 
 #endif // PROVIDERUDP_H
@@ -0,0 +1,95 @@
+#include "UdpBatchSender.h"
+
+// STL includes
+#include <cerrno>
+#include <cstring>
+
+bool UdpBatchSender::setDestination(intptr_t socketDescriptor, const void* destination, size_t destinationSize)
+{
+	reset();
+
+#if defined(__linux__)
+	if (socketDescriptor < 0 || destination == nullptr || destinationSize > sizeof(_destination))
+	{
+		return false;
+	}
+
+	memcpy(&_destination, destination, destinationSize);
+	_destinationSize = static_cast<socklen_t>(destinationSize);
+	_socketDescriptor = socketDescriptor;
+	return true;
+#else
+	(void)socketDescriptor;
+	(void)destination;
+	(void)destinationSize;
+	return false;
+#endif
+}
+
+void UdpBatchSender::reset()
+{
+	_socketDescriptor = -1;
+}
+
+size_t UdpBatchSender::send(const std::vector<Packet>& packets)
+{
+#if defined(__linux__)
+	if (!isReady())
+	{
+		errno = ENOTCONN;
+		return 0;
+	}
+
+	const size_t count = packets.size();
+	if (_messages.size() < count)
+	{
+		_messages.resize(count);
+		_iovecs.resize(2 * count);
+	}
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		iovec* const iov = &_iovecs[2 * i];
+		iov[0].iov_base = const_cast<uint8_t*>(packets[i].header);
+		iov[0].iov_len = packets[i].headerSize;
+		iov[1].iov_base = const_cast<uint8_t*>(packets[i].payload);
+		iov[1].iov_len = packets[i].payloadSize;
+
+		msghdr& message = _messages[i].msg_hdr;
+		message.msg_name = &_destination;
+		message.msg_namelen = _destinationSize;
+		message.msg_iov = iov;
+		message.msg_iovlen = packets[i].payloadSize > 0 ? 2 : 1;
+		message.msg_control = nullptr;
+		message.msg_controllen = 0;
+		message.msg_flags = 0;
+		_messages[i].msg_len = 0;
+	}
+
+	// sendmmsg sends less than requested, if the socket buffer is full or the batch is larger than UIO_MAXIOV
+	size_t sent = 0;
+	while (sent < count)
+	{
+		const int rc = ::sendmmsg(static_cast<int>(_socketDescriptor), &_messages[sent], static_cast<unsigned>(count - sent), 0);
+		if (rc < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			break;
+		}
+		if (rc == 0)
+		{
+			errno = EAGAIN;
+			break;
+		}
+		sent += static_cast<size_t>(rc);
+	}
+	return sent;
+#else
+	(void)packets;
+	errno = ENOSYS;
+	return 0;
+#endif
+}
@@ -0,0 +1,87 @@
+#ifndef UDPBATCHSENDER_H
+#define UDPBATCHSENDER_H
+
+// STL includes
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
+///
+/// Sends a batch of UDP datagrams to one destination with a single system call (sendmmsg on Linux).
+///
+/// Every datagram is gathered from a header and a payload buffer, i.e. packets are assembled by the kernel
+/// from prebuilt protocol headers and the color data without copying them into a packet buffer first.
+///
+class UdpBatchSender
+{
+public:
+	///
+	/// A datagram of a batch, gathered from the header followed by the payload
+	///
+	struct Packet
+	{
+		const uint8_t* header {nullptr};
+		size_t headerSize {0};
+		const uint8_t* payload {nullptr};
+		size_t payloadSize {0};
+	};
+
+	///
+	/// @return True, if batches can be sent on this platform
+	///
+	static constexpr bool isAvailable()
+	{
+#if defined(__linux__)
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	///
+	/// @brief Sets the socket and the destination address, the socket is neither owned nor closed
+	///
+	/// @param[in] socketDescriptor An UDP socket's descriptor
+	/// @param[in] destination The destination address, of the socket's address family
+	/// @param[in] destinationSize The size of the destination address
+	/// @return True, if batches can be sent
+	///
+	bool setDestination(intptr_t socketDescriptor, const void* destination, size_t destinationSize);
+
+	///
+	/// @brief Stops sending batches, e.g. before the socket is closed
+	///
+	void reset();
+
+	///
+	/// @return True, if a socket and destination are set
+	///
+	bool isReady() const { return _socketDescriptor >= 0; }
+
+	///
+	/// @brief Sends the packets
+	///
+	/// @param[in] packets The packets
+	/// @return Number of packets sent, less than given on error (errno is set then)
+	///
+	size_t send(const std::vector<Packet>& packets);
+
+private:
+	intptr_t _socketDescriptor {-1};
+
+#if defined(__linux__)
+	sockaddr_storage _destination {};
+	socklen_t _destinationSize {0};
+
+	// Reused per batch, grow with the number of packets only
+	std::vector<mmsghdr> _messages;
+	std::vector<iovec> _iovecs;
+#endif
+};
+
+#endif // UDPBATCHSENDER_H
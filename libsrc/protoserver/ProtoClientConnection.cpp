@@ -6,6 +6,7 @@
 
 // project includes
 #include "ProtoClientConnection.h"
+#include <utils/LatencyMetrics.h>
 
 Q_LOGGING_CATEGORY(proto_server_client_flow, "hyperion.proto.server.flow");
 Q_LOGGING_CATEGORY(proto_server_client_cmd, "hyperion.proto.server.cmd");
@@ -157,6 +158,7 @@ void ProtoClientConnection::handleColorCommand(const proto::ColorRequest &messag
 
 void ProtoClientConnection::handleImageCommand(const proto::ImageRequest &message)
 {
+	const qint64 receiveTime_ns = LatencyMetrics::monotonicTime_ns();
 
 	// extract parameters
 	int priority = message.priority();
@@ -216,6 +218,7 @@ void ProtoClientConnection::handleImageCommand(const proto::ImageRequest &messag
 									  << "with size" << imageRGB.width() << "x" << imageRGB.height()
 									  << "and duration" << duration << "ms";
 
+	imageRGB.setCaptureTime(receiveTime_ns);
 	emit setGlobalInputImage(_priority, imageRGB, duration);
 	emit setBufferImage("ProtoBuffer", imageRGB);
 
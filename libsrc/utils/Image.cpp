@@ -35,7 +35,8 @@ Image<Pixel_T>::Image(int width, int height) :
 template <typename Pixel_T>
 Image<Pixel_T>::Image(int width, int height, const Pixel_T background) :
 	_d_ptr(new ImageData<Pixel_T>(width, height, background)),
-	_instanceId(++_image_instance_counter)
+	_instanceId(++_image_instance_counter),
+	_captureTime_ns(0)
 {
 	qCDebug(image_create).noquote() << QString("|Image| CREATE: Creating Image [%1] of size %2x%3").arg(_instanceId).arg(width).arg(height);
 }
@@ -43,7 +44,8 @@ Image<Pixel_T>::Image(int width, int height, const Pixel_T background) :
 template <typename Pixel_T>
 Image<Pixel_T>::Image(const Image& other) :
 	_d_ptr(other._d_ptr), // This just increments the ref-counter
-	_instanceId(++_image_instance_counter)
+	_instanceId(++_image_instance_counter),
+	_captureTime_ns(other._captureTime_ns)
 {
 	qCDebug(image_copy).noquote() << QString("|Image| COPY (SHALLOW): Image handle [%1] created, sharing data with handle [%2].").arg(_instanceId).arg(other._instanceId);
 }
@@ -51,7 +53,8 @@ Image<Pixel_T>::Image(const Image& other) :
 template <typename Pixel_T>
 Image<Pixel_T>::Image(Image&& src) noexcept :
 	_d_ptr(std::move(src._d_ptr)),
-	_instanceId(src._instanceId)
+	_instanceId(src._instanceId),
+	_captureTime_ns(src._captureTime_ns)
 {
 	src._instanceId = 0; // Invalidate moved-from handle
 	qCDebug(image_move).noquote() << QString("|Image| MOVE: Image handle [%1] has been moved into a new instance.").arg(_instanceId);
@@ -81,6 +84,7 @@ Image<Pixel_T>& Image<Pixel_T>::operator=(const Image& other)
 	if (this != &other)
 	{
 		_d_ptr = other._d_ptr;
+		_captureTime_ns = other._captureTime_ns;
 		qCDebug(image_assign).noquote() << QString("|Image| ASSIGN (SHALLOW HANDLE): Image handle [%1] now shares data with handle [%2].").arg(_instanceId).arg(other._instanceId);
 	}
 	return *this;
@@ -93,6 +97,7 @@ Image<Pixel_T>& Image<Pixel_T>::operator=(Image&& other) noexcept
 	{
 		_d_ptr = std::move(other._d_ptr);
 		_instanceId = other._instanceId;
+		_captureTime_ns = other._captureTime_ns;
 		other._instanceId = 0;
 		qCDebug(image_assign).noquote() << QString("|Image| ASSIGN (MOVE): Image handle [%1] has taken ownership from another handle.").arg(_instanceId);
 	}
@@ -104,6 +109,7 @@ void Image<Pixel_T>::swap(Image& other) noexcept
 {
 	std::swap(this->_d_ptr, other._d_ptr);
 	std::swap(this->_instanceId, other._instanceId);
+	std::swap(this->_captureTime_ns, other._captureTime_ns);
 }
 
 template <typename Pixel_T>
@@ -181,6 +187,7 @@ template <typename Pixel_T>
 void Image<Pixel_T>::toRgb(Image<ColorRgb>& image) const
 {
 	_d_ptr->toRgb(*image._d_ptr);
+	image._captureTime_ns = _captureTime_ns;
 }
 
 template <typename Pixel_T>
@@ -219,6 +226,18 @@ quint64 Image<Pixel_T>::id() const
 	return _instanceId;
 }
 
+template <typename Pixel_T>
+qint64 Image<Pixel_T>::captureTime() const
+{
+	return _captureTime_ns;
+}
+
+template <typename Pixel_T>
+void Image<Pixel_T>::setCaptureTime(qint64 captureTime_ns)
+{
+	_captureTime_ns = captureTime_ns;
+}
+
 template <typename Pixel_T>
 QImage Image<Pixel_T>::toQImage() const
 {
@@ -1,6 +1,7 @@
 #include "utils/ImageResampler.h"
 #include <utils/ColorSys.h>
 #include <utils/Logger.h>
+#include <utils/LatencyMetrics.h>
 
 ImageResampler::ImageResampler()
 	: _horizontalDecimation(8)
@@ -24,6 +25,9 @@ void ImageResampler::setCropping(int cropLeft, int cropRight, int cropTop, int c
 
 void ImageResampler::processImage(const uint8_t * data, int width, int height, size_t lineLength, PixelFormat pixelFormat, Image<ColorRgb> &outputImage) const
 {
+	static const QSharedPointer<LatencyHistogram> latency = LatencyMetrics::getInstance().histogram(LatencyMetrics::STAGE_RESAMPLE);
+	const LatencyTimer timer(latency.data());
+
 	int cropLeft = _cropLeft;
 	int cropRight  = _cropRight;
 	int cropTop = _cropTop;
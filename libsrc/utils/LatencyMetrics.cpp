@@ -0,0 +1,204 @@
+#include <utils/LatencyMetrics.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QPair>
+
+namespace {
+
+const double MICROSECONDS_PER_SECOND = 1000000.0;
+
+QByteArray escapeLabelValue(const QString& value)
+{
+	QByteArray escaped = value.toUtf8();
+	escaped.replace('\\', "\\\\");
+	escaped.replace('"', "\\\"");
+	escaped.replace('\n', "\\n");
+	return escaped;
+}
+
+QByteArray toSeconds(quint64 microseconds)
+{
+	return QByteArray::number(static_cast<double>(microseconds) / MICROSECONDS_PER_SECOND, 'g', 9);
+}
+
+} // namespace
+
+LatencyHistogram::LatencyHistogram()
+	: _counts()
+	, _sum_us(0)
+	, _max_us(0)
+{
+	for (std::atomic<quint64>& count : _counts)
+	{
+		count.store(0, std::memory_order_relaxed);
+	}
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds duration)
+{
+	const quint64 duration_us = static_cast<quint64>(std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::microseconds>(duration).count()));
+
+	int bucket = 0;
+	while (bucket < BUCKET_COUNT - 1 && bucketUpperBound_us(bucket) < duration_us)
+	{
+		++bucket;
+	}
+
+	_counts[bucket].fetch_add(1, std::memory_order_relaxed);
+	_sum_us.fetch_add(duration_us, std::memory_order_relaxed);
+
+	quint64 max_us = _max_us.load(std::memory_order_relaxed);
+	while (duration_us > max_us && !_max_us.compare_exchange_weak(max_us, duration_us, std::memory_order_relaxed))
+	{
+	}
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const
+{
+	Snapshot snapshot;
+	for (int bucket = 0; bucket < BUCKET_COUNT; ++bucket)
+	{
+		snapshot.counts[bucket] = _counts[bucket].load(std::memory_order_relaxed);
+		snapshot.count += snapshot.counts[bucket];
+	}
+	snapshot.sum_us = _sum_us.load(std::memory_order_relaxed);
+	snapshot.max_us = _max_us.load(std::memory_order_relaxed);
+	return snapshot;
+}
+
+quint64 LatencyHistogram::Snapshot::percentile(double quantile) const
+{
+	if (count == 0)
+	{
+		return 0;
+	}
+
+	const quint64 rank = std::max<quint64>(1, static_cast<quint64>(std::ceil(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(count))));
+	quint64 cumulated = 0;
+	for (int bucket = 0; bucket < BUCKET_COUNT - 1; ++bucket)
+	{
+		cumulated += counts[bucket];
+		if (cumulated >= rank)
+		{
+			// The bucket bound may exceed the longest duration recorded
+			return std::min(bucketUpperBound_us(bucket), max_us);
+		}
+	}
+	return max_us;
+}
+
+LatencyMetrics& LatencyMetrics::getInstance()
+{
+	static LatencyMetrics metrics;
+	return metrics;
+}
+
+QSharedPointer<LatencyHistogram> LatencyMetrics::histogram(const QString& stage, const QString& instance, const QString& component)
+{
+	QMutexLocker locker(&_mutex);
+
+	for (auto it = _entries.begin(); it != _entries.end();)
+	{
+		QSharedPointer<LatencyHistogram> existing = it->histogram.toStrongRef();
+		if (existing.isNull())
+		{
+			it = _entries.erase(it);
+			continue;
+		}
+		if (it->stage == stage && it->instance == instance && it->component == component)
+		{
+			return existing;
+		}
+		++it;
+	}
+
+	QSharedPointer<LatencyHistogram> created = QSharedPointer<LatencyHistogram>::create();
+	_entries.append({stage, instance, component, created});
+	return created;
+}
+
+QList<QPair<LatencyMetrics::Entry, QSharedPointer<LatencyHistogram>>> LatencyMetrics::activeEntries() const
+{
+	QMutexLocker locker(&_mutex);
+
+	QList<QPair<Entry, QSharedPointer<LatencyHistogram>>> active;
+	for (auto it = _entries.begin(); it != _entries.end();)
+	{
+		QSharedPointer<LatencyHistogram> latency = it->histogram.toStrongRef();
+		if (latency.isNull())
+		{
+			it = _entries.erase(it);
+			continue;
+		}
+		active.append(qMakePair(*it, latency));
+		++it;
+	}
+	return active;
+}
+
+QJsonArray LatencyMetrics::toJson() const
+{
+	QJsonArray metrics;
+	for (const auto& [entry, latency] : activeEntries())
+	{
+		const LatencyHistogram::Snapshot snapshot = latency->snapshot();
+
+		QJsonObject metric;
+		metric["stage"] = entry.stage;
+		if (!entry.instance.isEmpty())
+		{
+			metric["instance"] = entry.instance;
+		}
+		if (!entry.component.isEmpty())
+		{
+			metric["component"] = entry.component;
+		}
+		metric["count"] = static_cast<qint64>(snapshot.count);
+		metric["mean_us"] = snapshot.count > 0 ? static_cast<qint64>(snapshot.sum_us / snapshot.count) : 0;
+		metric["p50_us"] = static_cast<qint64>(snapshot.percentile(0.50));
+		metric["p95_us"] = static_cast<qint64>(snapshot.percentile(0.95));
+		metric["p99_us"] = static_cast<qint64>(snapshot.percentile(0.99));
+		metric["max_us"] = static_cast<qint64>(snapshot.max_us);
+		metrics.append(metric);
+	}
+	return metrics;
+}
+
+QByteArray LatencyMetrics::toPrometheus() const
+{
+	QByteArray text;
+	text += "# HELP hyperion_latency_seconds Processing latency per stage, instance and component\n";
+	text += "# TYPE hyperion_latency_seconds histogram\n";
+
+	for (const auto& [entry, latency] : activeEntries())
+	{
+		const LatencyHistogram::Snapshot snapshot = latency->snapshot();
+
+		QByteArray labels = "stage=\"" + escapeLabelValue(entry.stage) + "\"";
+		if (!entry.instance.isEmpty())
+		{
+			// "instance" is set by Prometheus to the scraped target
+			labels += ",hyperion_instance=\"" + escapeLabelValue(entry.instance) + "\"";
+		}
+		if (!entry.component.isEmpty())
+		{
+			labels += ",component=\"" + escapeLabelValue(entry.component) + "\"";
+		}
+
+		quint64 cumulated = 0;
+		for (int bucket = 0; bucket < LatencyHistogram::BUCKET_COUNT - 1; ++bucket)
+		{
+			cumulated += snapshot.counts[bucket];
+			text += "hyperion_latency_seconds_bucket{" + labels + ",le=\"" + toSeconds(LatencyHistogram::bucketUpperBound_us(bucket)) + "\"} "
+					+ QByteArray::number(cumulated) + "\n";
+		}
+		text += "hyperion_latency_seconds_bucket{" + labels + ",le=\"+Inf\"} " + QByteArray::number(snapshot.count) + "\n";
+		text += "hyperion_latency_seconds_sum{" + labels + "} " + toSeconds(snapshot.sum_us) + "\n";
+		text += "hyperion_latency_seconds_count{" + labels + "} " + QByteArray::number(snapshot.count) + "\n";
+	}
+	return text;
+}
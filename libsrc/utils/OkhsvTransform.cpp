@@ -1,4 +1,7 @@
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <iterator>
 
 #include <utils/OkhsvTransform.h>
 #include <utils/ColorSys.h>
@@ -9,11 +12,266 @@ inline double clamp(double value)
 	return std::max(0.0, std::min(value, 1.0));
 }
 
+namespace {
+
+///
+/// Double precision port of the ok_color conversions used by the transform (Copyright (c) 2021 Björn Ottosson, MIT license).
+/// The conversion to Okhsv and back is fused: the hue is kept as normalised (a, b) vector, i.e. no trigonometric functions
+/// are evaluated, and the gamut cusp of the hue is determined once instead of twice.
+///
+namespace fast {
+
+struct Lab { double L; double a; double b; };
+struct LinearRgb { double r; double g; double b; };
+struct Cusp { double L; double C; };
+
+/// sRGB to linear light, per 8 bit value
+const std::array<double, 256>& decodingTable()
+{
+	static const std::array<double, 256> table = []() {
+		std::array<double, 256> decoding {};
+		for (size_t value = 0; value < decoding.size(); ++value)
+		{
+			const double srgb = static_cast<double>(value) / 255.0;
+			decoding[value] = srgb > 0.04045 ? std::pow((srgb + 0.055) / 1.055, 2.4) : srgb / 12.92;
+		}
+		return decoding;
+	}();
+	return table;
+}
+
+/// Linear light thresholds between two consecutive 8 bit sRGB values, i.e. where rounding switches to the next value
+const std::array<double, 255>& encodingThresholds()
+{
+	static const std::array<double, 255> table = []() {
+		std::array<double, 255> thresholds {};
+		for (size_t value = 0; value < thresholds.size(); ++value)
+		{
+			const double srgb = (static_cast<double>(value) + 0.5) / 255.0;
+			thresholds[value] = srgb > 0.04045 ? std::pow((srgb + 0.055) / 1.055, 2.4) : srgb / 12.92;
+		}
+		return thresholds;
+	}();
+	return table;
+}
+
+inline uint8_t encode(double linear)
+{
+	const std::array<double, 255>& thresholds = encodingThresholds();
+	return static_cast<uint8_t>(std::upper_bound(thresholds.cbegin(), thresholds.cend(), linear) - thresholds.cbegin());
+}
+
+inline Lab linearToOklab(const LinearRgb& c)
+{
+	const double l_ = std::cbrt(0.4122214708 * c.r + 0.5363325363 * c.g + 0.0514459929 * c.b);
+	const double m_ = std::cbrt(0.2119034982 * c.r + 0.6806995451 * c.g + 0.1073969566 * c.b);
+	const double s_ = std::cbrt(0.0883024619 * c.r + 0.2817188376 * c.g + 0.6299787005 * c.b);
+
+	return {
+		0.2104542553 * l_ + 0.7936177850 * m_ - 0.0040720468 * s_,
+		1.9779984951 * l_ - 2.4285922050 * m_ + 0.4505937099 * s_,
+		0.0259040371 * l_ + 0.7827717662 * m_ - 0.8086757660 * s_,
+	};
+}
+
+inline LinearRgb oklabToLinear(const Lab& c)
+{
+	const double l_ = c.L + 0.3963377774 * c.a + 0.2158037573 * c.b;
+	const double m_ = c.L - 0.1055613458 * c.a - 0.0638541728 * c.b;
+	const double s_ = c.L - 0.0894841775 * c.a - 1.2914855480 * c.b;
+
+	const double l = l_ * l_ * l_;
+	const double m = m_ * m_ * m_;
+	const double s = s_ * s_ * s_;
+
+	return {
+		+4.0767416621 * l - 3.3077115913 * m + 0.2309699292 * s,
+		-1.2684380046 * l + 2.6097574011 * m - 0.3413193965 * s,
+		-0.0041960863 * l - 0.7034186147 * m + 1.7076147010 * s,
+	};
+}
+
+/// Maximum saturation (C/L) of the normalised hue (a, b) within sRGB
+inline double maxSaturation(double a, double b)
+{
+	double k0, k1, k2, k3, k4, wl, wm, ws;
+	if (-1.88170328 * a - 0.80936493 * b > 1)
+	{
+		// Red component
+		k0 = +1.19086277; k1 = +1.76576728; k2 = +0.59662641; k3 = +0.75515197; k4 = +0.56771245;
+		wl = +4.0767416621; wm = -3.3077115913; ws = +0.2309699292;
+	}
+	else if (1.81444104 * a - 1.19445276 * b > 1)
+	{
+		// Green component
+		k0 = +0.73956515; k1 = -0.45954404; k2 = +0.08285427; k3 = +0.12541070; k4 = +0.14503204;
+		wl = -1.2684380046; wm = +2.6097574011; ws = -0.3413193965;
+	}
+	else
+	{
+		// Blue component
+		k0 = +1.35733652; k1 = -0.00915799; k2 = -1.15130210; k3 = -0.50559606; k4 = +0.00692167;
+		wl = -0.0041960863; wm = -0.7034186147; ws = +1.7076147010;
+	}
+
+	// Polynomial approximation refined by one step of Halley's method
+	double S = k0 + k1 * a + k2 * b + k3 * a * a + k4 * a * b;
+
+	const double k_l = +0.3963377774 * a + 0.2158037573 * b;
+	const double k_m = -0.1055613458 * a - 0.0638541728 * b;
+	const double k_s = -0.0894841775 * a - 1.2914855480 * b;
+
+	const double l_ = 1.0 + S * k_l;
+	const double m_ = 1.0 + S * k_m;
+	const double s_ = 1.0 + S * k_s;
+
+	const double f = wl * l_ * l_ * l_ + wm * m_ * m_ * m_ + ws * s_ * s_ * s_;
+	const double f1 = wl * 3.0 * k_l * l_ * l_ + wm * 3.0 * k_m * m_ * m_ + ws * 3.0 * k_s * s_ * s_;
+	const double f2 = wl * 6.0 * k_l * k_l * l_ + wm * 6.0 * k_m * k_m * m_ + ws * 6.0 * k_s * k_s * s_;
+
+	S = S - f * f1 / (f1 * f1 - 0.5 * f * f2);
+	return S;
+}
+
+inline Cusp findCusp(double a, double b)
+{
+	const double S_cusp = maxSaturation(a, b);
+	const LinearRgb rgbAtMax = oklabToLinear({ 1.0, S_cusp * a, S_cusp * b });
+	const double L_cusp = std::cbrt(1.0 / std::max(std::max(rgbAtMax.r, rgbAtMax.g), rgbAtMax.b));
+	return { L_cusp, L_cusp * S_cusp };
+}
+
+constexpr double TOE_K1 = 0.206;
+constexpr double TOE_K2 = 0.03;
+constexpr double TOE_K3 = (1.0 + TOE_K1) / (1.0 + TOE_K2);
+
+inline double toe(double x)
+{
+	return 0.5 * (TOE_K3 * x - TOE_K1 + std::sqrt((TOE_K3 * x - TOE_K1) * (TOE_K3 * x - TOE_K1) + 4 * TOE_K2 * TOE_K3 * x));
+}
+
+inline double toeInv(double x)
+{
+	return (x * x + TOE_K1 * x) / (TOE_K3 * (x + TOE_K2));
+}
+
+/// Lightness scale compensating the curved top of the gamut at (L_vt, C_vt)
+inline double scaleL(double L_vt, double C_vt, double a, double b)
+{
+	const LinearRgb rgbScale = oklabToLinear({ L_vt, a * C_vt, b * C_vt });
+	return std::cbrt(1.0 / std::max(std::max(rgbScale.r, rgbScale.g), std::max(rgbScale.b, 0.0)));
+}
+
+void transform(uint8_t& red, uint8_t& green, uint8_t& blue, double saturationGain, double brightnessGain)
+{
+	if ((red | green | blue) == 0)
+	{
+		return;
+	}
+
+	const std::array<double, 256>& decoding = decodingTable();
+	const Lab lab = linearToOklab({ decoding[red], decoding[green], decoding[blue] });
+
+	// Grays have no hue, any hue gives a zero saturation
+	const double C = std::sqrt(lab.a * lab.a + lab.b * lab.b);
+	const double a_ = C > 1e-12 ? lab.a / C : 1.0;
+	const double b_ = C > 1e-12 ? lab.b / C : 0.0;
+
+	const Cusp cusp = findCusp(a_, b_);
+	const double S_max = cusp.C / cusp.L;
+	const double T_max = cusp.C / (1.0 - cusp.L);
+	constexpr double S_0 = 0.5;
+	const double k = 1.0 - S_0 / S_max;
+
+	// Okhsv saturation and value
+	const double t = T_max / (C + lab.L * T_max);
+	const double L_v = t * lab.L;
+	const double C_v = t * C;
+	const double L_vt = toeInv(L_v);
+	const double C_vt = C_v * L_vt / L_v;
+	const double L = toe(lab.L / scaleL(L_vt, C_vt, a_, b_));
+
+	const double saturation = std::clamp((S_0 + T_max) * C_v / ((T_max * S_0) + T_max * k * C_v) * saturationGain, 0.0, 1.0);
+	const double value = std::clamp(L / L_v * brightnessGain, 0.0, 1.0);
+	if (value <= 0.0)
+	{
+		red = green = blue = 0;
+		return;
+	}
+
+	// ... and back for the same hue
+	const double divisor = S_0 + T_max - T_max * k * saturation;
+	const double L_v2 = 1.0 - saturation * S_0 / divisor;
+	const double C_v2 = saturation * T_max * S_0 / divisor;
+	const double L_vt2 = toeInv(L_v2);
+	const double C_vt2 = C_v2 * L_vt2 / L_v2;
+
+	const double L_linear = value * L_v2;
+	const double L_new = toeInv(L_linear);
+	const double scale = scaleL(L_vt2, C_vt2, a_, b_);
+	const double L2 = L_new * scale;
+	const double C2 = value * C_v2 * L_new / L_linear * scale;
+
+	const LinearRgb rgb = oklabToLinear({ L2, C2 * a_, C2 * b_ });
+	red = encode(rgb.r);
+	green = encode(rgb.g);
+	blue = encode(rgb.b);
+}
+
+} // namespace fast
+
+/// Transforms the color through the generic ok_color conversions to Okhsv and back
+void referenceTransform(uint8_t& red, uint8_t& green, uint8_t& blue, double saturationGain, double brightnessGain)
+{
+	double hue;
+	double saturation;
+	double brightness;
+	ColorSys::rgb2okhsv(red, green, blue, hue, saturation, brightness);
+
+	saturation = clamp(saturation * saturationGain);
+	brightness = clamp(brightness * brightnessGain);
+
+	ColorSys::okhsv2rgb(hue, saturation, brightness, red, green, blue);
+}
+
+///
+/// Validates that the fast implementation matches the reference for a grid of colors and some gains,
+/// e.g. compilers or platforms with relaxed floating point may not.
+///
+bool isFastImplementationValid()
+{
+	const std::array<std::array<double, 2>, 3> gains {{ {1.5, 1.2}, {0.5, 0.8}, {2.0, 1.0} }};
+	for (const auto& gain : gains)
+	{
+		for (int red = 0; red <= UINT8_MAX; red += 17)
+		{
+			for (int green = 0; green <= UINT8_MAX; green += 17)
+			{
+				for (int blue = 0; blue <= UINT8_MAX; blue += 17)
+				{
+					uint8_t reference[3] = {static_cast<uint8_t>(red), static_cast<uint8_t>(green), static_cast<uint8_t>(blue)};
+					uint8_t fast[3] = {reference[0], reference[1], reference[2]};
+					referenceTransform(reference[0], reference[1], reference[2], gain[0], gain[1]);
+					fast::transform(fast[0], fast[1], fast[2], gain[0], gain[1]);
+					if (!std::equal(std::begin(reference), std::end(reference), std::begin(fast)))
+					{
+						return false;
+					}
+				}
+			}
+		}
+	}
+	return true;
+}
+
+} // namespace
+
 OkhsvTransform::OkhsvTransform()
 {
 	_saturationGain = 1.0;
 	_brightnessGain = 1.0;
 	_isIdentity = true;
+	_implementation = implementation();
 }
 
 OkhsvTransform::OkhsvTransform(double saturationGain, double brightnessGain)
@@ -21,6 +279,7 @@ OkhsvTransform::OkhsvTransform(double saturationGain, double brightnessGain)
 	_saturationGain = saturationGain;
 	_brightnessGain = brightnessGain;
 	updateIsIdentity();
+	_implementation = implementation();
 }
 
 double OkhsvTransform::getSaturationGain() const
@@ -50,17 +309,27 @@ bool OkhsvTransform::isIdentity() const
 	return _isIdentity;
 }
 
-void OkhsvTransform::transform(uint8_t & red, uint8_t & green, uint8_t & blue) const
+OkhsvTransform::Implementation OkhsvTransform::implementation()
 {
-	double hue;
-	double saturation;
-	double brightness;
-	ColorSys::rgb2okhsv(red, green, blue, hue, saturation, brightness);
+	static const Implementation selected = isFastImplementationValid() ? Implementation::Fast : Implementation::Reference;
+	return selected;
+}
 
-	saturation = clamp(saturation * _saturationGain);
-	brightness = clamp(brightness * _brightnessGain);
+void OkhsvTransform::transform(uint8_t & red, uint8_t & green, uint8_t & blue) const
+{
+	transform(red, green, blue, _implementation);
+}
 
-	ColorSys::okhsv2rgb(hue, saturation, brightness, red, green, blue);
+void OkhsvTransform::transform(uint8_t & red, uint8_t & green, uint8_t & blue, Implementation implementation) const
+{
+	if (implementation == Implementation::Fast)
+	{
+		fast::transform(red, green, blue, _saturationGain, _brightnessGain);
+	}
+	else
+	{
+		referenceTransform(red, green, blue, _saturationGain, _brightnessGain);
+	}
 }
 
 void OkhsvTransform::updateIsIdentity()
@@ -198,6 +198,19 @@ void RgbTransform::applyBacklight(uint8_t & red, uint8_t & green, uint8_t & blue
 	}
 }
 
+void RgbTransform::applyBacklight(ColorRgb* colors, int count) const
+{
+	if (!_backLightEnabled || _brightnessLow == 0)
+	{
+		return;
+	}
+
+	for (ColorRgb* color = colors; color != colors + count; ++color)
+	{
+		applyBacklight(color->red, color->green, color->blue);
+	}
+}
+
 void RgbTransform::setTemperature(int temperature)
 {
 	_temperature = temperature;
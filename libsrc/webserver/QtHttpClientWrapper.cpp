@@ -7,6 +7,8 @@
 #include <QLoggingCategory>
 
 #include <utils/QStringUtils.h>
+#include <utils/LatencyMetrics.h>
+#include <hyperion/AuthManager.h>
 
 #include "QtHttpClientWrapper.h"
 #include "QtHttpRequest.h"
@@ -70,6 +72,57 @@ void QtHttpClientWrapper::injectCorsHeaders(QtHttpReply* reply) const
 		reply->addHeader(QtHttpHeader::AccessControlAllowHeaders, "Authorization, Content-Type");
 }
 
+void QtHttpClientWrapper::replyMetrics(QtHttpReply* reply) const
+{
+	if (!isTokenAuthorized())
+	{
+		reply->setStatusCode(QtHttpReply::Forbidden);
+		reply->addHeader("Content-Type", "text/plain");
+		reply->appendRawData(QByteArrayLiteral("No Authorization"));
+		return;
+	}
+
+	reply->addHeader("Content-Type", "text/plain; version=0.0.4");
+	reply->appendRawData(LatencyMetrics::getInstance().toPrometheus());
+}
+
+bool QtHttpClientWrapper::isTokenAuthorized() const
+{
+	const QSharedPointer<AuthManager> auth = AuthManager::getInstanceWeak().toStrongRef();
+	if (auth.isNull())
+	{
+		return false;
+	}
+
+	// local requests do not require a token, if authorization is disabled for local requests
+	if (m_localConnection && !auth->isLocalAuthRequired())
+	{
+		return true;
+	}
+
+	const QString header = QString::fromUtf8(m_currentRequest->getHeader(QtHttpHeader::Authorization)).trimmed();
+	QString token;
+	if (header.startsWith(QLatin1String("Bearer"), Qt::CaseInsensitive))
+	{
+		token = header.mid(6).trimmed();
+	}
+	else if (header.startsWith(QLatin1String("token"), Qt::CaseInsensitive))
+	{
+		token = header.mid(5).trimmed();
+	}
+
+	if (token.isEmpty())
+	{
+		return false;
+	}
+
+	bool isAuthorized = false;
+	(auth->thread() != this->thread())
+		? QMetaObject::invokeMethod(auth.get(), "isTokenAuthorized", Qt::BlockingQueuedConnection, Q_RETURN_ARG(bool, isAuthorized), Q_ARG(QString, token))
+		: isAuthorized = auth->isTokenAuthorized(token);
+	return isAuthorized;
+}
+
 void QtHttpClientWrapper::onClientDataReceived (void)
 {
 	if (m_sockClient != Q_NULLPTR && m_sockClient->isOpen())
@@ -275,7 +328,16 @@ void QtHttpClientWrapper::onClientDataReceived (void)
 				connect(&reply, &QtHttpReply::requestSendHeaders, this, &QtHttpClientWrapper::onReplySendHeadersRequested, Qt::UniqueConnection);
 				connect(&reply, &QtHttpReply::requestSendData, this, &QtHttpClientWrapper::onReplySendDataRequested, Qt::UniqueConnection);
 
-				emit m_serverHandle->requestNeedsReply (m_currentRequest, &reply); // allow app to handle request
+				// processing latencies, served here as the authorization depends on the connection
+				const QStringList uri_parts = QStringUtils::split(m_currentRequest->getUrl ().path (),'/', QStringUtils::SplitBehavior::SkipEmptyParts);
+				if ( m_currentRequest->getCommand() == "GET" && ! uri_parts.empty() && uri_parts.at(0) == "metrics" )
+				{
+					replyMetrics(&reply);
+				}
+				else
+				{
+					emit m_serverHandle->requestNeedsReply (m_currentRequest, &reply); // allow app to handle request
+				}
 				m_parsingStatus = sendReplyToClient (&reply);
 
 				break;
@@ -72,6 +72,17 @@ private:
 
 	void injectCorsHeaders(QtHttpReply* reply) const;
 
+	///
+	/// Replies the processing latencies in the Prometheus text exposition format,
+	/// with the same authorization as the JSON-RPC command "metrics"
+	///
+	void replyMetrics(QtHttpReply* reply) const;
+
+	///
+	/// @return True, if the current request is authorized by a token or as local connection without local authorization
+	///
+	bool isTokenAuthorized() const;
+
 	QString           m_guid;
 	ParsingStatus     m_parsingStatus;
 	QTcpSocket    *   m_sockClient;
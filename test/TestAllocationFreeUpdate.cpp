@@ -0,0 +1,98 @@
+// STL includes
+#include <algorithm>
+#include <iostream>
+#include <memory>
+
+// Qt includes
+#include <QLoggingCategory>
+
+// Utils includes
+#include <utils/Image.h>
+#include <utils/Logger.h>
+#include <utils/MemoryTracker.h>
+
+// Hyperion includes
+#include <utils/hyperion.h>
+#include <hyperion/ImageToLedsMap.h>
+#include <hyperion/LedColorBuffers.h>
+#include <hyperion/MultiColorAdjustment.h>
+#include <hyperion/LedOutputPipeline.h>
+
+// Test includes
+#include "TestCheck.h"
+#include "TestLedLayout.h"
+
+// Count heap allocations to verify that the LED update path does not allocate after warm-up
+INSTALL_HEAP_ALLOCATION_TRACKING()
+
+int main()
+{
+#if HEAP_ALLOCATION_TRACKING_SUPPORTED
+	QSharedPointer<Logger> log = Logger::getInstance("TestAllocationFreeUpdate");
+	Logger::setLogLevel(Logger::LogLevel::Debug);
+
+	const LedString ledString = createBorderLedString();
+	bool isOk = true;
+
+	// Debug output allocates, as it does in production when tracing is enabled
+	QLoggingCategory::setFilterRules("*.debug = false");
+
+	// The LED update path (mapping, adjustment and double buffered hand-over to receivers).
+	// Queued signal delivery to the receivers is not part of it, Qt allocates an event per queued call.
+	const int ledCount = static_cast<int>(ledString.leds().size());
+	const Image<ColorRgb> image = createRandomImage(160, 90);
+	const hyperion::ImageToLedsMap map(log, 160, 90, 0, 0, ledString.leds());
+	const std::unique_ptr<MultiColorAdjustment> adjustment(hyperion::createLedColorsAdjustment(ledCount, createColorConfig()));
+	hyperion::LedOutputPipeline ledOutput;
+	ledOutput.compile(QVector<ColorOrder>(ledCount, ColorOrder::ORDER_GRB), ledString.blacklistedLedIds(), adjustment.get());
+
+	hyperion::LedColorBuffers rawLedColors(ledCount);
+	hyperion::LedColorBuffers ledBuffer(ledCount);
+
+	// Frames held by (queued) receivers until the next frame is emitted
+	QVector<ColorRgb> rawReceived;
+	QVector<ColorRgb> deviceReceived;
+
+	const auto processFrame = [&]() {
+		QVector<ColorRgb>& ledColors = rawLedColors.next();
+		map.getMeanLedColor(image, ledColors);
+		rawReceived = ledColors;
+
+		QVector<ColorRgb>& deviceColors = ledBuffer.next();
+		std::copy_n(ledColors.cbegin(), ledColors.size(), deviceColors.begin());
+		ledOutput.apply(deviceColors);
+		deviceReceived = deviceColors;
+	};
+
+	for (int frame = 0; frame < 10; ++frame)
+	{
+		processFrame();
+	}
+
+	// No allocations after warm-up
+	const quint64 allocationsBefore = memorytracker::heapAllocations();
+	for (int frame = 0; frame < 100; ++frame)
+	{
+		processFrame();
+	}
+	const quint64 allocations = memorytracker::heapAllocations() - allocationsBefore;
+	std::cout << allocations << " allocation(s) in 100 frames" << '\n';
+	isOk &= check(allocations == 0, "update is allocation free");
+	isOk &= check(rawLedColors.detachCount() == 0 && ledBuffer.detachCount() == 0, "buffers are not detached");
+
+	// A receiver holding a frame longer keeps its colors, the buffer is copied once
+	const QVector<ColorRgb> held = rawLedColors.current();
+	const QVector<ColorRgb> expected(held.cbegin(), held.cend());
+	for (const ColorRgb& color : {ColorRgb::WHITE, ColorRgb::RED})
+	{
+		QVector<ColorRgb>& ledColors = rawLedColors.next();
+		std::fill(ledColors.begin(), ledColors.end(), color);
+	}
+	isOk &= check(held == expected && rawLedColors.detachCount() == 1, "held frame is unchanged");
+
+	return isOk ? 0 : -1;
+#else
+	std::cout << "heap allocation tracking not supported, skipped" << '\n';
+	return 0;
+#endif
+}
@@ -0,0 +1,20 @@
+#ifndef TESTCHECK_H
+#define TESTCHECK_H
+
+// STL includes
+#include <iostream>
+
+///
+/// Prints the result of a check
+///
+/// @param condition The result of the check
+/// @param description What was checked
+/// @return The result of the check, to be accumulated into the exit code of the test
+///
+inline bool check(bool condition, const char* description)
+{
+	std::cout << description << ": " << (condition ? "ok" : "FAILED") << '\n';
+	return condition;
+}
+
+#endif // TESTCHECK_H
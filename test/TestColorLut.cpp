@@ -0,0 +1,95 @@
+// STL includes
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+// Utils includes
+#include <utils/Logger.h>
+
+// Hyperion includes
+#include <utils/hyperion.h>
+#include <hyperion/MultiColorAdjustment.h>
+#include <hyperion/ColorLut.h>
+
+// Test includes
+#include "TestCheck.h"
+#include "TestLedLayout.h"
+
+int main()
+{
+	QSharedPointer<Logger> log = Logger::getInstance("TestColorLut");
+	Logger::setLogLevel(Logger::LogLevel::Debug);
+
+	bool isOk = true;
+
+	const std::unique_ptr<MultiColorAdjustment> adjustment(hyperion::createLedColorsAdjustment(1, createColorConfig()));
+	if (!check(!adjustment->getAdjustments().isEmpty(), "adjustment is configured"))
+	{
+		return -1;
+	}
+
+	// The configured adjustment, with gamma and calibration, and the same with OkHSV transform (raw color grid)
+	ColorAdjustment calibrated = *adjustment->getAdjustments().first();
+	calibrated._rgbTransform.setGamma(2.2, 2.0, 1.8);
+	calibrated._rgbTransform.setTemperature(4500);
+	calibrated._rgbRedAdjustment.setAdjustment(255, 20, 0);
+	calibrated._rgbWhiteAdjustment.setAdjustment(250, 240, 200);
+	ColorAdjustment saturated = calibrated;
+	saturated._okhsvTransform.setSaturationGain(1.5);
+	saturated._okhsvTransform.setBrightnessGain(1.2);
+
+	// The baked tables are accurate against the calculated color adjustment
+	for (ColorAdjustment* colorAdjustment : {adjustment->getAdjustments().first(), &calibrated, &saturated})
+	{
+		colorAdjustment->_lut.reset();
+		const QSharedPointer<const hyperion::ColorLut> lut = hyperion::ColorLut::bake(*colorAdjustment);
+
+		int maxError = 0;
+		uint64_t errorSum = 0;
+		uint64_t colorCount = 0;
+		for (int red = 0; red <= UINT8_MAX; red += 3)
+		{
+			for (int green = 0; green <= UINT8_MAX; green += 3)
+			{
+				for (int blue = 0; blue <= UINT8_MAX; blue += 3, ++colorCount)
+				{
+					ColorRgb expected {static_cast<uint8_t>(red), static_cast<uint8_t>(green), static_cast<uint8_t>(blue)};
+					ColorRgb color = expected;
+					MultiColorAdjustment::calculateAdjustment(*colorAdjustment, expected);
+					lut->apply(color);
+
+					const int error = std::max({std::abs(color.red - expected.red), std::abs(color.green - expected.green), std::abs(color.blue - expected.blue)});
+					maxError = std::max(maxError, error);
+					errorSum += static_cast<uint64_t>(error);
+				}
+			}
+		}
+
+		// The calculation truncates per channel adjustment, i.e. it is off by some units itself.
+		// The finer grid covers the raw color, the OkHSV transform and the gamma are interpolated there.
+		const double meanError = static_cast<double>(errorSum) / static_cast<double>(colorCount);
+		const int maxErrorBound = lut->gridSize() == 33 ? 3 : 5;
+		std::cout << "Color lookup table (" << lut->gridSize() << "^3): max. error " << maxError << ", mean error " << meanError << '\n';
+		isOk &= check(maxError <= maxErrorBound, ("color lookup table (" + std::to_string(lut->gridSize()) + "^3) max. error is within " + std::to_string(maxErrorBound)).c_str());
+		isOk &= check(meanError < 1.0, "color lookup table mean error is below one");
+
+		// The per LED adjustment uses the table, once assigned
+		ColorRgb viaTable {200, 100, 50};
+		ColorRgb viaLut = viaTable;
+		colorAdjustment->_lut = lut;
+		MultiColorAdjustment::applyAdjustment(*colorAdjustment, viaTable);
+		lut->apply(viaLut);
+		colorAdjustment->_rgbTransform.applyBacklight(viaLut.red, viaLut.green, viaLut.blue);
+		isOk &= check(viaTable == viaLut, "adjustment uses the assigned table");
+	}
+
+	// Tables are reused for unchanged settings only
+	const hyperion::ColorLut::Settings settings(calibrated);
+	isOk &= check(settings == hyperion::ColorLut::Settings(calibrated), "unchanged settings are equal");
+	calibrated._rgbTransform.setBrightness(50);
+	isOk &= check(settings != hyperion::ColorLut::Settings(calibrated), "changed settings differ");
+
+	return isOk ? 0 : -1;
+}
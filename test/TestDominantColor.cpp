@@ -0,0 +1,61 @@
+// STL includes
+#include <string>
+
+// Utils includes
+#include <utils/Image.h>
+#include <utils/Logger.h>
+
+// Hyperion includes
+#include <hyperion/ImageToLedsMap.h>
+#include <hyperion/ColorHistogram.h>
+
+// Test includes
+#include "TestCheck.h"
+#include "TestLedLayout.h"
+
+int main()
+{
+	QSharedPointer<Logger> log = Logger::getInstance("TestDominantColor");
+	Logger::setLogLevel(Logger::LogLevel::Debug);
+
+	const LedString ledString = createBorderLedString();
+	bool isOk = true;
+
+	const int width = 64;
+	const int height = 64;
+	const ColorRgb dominantColor {200, 40, 40};
+	const ColorRgb similarColor {201, 41, 41};
+	const ColorRgb otherColor {0, 0, 255};
+
+	// 40% dominant color, 35% a similar shade, 20% another color, 5% noise
+	Image<ColorRgb> image = createRandomImage(width, height);
+	ColorRgb* pixel = image.memptr();
+	for (int idx = 0; idx < width * height; ++idx)
+	{
+		const int share = idx % 20;
+		if (share < 8)
+		{
+			pixel[idx] = dominantColor;
+		}
+		else if (share < 15)
+		{
+			pixel[idx] = similarColor;
+		}
+		else if (share < 19)
+		{
+			pixel[idx] = otherColor;
+		}
+	}
+
+	// The dominant color is the most frequent exact color inside the most frequent histogram bin
+	hyperion::ImageToLedsMap map(log, width, height, 0, 0, ledString.leds());
+	for (int bits = hyperion::ColorHistogram::MIN_BITS_PER_CHANNEL; bits <= hyperion::ColorHistogram::MAX_BITS_PER_CHANNEL; ++bits)
+	{
+		map.setDominantColorBits(bits);
+		const QVector<ColorRgb> ledColors = map.getDominantUniLedColor(image);
+		const std::string description = "dominant color [" + std::to_string(bits) + " bits]";
+		isOk &= check(!ledColors.isEmpty() && ledColors.first() == dominantColor, description.c_str());
+	}
+
+	return isOk ? 0 : -1;
+}
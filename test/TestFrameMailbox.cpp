@@ -0,0 +1,112 @@
+// STL includes
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// Hyperion includes
+#include <utils/FrameMailbox.h>
+
+// Test includes
+#include "TestCheck.h"
+
+namespace {
+
+struct Frame
+{
+	int producer {-1};
+	int sequence {-1};
+	std::vector<int> payload;
+};
+
+} // namespace
+
+int main()
+{
+	bool isOk = true;
+
+	// A slow consumer gets the newest frame only
+	{
+		FrameMailbox<Frame> mailbox;
+		isOk &= check(mailbox.post({ 0, 0, {} }), "first post notifies the consumer");
+		isOk &= check(!mailbox.post({ 0, 1, {} }) && !mailbox.post({ 0, 2, {} }), "posts of pending frames do not notify");
+
+		Frame frame;
+		isOk &= check(mailbox.take(frame) && frame.sequence == 2, "newest frame is taken");
+		isOk &= check(!mailbox.take(frame), "mailbox is empty after taking");
+		isOk &= check(mailbox.counters().posted == 3 && mailbox.counters().dropped == 2, "replaced frames are counted as dropped");
+	}
+
+	// Concurrent producers: every frame is either taken or dropped, frames of a producer are taken in order
+	{
+		constexpr int PRODUCERS = 4;
+		constexpr int FRAMES = 100000;
+
+		std::atomic<int> notifications {0};
+		std::atomic<int> finished {0};
+		FrameInbox<Frame> inbox(PRODUCERS, [&notifications](int) { notifications.fetch_add(1); });
+
+		std::vector<std::thread> producers;
+		for (int producer = 0; producer < PRODUCERS; ++producer)
+		{
+			producers.emplace_back([&inbox, &finished, producer]() {
+				for (int sequence = 0; sequence < FRAMES; ++sequence)
+				{
+					inbox.post(producer, { producer, sequence, std::vector<int>(16, sequence) });
+				}
+				finished.fetch_add(1);
+			});
+		}
+
+		std::vector<int> lastSequence(PRODUCERS, -1);
+		int taken = 0;
+		bool isOrdered = true;
+		bool isIntact = true;
+		const auto consume = [&]() {
+			Frame frame;
+			for (int slot = 0; slot < PRODUCERS; ++slot)
+			{
+				while (inbox.take(slot, frame))
+				{
+					isOrdered &= frame.producer == slot && frame.sequence > lastSequence[static_cast<size_t>(slot)];
+					isIntact &= frame.payload.size() == 16 && frame.payload.front() == frame.sequence;
+					lastSequence[static_cast<size_t>(slot)] = frame.sequence;
+					++taken;
+				}
+			}
+		};
+
+		while (finished.load() < PRODUCERS)
+		{
+			consume();
+		}
+		for (auto& producer : producers)
+		{
+			producer.join();
+		}
+		consume();
+
+		quint64 dropped = 0;
+		bool isComplete = true;
+		for (int slot = 0; slot < PRODUCERS; ++slot)
+		{
+			const FrameCounters counters = inbox.counters(slot);
+			dropped += counters.dropped;
+			isComplete &= counters.posted == FRAMES && lastSequence[static_cast<size_t>(slot)] == FRAMES - 1;
+		}
+
+		isOk &= check(isOrdered && isIntact, "frames are taken intact and in order");
+		isOk &= check(isComplete, "last frame of every producer is taken");
+		isOk &= check(static_cast<quint64>(taken) + dropped == static_cast<quint64>(PRODUCERS) * FRAMES, "every frame is taken or dropped");
+		isOk &= check(notifications.load() == taken, "consumer is notified once per frame taken");
+
+		std::cout << "taken " << taken << ", dropped " << dropped << '\n';
+
+		// no notifications after closing
+		inbox.close();
+		inbox.post(0, { 0, FRAMES, {} });
+		isOk &= check(notifications.load() == taken, "closed inbox does not notify");
+	}
+
+	return isOk ? 0 : -1;
+}
@@ -0,0 +1,73 @@
+// STL includes
+#include <vector>
+
+// Hyperion includes
+#include <utils/FrameRing.h>
+
+// Test includes
+#include "TestCheck.h"
+
+namespace {
+
+struct Frame
+{
+	int sequence {-1};
+	std::vector<int> payload;
+};
+
+} // namespace
+
+int main()
+{
+	bool isOk = true;
+
+	// FIFO order across the wrap-around, slots and their buffers are reused
+	{
+		FrameRing<Frame> ring(4);
+		const int* buffers[4] {};
+		for (int sequence = 0; sequence < 4; ++sequence)
+		{
+			Frame& frame = ring.pushBack();
+			frame.sequence = sequence;
+			frame.payload.assign(64, sequence);
+			buffers[sequence] = frame.payload.data();
+		}
+		isOk &= check(ring.size() == 4 && ring.front().sequence == 0 && ring.back().sequence == 3, "frames are queued in order");
+
+		ring.popFront(3);
+		bool isReused = true;
+		for (int sequence = 4; sequence < 7; ++sequence)
+		{
+			Frame& frame = ring.pushBack();
+			frame.sequence = sequence;
+			frame.payload.assign(64, sequence);
+			isReused &= frame.payload.data() == buffers[sequence - 4];
+		}
+		isOk &= check(isReused && ring.capacity() == 4, "buffers of removed frames are reused without growing");
+
+		bool isOrdered = true;
+		for (size_t i = 0; i < ring.size(); ++i)
+		{
+			isOrdered &= ring[i].sequence == static_cast<int>(i) + 3 && ring[i].payload.front() == ring[i].sequence;
+		}
+		isOk &= check(ring.size() == 4 && isOrdered, "frames are indexed from the oldest across the wrap-around");
+	}
+
+	// A full ring grows, shrinking keeps the newest frames
+	{
+		FrameRing<Frame> ring(2);
+		for (int sequence = 0; sequence < 5; ++sequence)
+		{
+			ring.pushBack().sequence = sequence;
+		}
+		isOk &= check(ring.capacity() == 8 && ring.size() == 5 && ring.front().sequence == 0 && ring.back().sequence == 4, "full ring doubles its capacity");
+
+		ring.setCapacity(3);
+		isOk &= check(ring.capacity() == 3 && ring.size() == 3 && ring.front().sequence == 2 && ring.back().sequence == 4, "shrinking keeps the newest frames");
+
+		ring.clear();
+		isOk &= check(ring.empty() && ring.capacity() == 3, "clear keeps the slots");
+	}
+
+	return isOk ? 0 : -1;
+}
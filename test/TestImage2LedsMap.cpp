@@ -1,32 +1,117 @@
 
+// STL includes
+#include <algorithm>
+#include <iostream>
+#include <string>
+
 // Utils includes
 #include <utils/Image.h>
-#include <utils/jsonschema/QJsonFactory.h>
 #include <utils/Logger.h>
 
 // Hyperion includes
-#include <utils/hyperion.h>
 #include <hyperion/ImageToLedsMap.h>
+#include <hyperion/ImageToLedsMapKernels.h>
+#include <hyperion/ColorHistogram.h>
+#include <hyperion/ImageToLedsMapCache.h>
 
-int main()
+// Test includes
+#include "TestCheck.h"
+#include "TestLedLayout.h"
+
+///
+/// Verify that the LED areas address the pixel rows with the full image width while a black border is detected
+///
+bool verifyBorderRows(const QSharedPointer<Logger>& log, const LedString& ledString)
 {
-	QSharedPointer<Logger> log = Logger::getInstance("TestImageLedsMap");
-	Logger::setLogLevel(Logger::LogLevel::Debug);
+	const int width = 100;
+	const int height = 60;
+	const int horizontalBorder = 5;
+	const int verticalBorder = 10;
+	const ColorRgb testColor = {64, 123, 12};
+
+	// Black borders around the picture
+	Image<ColorRgb> image(width, height, ColorRgb::BLACK);
+	for (int y = horizontalBorder; y < height - horizontalBorder; ++y)
+	{
+		for (int x = verticalBorder; x < width - verticalBorder; ++x)
+		{
+			image(x, y) = testColor;
+		}
+	}
+
+	const hyperion::ImageToLedsMap map(log, width, height, horizontalBorder, verticalBorder, ledString.leds());
+	const QVector<ColorRgb> ledColors = map.getMeanLedColor(image);
+
+	return check(std::all_of(ledColors.cbegin(), ledColors.cend() - 1, [&](const ColorRgb& color) { return color == testColor; }),
+				 "LED areas inside the black border");
+}
 
-	const QString schemaFile = ":/hyperion-schema";
-	const QString configFile = ":/hyperion_default.config";
+///
+/// Verify that the vectorised accumulation kernels give bit-exact results compared to the scalar reference
+///
+bool verifyKernels(const QSharedPointer<Logger>& log, const LedString& ledString)
+{
+	bool isOk = true;
 
+	// Use a width not being a multiple of the SIMD block size and saturated pixels to cover the overflow handling
+	const int width = 1921;
+	const int height = 37;
+	Image<ColorRgb> image = createRandomImage(width, height);
+	for (int x = 0; x < width; ++x)
+	{
+		image(x, 0) = ColorRgb::WHITE;
+	}
 
-	QJsonObject config;
-	if (QJsonFactory::load(schemaFile, configFile, config) < 0)
+	QVector<hyperion::PixelSpan> spans;
+	for (int row = 0; row < height; ++row)
 	{
-		std::cerr << "UNABLE TO LOAD CONFIGURATION" << '\n';
-		return -1;
+		spans.append(hyperion::PixelSpan{row, row % 17, width - (row % 5)});
 	}
+	spans.append(hyperion::PixelSpan{0, 0, width * height});
+
+	const hyperion::kernels::AccumulateKernels& scalar = hyperion::kernels::scalarKernels();
+	hyperion::kernels::ChannelSums refSum;
+	hyperion::kernels::ChannelSums refSumSquared;
+	scalar.sum(image.memptr(), width, spans.constData(), static_cast<int>(spans.size()), refSum);
+	scalar.sumSquared(image.memptr(), width, spans.constData(), static_cast<int>(spans.size()), refSumSquared);
 
-	QJsonArray const ledLayout = config["leds"].toArray();
-	ColorOrder const colorOrder = hyperion::createColorOrder(config["device"].toObject()["colorOrder"].toString("rgb"));
-	const LedString ledString = LedString::createLedString(ledLayout, colorOrder, static_cast<int>(ledLayout.size()) );
+	hyperion::ImageToLedsMap map(log, width, height, 0, 0, ledString.leds());
+	map.setAccumulateKernels(scalar);
+	const QVector<ColorRgb> refMean = map.getMeanLedColor(image);
+	const QVector<ColorRgb> refMeanSqrt = map.getMeanSqrtLedColor(image);
+	const QVector<ColorRgb> refUni = map.getUniLedColor(image);
+
+	for (const hyperion::kernels::AccumulateKernels* kernels : hyperion::kernels::availableKernels())
+	{
+		hyperion::kernels::ChannelSums sum;
+		hyperion::kernels::ChannelSums sumSquared;
+		kernels->sum(image.memptr(), width, spans.constData(), static_cast<int>(spans.size()), sum);
+		kernels->sumSquared(image.memptr(), width, spans.constData(), static_cast<int>(spans.size()), sumSquared);
+
+		map.setAccumulateKernels(*kernels);
+
+		const std::string name = std::string("Kernels [") + kernels->name + "] ";
+		isOk &= check(sum.red == refSum.red && sum.green == refSum.green && sum.blue == refSum.blue,
+					  (name + "sums are bit-exact").c_str());
+		isOk &= check(sumSquared.red == refSumSquared.red && sumSquared.green == refSumSquared.green && sumSquared.blue == refSumSquared.blue,
+					  (name + "squared sums are bit-exact").c_str());
+		isOk &= check(map.getMeanLedColor(image) == refMean, (name + "mean colors are bit-exact").c_str());
+		isOk &= check(map.getMeanSqrtLedColor(image) == refMeanSqrt, (name + "mean squared colors are bit-exact").c_str());
+		isOk &= check(map.getUniLedColor(image) == refUni, (name + "unicolors are bit-exact").c_str());
+	}
+	return isOk;
+}
+
+int main()
+{
+	QSharedPointer<Logger> log = Logger::getInstance("TestImageLedsMap");
+	Logger::setLogLevel(Logger::LogLevel::Debug);
+
+	// LEDs along the borders and a blacklisted one, built in code as the default configuration has a single LED only
+	const LedString ledString = createBorderLedString();
+	std::cout << "LEDs: " << ledString.leds().size() << ", blacklisted: " << ledString.blacklistedLedIds().size() << '\n';
+
+	bool isOk = true;
 
 	const ColorRgb testColor = {64, 123, 12};
 
@@ -43,5 +128,12 @@ int main()
 	}
 	std::cout << "]" << '\n';
 
-	return 0;
+	// Every LED with an area has the color of the uniform image, the one without is black
+	isOk &= check(std::all_of(ledColors.cbegin(), ledColors.cend() - 1, [&](const ColorRgb& color) { return color == testColor; })
+				  && ledColors.last() == ColorRgb::BLACK, "mean colors of a uniform image");
+
+	isOk &= verifyBorderRows(log, ledString);
+	isOk &= verifyKernels(log, ledString);
+
+	return isOk ? 0 : -1;
 }
@@ -0,0 +1,43 @@
+// Utils includes
+#include <utils/Logger.h>
+
+// Hyperion includes
+#include <hyperion/ImageToLedsMap.h>
+#include <hyperion/ImageToLedsMapCache.h>
+
+// Test includes
+#include "TestCheck.h"
+#include "TestLedLayout.h"
+
+int main()
+{
+	QSharedPointer<Logger> log = Logger::getInstance("TestImage2LedsMapCache");
+	Logger::setLogLevel(Logger::LogLevel::Debug);
+
+	const LedString ledString = createBorderLedString();
+	bool isOk = true;
+
+	hyperion::ImageToLedsMapCache cache(2);
+	const size_t layoutHash = hyperion::ImageToLedsMapCache::layoutHash(ledString.leds());
+
+	int builtMaps = 0;
+	const auto getMap = [&](int width, int height, int horizontalBorder) {
+		const hyperion::ImageToLedsMapCache::Key key {width, height, horizontalBorder, 0, layoutHash, 0, 2};
+		return cache.get(key, [&]() {
+			++builtMaps;
+			return QSharedPointer<hyperion::ImageToLedsMap>::create(log, width, height, horizontalBorder, 0, ledString.leds(), 0, 2);
+		});
+	};
+
+	// Mappings are reused for a previously seen geometry
+	const auto noBorder = getMap(160, 90, 0);
+	const auto letterbox = getMap(160, 90, 10);
+	isOk &= check(getMap(160, 90, 0) == noBorder && getMap(160, 90, 10) == letterbox && builtMaps == 2, "mappings are reused");
+
+	// A third geometry drops the least recently used mapping (no border)
+	getMap(320, 180, 0);
+	isOk &= check(getMap(160, 90, 10) == letterbox, "recently used mapping is kept");
+	isOk &= check(getMap(160, 90, 0) != noBorder && builtMaps == 4, "least recently used mapping is dropped");
+
+	return isOk ? 0 : -1;
+}
@@ -0,0 +1,537 @@
+// STL includes
+#include <iostream>
+#include <random>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <array>
+#include <cmath>
+
+// Linux includes
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <QElapsedTimer>
+#include <QThread>
+#include <QJsonArray>
+#include <QJsonObject>
+
+// Utils includes
+#include <utils/Image.h>
+#include <utils/Logger.h>
+#include <utils/OkhsvTransform.h>
+#include <utils/ColorSys.h>
+#include <utils/ColorRgbScalar.h>
+
+// Hyperion includes
+#include <utils/hyperion.h>
+#include <hyperion/ImageToLedsMap.h>
+#include <hyperion/ImageToLedsMapKernels.h>
+#include <hyperion/MultiColorAdjustment.h>
+#include <hyperion/LedOutputPipeline.h>
+
+// Arguments: [#LEDs] [width] [height] [#frames] [LED area depth]
+
+QVector<Led> createBorderLayout(int ledCount, double depth)
+{
+	// Distribute the LEDs evenly along the four borders
+	QVector<Led> leds;
+	const int perSide = qMax(1, ledCount / 4);
+	for (int side = 0; side < 4; ++side)
+	{
+		for (int i = 0; i < perSide; ++i)
+		{
+			const double begin = static_cast<double>(i) / perSide;
+			const double end = static_cast<double>(i + 1) / perSide;
+
+			Led led {};
+			switch (side)
+			{
+			case 0: // top
+				led.minX_frac = begin; led.maxX_frac = end; led.minY_frac = 0.0; led.maxY_frac = depth;
+				break;
+			case 1: // right
+				led.minX_frac = 1.0 - depth; led.maxX_frac = 1.0; led.minY_frac = begin; led.maxY_frac = end;
+				break;
+			case 2: // bottom
+				led.minX_frac = 1.0 - end; led.maxX_frac = 1.0 - begin; led.minY_frac = 1.0 - depth; led.maxY_frac = 1.0;
+				break;
+			default: // left
+				led.minX_frac = 0.0; led.maxX_frac = depth; led.minY_frac = 1.0 - end; led.maxY_frac = 1.0 - begin;
+				break;
+			}
+			led.colorOrder = ColorOrder::ORDER_RGB;
+			leds.append(led);
+		}
+	}
+	return leds;
+}
+
+Image<ColorRgb> createRandomImage(int width, int height, unsigned seed = 42)
+{
+	std::mt19937 generator(seed);
+	std::uniform_int_distribution<int> distribution(0, 255);
+
+	Image<ColorRgb> image(width, height);
+	ColorRgb* pixel = image.memptr();
+	for (int idx = 0; idx < width * height; ++idx, ++pixel)
+	{
+		*pixel = ColorRgb{static_cast<uint8_t>(distribution(generator)),
+						  static_cast<uint8_t>(distribution(generator)),
+						  static_cast<uint8_t>(distribution(generator))};
+	}
+	return image;
+}
+
+///
+/// Counts the hardware cache misses of the calling thread, if the platform and its permissions allow to
+///
+class CacheMissCounter
+{
+public:
+	CacheMissCounter()
+	{
+#if defined(__linux__)
+		perf_event_attr attr {};
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.size = sizeof(attr);
+		attr.config = PERF_COUNT_HW_CACHE_MISSES;
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		_fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+	}
+
+	~CacheMissCounter()
+	{
+#if defined(__linux__)
+		if (_fd >= 0)
+		{
+			close(_fd);
+		}
+#endif
+	}
+
+	CacheMissCounter(const CacheMissCounter&) = delete;
+	CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+
+	bool isAvailable() const { return _fd >= 0; }
+
+	void start()
+	{
+#if defined(__linux__)
+		ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+		ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+	}
+
+	long long stop()
+	{
+		long long count {0};
+#if defined(__linux__)
+		ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0);
+		if (read(_fd, &count, sizeof(count)) != sizeof(count))
+		{
+			count = 0;
+		}
+#endif
+		return count;
+	}
+
+private:
+	int _fd {-1};
+};
+
+template <typename Func>
+void measure(const char* name, int frames, Func func)
+{
+	// Warm-up
+	func();
+
+	CacheMissCounter cacheMisses;
+	if (cacheMisses.isAvailable())
+	{
+		cacheMisses.start();
+	}
+
+	QElapsedTimer timer;
+	timer.start();
+	for (int frame = 0; frame < frames; ++frame)
+	{
+		func();
+	}
+	const double frameTime_us = static_cast<double>(timer.nsecsElapsed()) / 1000.0 / frames;
+
+	std::cout << name << ": " << frameTime_us << " us/frame";
+	if (cacheMisses.isAvailable())
+	{
+		// Misses of worker threads are not included
+		std::cout << ", " << cacheMisses.stop() / frames << " cache misses/frame";
+	}
+	std::cout << '\n';
+}
+
+// Blacklist, color adjustment and color order applied as separate passes over the LEDs
+void applyOutputSeparately(QVector<ColorRgb>& ledColors, const QVector<ColorOrder>& colorOrders, const QVector<int>& blacklistedLedIds, MultiColorAdjustment& adjustment)
+{
+	for (int id : blacklistedLedIds)
+	{
+		ledColors[id] = ColorRgb::BLACK;
+	}
+
+	adjustment.applyAdjustment(ledColors);
+
+	for (int idx = 0; idx < colorOrders.size(); ++idx)
+	{
+		ColorRgb& color = ledColors[idx];
+		switch (colorOrders.at(idx))
+		{
+		case ColorOrder::ORDER_RGB:
+			break;
+		case ColorOrder::ORDER_BGR:
+			std::swap(color.red, color.blue);
+			break;
+		case ColorOrder::ORDER_RBG:
+			std::swap(color.green, color.blue);
+			break;
+		case ColorOrder::ORDER_GRB:
+			std::swap(color.red, color.green);
+			break;
+		case ColorOrder::ORDER_GBR:
+			std::swap(color.red, color.green);
+			std::swap(color.green, color.blue);
+			break;
+		case ColorOrder::ORDER_BRG:
+			std::swap(color.red, color.blue);
+			std::swap(color.green, color.blue);
+			break;
+		}
+	}
+}
+
+///
+/// The per LED pixel index lists the mappings used before the packed span layout, one heap allocated list per LED
+///
+QVector<QVector<int>> createIndexLists(int width, int height, const QVector<Led>& leds)
+{
+	QVector<QVector<int>> colorsMap;
+	for (const Led& led : leds)
+	{
+		QVector<int> pixels;
+		if ((led.maxX_frac - led.minX_frac) >= 1e-6 && (led.maxY_frac - led.minY_frac) >= 1e-6)
+		{
+			int minX_idx = qRound(width * led.minX_frac);
+			int maxX_idx = qRound(width * led.maxX_frac);
+			int minY_idx = qRound(height * led.minY_frac);
+			int maxY_idx = qRound(height * led.maxY_frac);
+
+			minX_idx = qMin(minX_idx, width - 1);
+			maxX_idx = (minX_idx == maxX_idx) ? maxX_idx + 1 : qMin(maxX_idx, width);
+			minY_idx = qMin(minY_idx, height - 1);
+			maxY_idx = (minY_idx == maxY_idx) ? maxY_idx + 1 : qMin(maxY_idx, height);
+
+			const int step = ((maxY_idx - minY_idx) * (maxX_idx - minX_idx) > 1600) ? 2 : 1;
+			for (int y = minY_idx; y < maxY_idx; y += step)
+			{
+				for (int x = minX_idx; x < maxX_idx; x += step)
+				{
+					pixels.append(y * width + x);
+				}
+			}
+		}
+		colorsMap.append(pixels);
+	}
+	return colorsMap;
+}
+
+///
+/// The mean color mapping as it was before the packed span layout, iterating the per LED index lists
+///
+void getBaselineMeanLedColor(const Image<ColorRgb>& image, const QVector<QVector<int>>& colorsMap, QVector<ColorRgb>& ledColors)
+{
+	const ColorRgb* imgData = image.memptr();
+	for (int led = 0; led < colorsMap.size(); ++led)
+	{
+		const QVector<int>& pixels = colorsMap[led];
+		if (pixels.isEmpty())
+		{
+			ledColors[led] = ColorRgb::BLACK;
+			continue;
+		}
+
+		uint_fast32_t cummRed = 0;
+		uint_fast32_t cummGreen = 0;
+		uint_fast32_t cummBlue = 0;
+		for (const int pixelOffset : pixels)
+		{
+			const ColorRgb& pixel = imgData[pixelOffset];
+			cummRed += pixel.red;
+			cummGreen += pixel.green;
+			cummBlue += pixel.blue;
+		}
+		const auto pixelNum = static_cast<uint_fast32_t>(pixels.size());
+		ledColors[led] = {static_cast<uint8_t>(cummRed / pixelNum), static_cast<uint8_t>(cummGreen / pixelNum), static_cast<uint8_t>(cummBlue / pixelNum)};
+	}
+}
+
+///
+/// The dominant color advanced mapping as it was before the k-means got warm-started and bounded,
+/// to reproduce the baseline of the frame time distribution: per pixel index lists, a cold start from the
+/// default cluster colors on every frame and double Euclidean distances, iterated until the change is below one.
+///
+class BaselineDominantAdv
+{
+public:
+	BaselineDominantAdv(int width, int height, const QVector<Led>& leds, int accuracyLevel)
+		: _colorsMap(createIndexLists(width, height, leds))
+		, _clusterCount(accuracyLevel + 1)
+	{
+	}
+
+	void getDominantAdvLedColor(const Image<ColorRgb>& image, QVector<ColorRgb>& ledColors) const
+	{
+		for (int led = 0; led < _colorsMap.size(); ++led)
+		{
+			ledColors[led] = calculateDominantColorAdv(image, _colorsMap[led]);
+		}
+	}
+
+private:
+	struct ColorCluster
+	{
+		ColorRgbScalar color;
+		ColorRgbScalar newColor;
+		int count {0};
+	};
+
+	ColorRgb calculateDominantColorAdv(const Image<ColorRgb>& image, const QVector<int>& pixels) const
+	{
+		static const std::array<ColorRgb, 5> DEFAULT_CLUSTER_COLORS {{ColorRgb::BLACK, ColorRgb::GREEN, ColorRgb::WHITE, ColorRgb::RED, ColorRgb::YELLOW}};
+
+		ColorRgb dominantColor {ColorRgb::BLACK};
+		if (pixels.isEmpty())
+		{
+			return dominantColor;
+		}
+
+		std::array<ColorCluster, 5> clusters;
+		for (int k = 0; k < _clusterCount; ++k)
+		{
+			clusters[k].newColor = DEFAULT_CLUSTER_COLORS[k];
+		}
+
+		double oldChange {0};
+		while (true)
+		{
+			for (int k = 0; k < _clusterCount; ++k)
+			{
+				clusters[k].count = 0;
+				clusters[k].color = clusters[k].newColor;
+				clusters[k].newColor.setRgb(ColorRgb::BLACK);
+			}
+
+			const ColorRgb* imgData = image.memptr();
+			for (const int pixelOffset : pixels)
+			{
+				const ColorRgbScalar pixel(imgData[pixelOffset]);
+				double minDistance = 255 * 255 * 255;
+				int clusterIndex = 0;
+				for (int k = 0; k < _clusterCount; ++k)
+				{
+					const double distance = ColorSys::rgb_euclidean(pixel, clusters[k].color);
+					if (distance < minDistance)
+					{
+						minDistance = distance;
+						clusterIndex = k;
+					}
+				}
+				clusters[clusterIndex].count++;
+				clusters[clusterIndex].newColor += pixel;
+			}
+
+			double change {0};
+			for (int k = 0; k < _clusterCount; ++k)
+			{
+				if (clusters[k].count > 0)
+				{
+					clusters[k].newColor /= clusters[k].count;
+					change = std::max(change, ColorSys::rgb_euclidean(clusters[k].newColor, clusters[k].color));
+				}
+			}
+
+			if (std::fabs(change - oldChange) < 1)
+			{
+				break;
+			}
+			oldChange = change;
+		}
+
+		int dominantClusterIdx {0};
+		for (int k = 1; k < _clusterCount; ++k)
+		{
+			if (clusters[k].count > clusters[dominantClusterIdx].count)
+			{
+				dominantClusterIdx = k;
+			}
+		}
+		dominantColor.red = static_cast<uint8_t>(clusters[dominantClusterIdx].newColor.red);
+		dominantColor.green = static_cast<uint8_t>(clusters[dominantClusterIdx].newColor.green);
+		dominantColor.blue = static_cast<uint8_t>(clusters[dominantClusterIdx].newColor.blue);
+		return dominantColor;
+	}
+
+	QVector<QVector<int>> _colorsMap;
+	int _clusterCount;
+};
+
+template <typename Func>
+void measureDistribution(const char* name, int frames, Func func)
+{
+	std::vector<qint64> frameTimes;
+	frameTimes.reserve(frames);
+
+	QElapsedTimer timer;
+	for (int frame = 0; frame < frames; ++frame)
+	{
+		timer.start();
+		func(frame);
+		frameTimes.push_back(timer.nsecsElapsed());
+	}
+	std::sort(frameTimes.begin(), frameTimes.end());
+
+	const auto percentile = [&](int percent) {
+		return static_cast<double>(frameTimes[(frameTimes.size() - 1) * percent / 100]) / 1000.0;
+	};
+	std::cout << name << ": p50 " << percentile(50) << " us, p95 " << percentile(95) << " us, p99 " << percentile(99)
+			  << " us, max " << percentile(100) << " us" << '\n';
+}
+
+int main(int argc, char** argv)
+{
+	QSharedPointer<Logger> log = Logger::getInstance("TestImageLedsMapPerf");
+	Logger::setLogLevel(Logger::LogLevel::Warning);
+
+	const int ledCount = (argc > 1) ? std::atoi(argv[1]) : 1200;
+	const int width = (argc > 2) ? std::atoi(argv[2]) : 320;
+	const int height = (argc > 3) ? std::atoi(argv[3]) : 180;
+	const int frames = (argc > 4) ? std::atoi(argv[4]) : 500;
+	const double depth = (argc > 5) ? std::atof(argv[5]) : 0.10;
+
+	std::cout << "LEDs: " << ledCount << ", image: " << width << "x" << height << ", frames: " << frames << ", depth: " << depth << '\n';
+
+	const QVector<Led> leds = createBorderLayout(ledCount, depth);
+	const Image<ColorRgb> image = createRandomImage(width, height);
+
+	QElapsedTimer timer;
+	timer.start();
+	hyperion::ImageToLedsMap map(log, width, height, 0, 0, leds, 0, 2);
+	std::cout << "Map construction: " << static_cast<double>(timer.nsecsElapsed()) / 1000.0 << " us" << '\n';
+
+	QVector<ColorRgb> ledColors(leds.size());
+
+	// Per LED index lists compared to the packed span layout, scalar accumulation in both cases
+	const QVector<QVector<int>> indexLists = createIndexLists(width, height, leds);
+	map.setAccumulateKernels(hyperion::kernels::scalarKernels());
+	measure("[index lists] multicolor_mean", frames, [&]() { getBaselineMeanLedColor(image, indexLists, ledColors); });
+	measure("[packed spans] multicolor_mean", frames, [&]() { map.getMeanLedColor(image, ledColors); });
+
+	for (const hyperion::kernels::AccumulateKernels* kernels : hyperion::kernels::availableKernels())
+	{
+		map.setAccumulateKernels(*kernels);
+		std::cout << "[" << kernels->name << "] ";
+		measure("multicolor_mean", frames, [&]() { map.getMeanLedColor(image, ledColors); });
+		std::cout << "[" << kernels->name << "] ";
+		measure("multicolor_mean_squared", frames, [&]() { map.getMeanSqrtLedColor(image, ledColors); });
+		std::cout << "[" << kernels->name << "] ";
+		measure("unicolor_mean", frames, [&]() { map.getUniLedColor(image, ledColors); });
+	}
+	map.setAccumulateKernels(hyperion::kernels::accumulateKernels());
+
+	measure("multicolor_mean", frames, [&]() { map.getMeanLedColor(image, ledColors); });
+	measure("multicolor_mean_squared", frames, [&]() { map.getMeanSqrtLedColor(image, ledColors); });
+	measure("unicolor_mean", frames, [&]() { map.getUniLedColor(image, ledColors); });
+	measure("multicolor_mean_integral", frames, [&]() { map.getMeanLedColorIntegral(image, ledColors); });
+	measure("dominant_color", frames, [&]() { map.getDominantLedColor(image, ledColors); });
+	measure("unicolor_dominant", frames, [&]() { map.getDominantUniLedColor(image, ledColors); });
+	measure("dominant_color_advanced", frames, [&]() { map.getDominantAdvLedColor(image, ledColors); });
+
+	// Frame time distribution of the k-means, on a static and on a changing image, compared to the baseline
+	const Image<ColorRgb> otherImage = createRandomImage(width, height, 4711);
+	const BaselineDominantAdv baseline(width, height, leds, 2);
+	measureDistribution("[baseline] dominant_color_advanced (static)", frames, [&](int) { baseline.getDominantAdvLedColor(image, ledColors); });
+	measureDistribution("[baseline] dominant_color_advanced (changing)", frames, [&](int frame) { baseline.getDominantAdvLedColor((frame % 2) ? otherImage : image, ledColors); });
+	measureDistribution("dominant_color_advanced (static)", frames, [&](int) { map.getDominantAdvLedColor(image, ledColors); });
+	measureDistribution("dominant_color_advanced (changing)", frames, [&](int frame) { map.getDominantAdvLedColor((frame % 2) ? otherImage : image, ledColors); });
+
+	// Scaling of the parallel per LED processing
+	for (int threads = 1; threads <= QThread::idealThreadCount(); ++threads)
+	{
+		map.setThreadCount(threads);
+		std::cout << "[" << threads << " thread(s), " << map.threadCount() << " chunk(s)] ";
+		measure("multicolor_mean", frames, [&]() { map.getMeanLedColor(image, ledColors); });
+		std::cout << "[" << threads << " thread(s), " << map.threadCount() << " chunk(s)] ";
+		measure("dominant_color", frames, [&]() { map.getDominantLedColor(image, ledColors); });
+	}
+
+	// Final output processing: separate passes compared to the compiled single pass.
+	// A GRB strip with a BGR segment, gamma and a channel calibration as commonly configured.
+	const QJsonObject colorConfig {{"channelAdjustment", QJsonArray {QJsonObject {
+		{"id", "default"}, {"leds", "*"}, {"gammaRed", 2.2}, {"gammaGreen", 2.2}, {"gammaBlue", 2.2},
+		{"red", QJsonArray {255, 0, 0}}, {"green", QJsonArray {0, 230, 0}}, {"blue", QJsonArray {0, 0, 200}}
+	}}}};
+	for (int outputLedCount : {ledCount, 2400, 4800})
+	{
+		QVector<ColorOrder> colorOrders(outputLedCount, ColorOrder::ORDER_GRB);
+		std::fill(colorOrders.begin() + outputLedCount * 3 / 4, colorOrders.end(), ColorOrder::ORDER_BGR);
+		const QVector<int> blacklistedLedIds {0, outputLedCount / 2, outputLedCount - 1};
+		const std::unique_ptr<MultiColorAdjustment> adjustment(hyperion::createLedColorsAdjustment(outputLedCount, colorConfig));
+
+		const Image<ColorRgb> rawImage = createRandomImage(outputLedCount, 1, 42);
+		const QVector<ColorRgb> rawColors(rawImage.memptr(), rawImage.memptr() + outputLedCount);
+		QVector<ColorRgb> outputColors = rawColors;
+
+		std::cout << "[" << outputLedCount << " LEDs] ";
+		measure("output separate passes", frames, [&]() {
+			std::copy(rawColors.cbegin(), rawColors.cend(), outputColors.begin());
+			applyOutputSeparately(outputColors, colorOrders, blacklistedLedIds, *adjustment);
+		});
+
+		hyperion::LedOutputPipeline ledOutput;
+		ledOutput.compile(colorOrders, blacklistedLedIds, adjustment.get());
+		for (const hyperion::kernels::ShuffleKernel* kernel : hyperion::kernels::availableShuffleKernels())
+		{
+			ledOutput.setShuffleKernel(*kernel);
+			std::cout << "[" << outputLedCount << " LEDs, " << kernel->name << "] ";
+			measure("output fused pass", frames, [&]() {
+				std::copy(rawColors.cbegin(), rawColors.cend(), outputColors.begin());
+				ledOutput.apply(outputColors);
+			});
+		}
+	}
+
+	// OkHSV transform per LED, reference compared to the fused implementation
+	const OkhsvTransform okhsvTransform(1.5, 1.2);
+	const Image<ColorRgb> okhsvImage = createRandomImage(2400, 1, 42);
+	const QVector<ColorRgb> okhsvColors(okhsvImage.memptr(), okhsvImage.memptr() + 2400);
+	QVector<ColorRgb> transformedColors = okhsvColors;
+	for (const auto& implementation : {std::make_pair("reference", OkhsvTransform::Implementation::Reference), std::make_pair("fast", OkhsvTransform::Implementation::Fast)})
+	{
+		std::cout << "[2400 LEDs, " << implementation.first << "] ";
+		measure("okhsv transform", frames, [&]() {
+			std::copy(okhsvColors.cbegin(), okhsvColors.cend(), transformedColors.begin());
+			for (ColorRgb& color : transformedColors)
+			{
+				okhsvTransform.transform(color.red, color.green, color.blue, implementation.second);
+			}
+		});
+	}
+
+	return 0;
+}
@@ -0,0 +1,48 @@
+// STL includes
+#include <algorithm>
+
+// Utils includes
+#include <utils/Image.h>
+#include <utils/Logger.h>
+
+// Hyperion includes
+#include <hyperion/ImageToLedsMap.h>
+
+// Test includes
+#include "TestCheck.h"
+#include "TestLedLayout.h"
+
+int main()
+{
+	QSharedPointer<Logger> log = Logger::getInstance("TestIntegralImage");
+	Logger::setLogLevel(Logger::LogLevel::Debug);
+
+	const LedString ledString = createBorderLedString();
+	bool isOk = true;
+
+	// LED areas below the size where pixels are skipped (1600 pixels)
+	const int width = 160;
+	const int height = 90;
+	const Image<ColorRgb> image = createRandomImage(width, height);
+
+	// Without skipped pixels the summed-area table mapping equals the mean color mapping
+	const hyperion::ImageToLedsMap map(log, width, height, 0, 0, ledString.leds());
+	isOk &= check(map.getMeanLedColorIntegral(image) == map.getMeanLedColor(image), "integral image mapping is bit-exact");
+
+	const hyperion::ImageToLedsMap borderMap(log, width, height, 5, 10, ledString.leds());
+	isOk &= check(borderMap.getMeanLedColorIntegral(image) == borderMap.getMeanLedColor(image), "integral image mapping inside a black border is bit-exact");
+
+	// The reduced pixel set does not apply, all pixels of an area are evaluated
+	const hyperion::ImageToLedsMap reducedMap(log, width, height, 0, 0, ledString.leds(), 1);
+	const QVector<ColorRgb> integralColors = reducedMap.getMeanLedColorIntegral(image);
+	isOk &= check(integralColors == map.getMeanLedColor(image), "integral image mapping evaluates all pixels of a reduced pixel set");
+	isOk &= check(integralColors != reducedMap.getMeanLedColor(image), "mean color mapping evaluates the reduced pixel set only");
+
+	// An image not matching the size of the mapping is rejected
+	QVector<ColorRgb> ledColors(ledString.leds().size(), ColorRgb::WHITE);
+	map.getMeanLedColorIntegral(createRandomImage(width / 2, height / 2), ledColors);
+	isOk &= check(std::all_of(ledColors.cbegin(), ledColors.cend(), [](const ColorRgb& color) { return color == ColorRgb::WHITE; }),
+				  "image of another size is not mapped");
+
+	return isOk ? 0 : -1;
+}
@@ -0,0 +1,91 @@
+#ifndef TESTLEDLAYOUT_H
+#define TESTLEDLAYOUT_H
+
+// STL includes
+#include <random>
+
+// Qt includes
+#include <QJsonArray>
+#include <QJsonObject>
+
+// Utils includes
+#include <utils/Image.h>
+#include <utils/ColorRgb.h>
+
+// Hyperion includes
+#include <hyperion/LedString.h>
+
+///
+/// Creates a layout with the LEDs distributed evenly along the four borders of the image, followed by a
+/// blacklisted LED (without area), as configured in the LED layout settings
+///
+/// @param ledCount The number of LEDs along the borders, rounded down to a multiple of four
+/// @param depth The depth of the LED areas as fraction of the image width or height
+///
+inline LedString createBorderLedString(int ledCount = 200, double depth = 0.15)
+{
+	QJsonArray ledLayout;
+	const auto addLed = [&](double hmin, double hmax, double vmin, double vmax) {
+		ledLayout.append(QJsonObject {{"hmin", hmin}, {"hmax", hmax}, {"vmin", vmin}, {"vmax", vmax}});
+	};
+
+	const int perSide = qMax(1, ledCount / 4);
+	for (int side = 0; side < 4; ++side)
+	{
+		for (int i = 0; i < perSide; ++i)
+		{
+			const double begin = static_cast<double>(i) / perSide;
+			const double end = static_cast<double>(i + 1) / perSide;
+			switch (side)
+			{
+			case 0: // top
+				addLed(begin, end, 0.0, depth);
+				break;
+			case 1: // right
+				addLed(1.0 - depth, 1.0, begin, end);
+				break;
+			case 2: // bottom
+				addLed(1.0 - end, 1.0 - begin, 1.0 - depth, 1.0);
+				break;
+			default: // left
+				addLed(0.0, depth, 1.0 - end, 1.0 - begin);
+				break;
+			}
+		}
+	}
+	addLed(0.0, 0.0, 0.0, 0.0);
+
+	return LedString::createLedString(ledLayout, ColorOrder::ORDER_RGB, static_cast<int>(ledLayout.size()));
+}
+
+///
+/// @return A color configuration with a single adjustment for all LEDs, gamma and a channel calibration
+///
+inline QJsonObject createColorConfig()
+{
+	return QJsonObject {{"channelAdjustment", QJsonArray {QJsonObject {
+		{"id", "default"}, {"leds", "*"}, {"gammaRed", 2.2}, {"gammaGreen", 2.2}, {"gammaBlue", 2.2},
+		{"red", QJsonArray {255, 0, 0}}, {"green", QJsonArray {0, 230, 0}}, {"blue", QJsonArray {0, 0, 200}}
+	}}}};
+}
+
+///
+/// @return An image of random pixels, the same for the same seed
+///
+inline Image<ColorRgb> createRandomImage(int width, int height, unsigned seed = 4711)
+{
+	std::mt19937 generator(seed);
+	std::uniform_int_distribution<int> distribution(0, 255);
+
+	Image<ColorRgb> image(width, height);
+	ColorRgb* pixel = image.memptr();
+	for (int idx = 0; idx < width * height; ++idx, ++pixel)
+	{
+		*pixel = ColorRgb{static_cast<uint8_t>(distribution(generator)),
+						  static_cast<uint8_t>(distribution(generator)),
+						  static_cast<uint8_t>(distribution(generator))};
+	}
+	return image;
+}
+
+#endif // TESTLEDLAYOUT_H
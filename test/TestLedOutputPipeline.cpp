@@ -0,0 +1,141 @@
+// STL includes
+#include <memory>
+#include <string>
+#include <utility>
+
+// Utils includes
+#include <utils/Image.h>
+#include <utils/Logger.h>
+
+// Hyperion includes
+#include <utils/hyperion.h>
+#include <hyperion/MultiColorAdjustment.h>
+#include <hyperion/LedOutputPipeline.h>
+
+// Test includes
+#include "TestCheck.h"
+#include "TestLedLayout.h"
+
+namespace {
+
+///
+/// Reorders the color components as the LED device expects them
+///
+void applyColorOrder(ColorOrder colorOrder, ColorRgb& color)
+{
+	switch (colorOrder)
+	{
+	case ColorOrder::ORDER_RGB:
+		break;
+	case ColorOrder::ORDER_BGR:
+		std::swap(color.red, color.blue);
+		break;
+	case ColorOrder::ORDER_RBG:
+		std::swap(color.green, color.blue);
+		break;
+	case ColorOrder::ORDER_GRB:
+		std::swap(color.red, color.green);
+		break;
+	case ColorOrder::ORDER_GBR:
+		std::swap(color.red, color.green);
+		std::swap(color.green, color.blue);
+		break;
+	case ColorOrder::ORDER_BRG:
+		std::swap(color.red, color.blue);
+		std::swap(color.green, color.blue);
+		break;
+	}
+}
+
+} // namespace
+
+int main()
+{
+	QSharedPointer<Logger> log = Logger::getInstance("TestLedOutputPipeline");
+	Logger::setLogLevel(Logger::LogLevel::Debug);
+
+	const LedString ledString = createBorderLedString();
+	const QJsonObject colorConfig = createColorConfig();
+	bool isOk = true;
+
+	// Runs of all color orders with lengths from a single LED up to multiple blocks, some LEDs blacklisted
+	const int ledCount = 2500;
+	QVector<ColorOrder> colorOrders;
+	for (int length = 1; colorOrders.size() < ledCount; length = length * 3 % 1000 + 1)
+	{
+		const auto order = static_cast<ColorOrder>(length % 6);
+		for (int idx = 0; idx < length && colorOrders.size() < ledCount; ++idx)
+		{
+			colorOrders.append(order);
+		}
+	}
+	QVector<int> blacklistedLedIds {0, 5, 6, 7, 511, 512, ledCount - 1};
+	blacklistedLedIds.append(ledString.blacklistedLedIds());
+
+	const Image<ColorRgb> image = createRandomImage(ledCount + 10, 1);
+	const QVector<ColorRgb> rawColors(image.memptr(), image.memptr() + image.width());
+
+	// The configured adjustment and multiple zones derived from it, some LEDs without adjustment
+	QJsonObject zone = colorConfig["channelAdjustment"].toArray().first().toObject();
+	QJsonArray zones;
+	for (const auto& leds : {std::make_pair("zoneA", "0-99, 700-1300"), std::make_pair("zoneB", "100-699"), std::make_pair("zoneC", "1400-2399")})
+	{
+		zone["id"] = leds.first;
+		zone["leds"] = leds.second;
+		const int zoneIdx = static_cast<int>(zones.size());
+		zone["gammaRed"] = 1.5 + zoneIdx * 0.4;
+		zone["white"] = QJsonArray {255, 230 - zoneIdx * 20, 200};
+		zones.append(zone);
+	}
+	QJsonObject zonedConfig = colorConfig;
+	zonedConfig["channelAdjustment"] = zones;
+
+	for (const QJsonObject& adjustmentConfig : {colorConfig, zonedConfig})
+	{
+		const std::unique_ptr<MultiColorAdjustment> adjustment(hyperion::createLedColorsAdjustment(ledCount, adjustmentConfig));
+		const std::string ranges = "[" + std::to_string(adjustment->getAdjustmentRanges().size()) + " ranges]";
+
+		// Reference: every LED adjusted on its own
+		QVector<ColorRgb> expected = rawColors;
+		for (int id : blacklistedLedIds)
+		{
+			expected[id] = ColorRgb::BLACK;
+		}
+		const QVector<ColorAdjustment*>& ledAdjustments = adjustment->getLedAdjustments();
+		for (int idx = 0; idx < ledCount; ++idx)
+		{
+			if (ledAdjustments[idx] != nullptr)
+			{
+				MultiColorAdjustment::applyAdjustment(*ledAdjustments[idx], expected[idx]);
+			}
+		}
+
+		// The batched adjustment of the LED ranges matches
+		QVector<ColorRgb> batched = rawColors;
+		for (int id : blacklistedLedIds)
+		{
+			batched[id] = ColorRgb::BLACK;
+		}
+		adjustment->applyAdjustment(batched);
+		isOk &= check(batched == expected, ("batched adjustment " + ranges).c_str());
+
+		// The compiled output pass gives the same LED colors as applying blacklist, color adjustment and color order one after the other
+		for (int idx = 0; idx < ledCount; ++idx)
+		{
+			applyColorOrder(colorOrders[idx], expected[idx]);
+		}
+
+		hyperion::LedOutputPipeline ledOutput;
+		ledOutput.compile(colorOrders, blacklistedLedIds, adjustment.get());
+		for (const hyperion::kernels::ShuffleKernel* kernel : hyperion::kernels::availableShuffleKernels())
+		{
+			ledOutput.setShuffleKernel(*kernel);
+			QVector<ColorRgb> ledColors = rawColors;
+			ledOutput.apply(ledColors);
+
+			isOk &= check(ledColors == expected, ("fused output pass " + ranges + " [" + kernel->name + "]").c_str());
+		}
+	}
+
+	return isOk ? 0 : -1;
+}
@@ -0,0 +1,49 @@
+// STL includes
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <utility>
+
+// Utils includes
+#include <utils/ColorRgb.h>
+#include <utils/OkhsvTransform.h>
+
+// Test includes
+#include "TestCheck.h"
+
+int main()
+{
+	bool isOk = true;
+
+	const bool isFast = OkhsvTransform::implementation() == OkhsvTransform::Implementation::Fast;
+	std::cout << "OkHSV transform: " << (isFast ? "fast" : "reference") << " implementation" << '\n';
+
+	for (const auto& gain : {std::make_pair(1.5, 1.2), std::make_pair(0.5, 0.8), std::make_pair(1.0, 1.5), std::make_pair(3.0, 0.3)})
+	{
+		const OkhsvTransform transform(gain.first, gain.second);
+		int maxError = 0;
+		for (int red = 0; red <= UINT8_MAX; red += 5)
+		{
+			for (int green = 0; green <= UINT8_MAX; green += 5)
+			{
+				for (int blue = 0; blue <= UINT8_MAX; blue += 5)
+				{
+					ColorRgb expected {static_cast<uint8_t>(red), static_cast<uint8_t>(green), static_cast<uint8_t>(blue)};
+					ColorRgb color = expected;
+					transform.transform(expected.red, expected.green, expected.blue, OkhsvTransform::Implementation::Reference);
+					transform.transform(color.red, color.green, color.blue, OkhsvTransform::Implementation::Fast);
+
+					maxError = std::max({maxError, std::abs(color.red - expected.red), std::abs(color.green - expected.green), std::abs(color.blue - expected.blue)});
+				}
+			}
+		}
+
+		// The fast implementation is only selected if it matches the reference, otherwise it is not required to
+		const std::string description = "OkHSV transform (" + std::to_string(gain.first) + ", " + std::to_string(gain.second)
+										+ "), max. error " + std::to_string(maxError);
+		isOk &= check(!isFast || maxError == 0, description.c_str());
+	}
+
+	return isOk ? 0 : -1;
+}
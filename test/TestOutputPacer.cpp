@@ -0,0 +1,82 @@
+// STL includes
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+// Hyperion includes
+#include <utils/Logger.h>
+#include <utils/LatencyMetrics.h>
+#include <hyperion/OutputPacer.h>
+
+// Test includes
+#include "TestCheck.h"
+
+using namespace hyperion;
+
+int main()
+{
+	bool isOk = true;
+
+	constexpr std::chrono::milliseconds INTERVAL {5};
+	constexpr int FRAMES = 1000;
+
+	std::atomic<int> written {0};
+	std::atomic<int> lastSequence {-1};
+	std::atomic<bool> isInOrder {true};
+
+	QSharedPointer<LatencyHistogram> jitter(new LatencyHistogram());
+	OutputPacer pacer(
+		[&](const QVector<ColorRgb>& ledColors, qint64 captureTime_ns) {
+			const int sequence = static_cast<int>(captureTime_ns);
+			if (ledColors.size() != 1 || ledColors.front().red != static_cast<uint8_t>(sequence) || sequence <= lastSequence.load())
+			{
+				isInOrder.store(false);
+			}
+			lastSequence.store(sequence);
+			written.fetch_add(1);
+		},
+		jitter,
+		Logger::getInstance("TEST"));
+
+	pacer.start(INTERVAL);
+	isOk &= check(pacer.isRunning(), "pacer runs after start");
+
+	// Produce frames faster than the output interval, only the latest is written per deadline
+	int sequence = 0;
+	for (; sequence < FRAMES; ++sequence)
+	{
+		pacer.post({ ColorRgb(static_cast<uint8_t>(sequence), 0, 0) }, sequence);
+		std::this_thread::sleep_for(std::chrono::microseconds(500));
+	}
+
+	// Wait for the last frame to go out, the timeout only guards against a hang
+	const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+	while (lastSequence.load() != sequence - 1 && std::chrono::steady_clock::now() < timeout)
+	{
+		std::this_thread::sleep_for(INTERVAL);
+	}
+	pacer.stop();
+	isOk &= check(!pacer.isRunning(), "pacer stops");
+	const OutputPacer::Statistics statistics = pacer.statistics();
+
+	const LatencyHistogram::Snapshot snapshot = jitter->snapshot();
+	std::cout << "posted " << sequence << ", written " << written.load() << ", ticks " << statistics.ticks
+			  << ", idle " << statistics.idleTicks << ", replaced " << statistics.replacedFrames
+			  << ", missed " << statistics.missedDeadlines << '\n';
+	std::cout << "jitter mean " << (snapshot.count > 0 ? snapshot.sum_us / snapshot.count : 0) << " us, p99 "
+			  << snapshot.percentile(0.99) << " us, max " << snapshot.max_us << " us\n";
+
+	isOk &= check(isInOrder.load(), "frames are written intact and in order");
+	isOk &= check(lastSequence.load() == sequence - 1, "latest frame is written");
+	isOk &= check(static_cast<quint64>(written.load()) == statistics.ticks - statistics.idleTicks, "one frame at most per deadline");
+	isOk &= check(static_cast<quint64>(written.load()) + statistics.replacedFrames == static_cast<quint64>(sequence), "every frame is written or replaced");
+	isOk &= check(snapshot.count == statistics.ticks, "jitter is recorded per deadline");
+
+	// Restart with another interval
+	pacer.start(INTERVAL * 2);
+	isOk &= check(pacer.isRunning() && pacer.statistics().replacedFrames == 0, "restart resets the statistics");
+	pacer.stop();
+
+	return isOk ? 0 : -1;
+}
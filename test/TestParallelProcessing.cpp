@@ -0,0 +1,42 @@
+// STL includes
+#include <string>
+
+// Utils includes
+#include <utils/Image.h>
+#include <utils/Logger.h>
+
+// Hyperion includes
+#include <hyperion/ImageToLedsMap.h>
+
+// Test includes
+#include "TestCheck.h"
+#include "TestLedLayout.h"
+
+int main()
+{
+	QSharedPointer<Logger> log = Logger::getInstance("TestParallelProcessing");
+	Logger::setLogLevel(Logger::LogLevel::Debug);
+
+	const LedString ledString = createBorderLedString();
+	bool isOk = true;
+
+	const int width = 160;
+	const int height = 90;
+	const Image<ColorRgb> image = createRandomImage(width, height);
+
+	// Dominant color advanced is warm-started from the previous frame, hence compare two maps processing the same frames
+	hyperion::ImageToLedsMap map(log, width, height, 0, 0, ledString.leds(), 0, 2);
+	hyperion::ImageToLedsMap refMap(log, width, height, 0, 0, ledString.leds(), 0, 2);
+	map.setThreadCount(4);
+
+	// The parallel processing gives the same results as the sequential one
+	for (int frame = 0; frame < 2; ++frame)
+	{
+		const std::string name = "frame " + std::to_string(frame) + " [" + std::to_string(map.threadCount()) + " chunk(s)]: ";
+		isOk &= check(map.getMeanLedColor(image) == refMap.getMeanLedColor(image), (name + "mean colors are deterministic").c_str());
+		isOk &= check(map.getDominantLedColor(image) == refMap.getDominantLedColor(image), (name + "dominant colors are deterministic").c_str());
+		isOk &= check(map.getDominantAdvLedColor(image) == refMap.getDominantAdvLedColor(image), (name + "advanced dominant colors are deterministic").c_str());
+	}
+
+	return isOk ? 0 : -1;
+}
@@ -0,0 +1,75 @@
+// Qt includes
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QTimer>
+
+// Hyperion includes
+#include <hyperion/PriorityMuxer.h>
+
+// Test includes
+#include "TestCheck.h"
+
+namespace {
+
+///
+/// Runs the event loop, i.e. the muxer's timers, for the given time
+///
+void wait(int time_ms)
+{
+	QEventLoop loop;
+	QTimer::singleShot(time_ms, &loop, &QEventLoop::quit);
+	loop.exec();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+	QCoreApplication app(argc, argv);
+
+	QObject instance;
+	instance.setProperty("instance", "0");
+	PriorityMuxer muxer(10, &instance);
+	muxer.start();
+
+	bool isOk = true;
+	const QVector<ColorRgb> colors(10, ColorRgb::WHITE);
+
+	muxer.registerInput(50, hyperion::COMP_COLOR, "Test");
+	isOk &= check(muxer.getCurrentPriority() == PriorityMuxer::LOWEST_PRIORITY, "registered input is inactive");
+	muxer.setInput(50, colors, 300);
+	muxer.registerInput(20, hyperion::COMP_IMAGE, "Test", "Streaming");
+	muxer.setInputImage(20, Image<ColorRgb>(4, 4), 200);
+	isOk &= check(muxer.getCurrentPriority() == 20, "lowest active priority is visible");
+
+	// A stream extending its timeout outlives the color's timeout
+	for (int frame = 0; frame < 10; ++frame)
+	{
+		wait(50);
+		muxer.setInputImage(20, Image<ColorRgb>(4, 4), 200);
+	}
+	isOk &= check(!muxer.hasPriority(50) && muxer.hasPriority(20), "timed out color is removed, extended stream is kept");
+
+	QElapsedTimer timer;
+	timer.start();
+	while (muxer.hasPriority(20) && timer.elapsed() < 1000)
+	{
+		wait(10);
+	}
+	isOk &= check(!muxer.hasPriority(20) && timer.elapsed() >= 150, "stream is removed after its timeout");
+	isOk &= check(muxer.getCurrentPriority() == PriorityMuxer::LOWEST_PRIORITY, "lowest priority is visible again");
+
+	// Cleared inputs are removed with the next turn of the event loop
+	muxer.registerInput(10, hyperion::COMP_EFFECT, "Test");
+	muxer.setInput(10, colors);
+	muxer.clearInput(10);
+	wait(10);
+	isOk &= check(!muxer.hasPriority(10), "cleared input is removed");
+
+	muxer.registerInput(PriorityMuxer::PRIORITY_SLOTS, hyperion::COMP_COLOR, "Test");
+	isOk &= check(!muxer.hasPriority(PriorityMuxer::PRIORITY_SLOTS) && !muxer.setInput(-1, colors), "invalid priorities are rejected");
+
+	muxer.stop();
+	return isOk ? 0 : -1;
+}
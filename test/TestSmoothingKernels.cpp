@@ -0,0 +1,346 @@
+// STL includes
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QVector>
+
+// Hyperion includes
+#include <utils/ColorRgb.h>
+#include <hyperion/SmoothingKernels.h>
+
+// Arguments: [#frames]
+
+using namespace hyperion;
+
+namespace {
+
+/// Number of frames within the smoothing window
+constexpr int WINDOW_FRAMES = 10;
+
+std::vector<uint8_t> createRandomComponents(int ledCount, unsigned seed)
+{
+	std::mt19937 generator(seed);
+	std::uniform_int_distribution<int> distribution(0, 255);
+
+	std::vector<uint8_t> components(static_cast<size_t>(3 * ledCount));
+	for (uint8_t& component : components)
+	{
+		component = static_cast<uint8_t>(distribution(generator));
+	}
+	return components;
+}
+
+///
+/// The frame weights of a window of equally long frames, decay power 1 is linear decay
+///
+std::vector<float> windowWeights(double decay)
+{
+	std::vector<float> weights;
+	for (int frame = 0; frame < WINDOW_FRAMES; ++frame)
+	{
+		const float s = static_cast<float>(frame) / WINDOW_FRAMES;
+		const float t = static_cast<float>(frame + 1) / WINDOW_FRAMES;
+		weights.push_back(static_cast<float>((decay + 1) * (std::pow(t, decay) - std::pow(s, decay)) / 2));
+	}
+	return weights;
+}
+
+///
+/// The floating point smoothing as implemented before the fixed point kernels
+///
+namespace reference {
+
+void interpolate(const std::vector<std::vector<uint8_t>>& frames, const std::vector<float>& weights, std::vector<float>& means)
+{
+	std::vector<uint64_t> sums(means.size(), 0);
+	float fs = 0.0F;
+	for (size_t frame = 0; frame < frames.size(); ++frame)
+	{
+		const uint64_t scale = static_cast<uint64_t>((static_cast<uint64_t>(1) << 43) * static_cast<double>(weights[frame]));
+		fs += weights[frame];
+		for (size_t i = 0; i < sums.size(); ++i)
+		{
+			sums[i] += scale * frames[frame][i];
+		}
+	}
+
+	const float inv_fs = ((fs < 1.0F) ? 1.0F : 1.0F / fs) / (1 << 8);
+	for (size_t i = 0; i < sums.size(); ++i)
+	{
+		means[i] = (sums[i] >> 35) * inv_fs;
+	}
+}
+
+uint8_t clampRounded(float x)
+{
+	return static_cast<uint8_t>(std::min(255L, std::max(0L, std::lroundf(x))));
+}
+
+void assemble(const std::vector<float>& means, uint8_t* components)
+{
+	for (size_t i = 0; i < means.size(); ++i)
+	{
+		components[i] = clampRounded(means[i]);
+	}
+}
+
+void dither(const std::vector<float>& means, std::vector<float>& residuals, uint8_t* components)
+{
+	for (size_t i = 0; i < means.size(); ++i)
+	{
+		const float value = means[i] + residuals[i];
+		components[i] = clampRounded(value);
+		residuals[i] = value - components[i];
+	}
+}
+
+void step(const std::vector<uint8_t>& target, float k, uint8_t* components)
+{
+	for (size_t i = 0; i < target.size(); ++i)
+	{
+		const int difference = target[i] - components[i];
+		components[i] = static_cast<uint8_t>(components[i] + (difference < 0 ? -1 : 1) * std::ceil(k * std::abs(difference)));
+	}
+}
+
+} // namespace reference
+
+///
+/// Accumulates the frames with the given weights normalized to fixed point
+///
+void interpolate(const smoothing::SmoothingKernels& kernels, const std::vector<std::vector<uint8_t>>& frames, const std::vector<float>& weights, std::vector<uint32_t>& means)
+{
+	float fs = 0.0F;
+	for (float weight : weights)
+	{
+		fs += weight;
+	}
+	const float scale = ((fs < 1.0F) ? 1.0F : 1.0F / fs) * smoothing::FIXED_ONE;
+
+	std::fill(means.begin(), means.end(), 0);
+	for (size_t frame = 0; frame < frames.size(); ++frame)
+	{
+		kernels.accumulate(frames[frame].data(), static_cast<int>(means.size()), static_cast<uint32_t>(weights[frame] * scale), means.data());
+	}
+}
+
+uint32_t stepFactor(float k)
+{
+	return static_cast<uint32_t>(std::lround(std::min(k, 1.0F) * (1 << smoothing::STEP_FRACTION_BITS)));
+}
+
+int maxDifference(const std::vector<uint8_t>& first, const std::vector<uint8_t>& second)
+{
+	int difference = 0;
+	for (size_t i = 0; i < first.size(); ++i)
+	{
+		difference = std::max(difference, std::abs(first[i] - second[i]));
+	}
+	return difference;
+}
+
+///
+/// Verify that the vectorised kernels give bit-exact results compared to the scalar reference kernels.
+/// The component count is not a multiple of the vector width to cover the remainder handling.
+///
+bool verifyKernels()
+{
+	const int count = 3 * 1001;
+	std::vector<std::vector<uint8_t>> frames;
+	for (int frame = 0; frame < WINDOW_FRAMES; ++frame)
+	{
+		frames.push_back(createRandomComponents(count / 3, static_cast<unsigned>(frame)));
+	}
+	const std::vector<float> weights = windowWeights(2.0);
+	const std::vector<int32_t> residuals = [count]() {
+		std::mt19937 generator(7);
+		std::uniform_int_distribution<int32_t> distribution(-static_cast<int32_t>(smoothing::FIXED_ONE / 2), static_cast<int32_t>(smoothing::FIXED_ONE / 2));
+		std::vector<int32_t> values(static_cast<size_t>(count));
+		for (int32_t& value : values)
+		{
+			value = distribution(generator);
+		}
+		return values;
+	}();
+
+	const smoothing::SmoothingKernels& scalar = smoothing::scalarKernels();
+	std::vector<uint32_t> refMeans(static_cast<size_t>(count));
+	interpolate(scalar, frames, weights, refMeans);
+	std::vector<uint8_t> refAssembled(static_cast<size_t>(count));
+	scalar.assemble(refMeans.data(), count, refAssembled.data());
+	std::vector<int32_t> refResiduals = residuals;
+	std::vector<uint8_t> refDithered(static_cast<size_t>(count));
+	scalar.dither(refMeans.data(), refResiduals.data(), count, refDithered.data());
+
+	bool isExact = true;
+	for (const smoothing::SmoothingKernels* kernels : smoothing::availableKernels())
+	{
+		std::vector<uint32_t> means(static_cast<size_t>(count));
+		interpolate(*kernels, frames, weights, means);
+		std::vector<uint8_t> assembled(static_cast<size_t>(count));
+		kernels->assemble(refMeans.data(), count, assembled.data());
+		std::vector<int32_t> kernelResiduals = residuals;
+		std::vector<uint8_t> dithered(static_cast<size_t>(count));
+		kernels->dither(refMeans.data(), kernelResiduals.data(), count, dithered.data());
+
+		bool isStepExact = true;
+		for (float k : {0.0F, 0.01F, 0.3F, 0.5F, 0.77F, 1.0F})
+		{
+			std::vector<uint8_t> refStepped = frames[0];
+			scalar.step(frames[1].data(), count, stepFactor(k), refStepped.data());
+			std::vector<uint8_t> stepped = frames[0];
+			kernels->step(frames[1].data(), count, stepFactor(k), stepped.data());
+			isStepExact = isStepExact && stepped == refStepped;
+		}
+
+		const bool isKernelExact = means == refMeans && assembled == refAssembled && dithered == refDithered && kernelResiduals == refResiduals && isStepExact;
+		std::cout << "Smoothing kernels [" << kernels->name << "]: " << (isKernelExact ? "bit-exact" : "MISMATCH") << '\n';
+		isExact = isExact && isKernelExact;
+	}
+	return isExact;
+}
+
+///
+/// Verify that the fixed point smoothing is equivalent to the floating point implementation within rounding
+///
+bool verifyEquivalence()
+{
+	const int ledCount = 1000;
+	const int count = 3 * ledCount;
+	std::vector<std::vector<uint8_t>> frames;
+	for (int frame = 0; frame < WINDOW_FRAMES; ++frame)
+	{
+		frames.push_back(createRandomComponents(ledCount, static_cast<unsigned>(100 + frame)));
+	}
+
+	const smoothing::SmoothingKernels& kernels = smoothing::smoothingKernels();
+	int maxError = 0;
+	for (double decay : {1.0, 2.0, 5.0})
+	{
+		// the weights of a partially filled and of a full window (exponential decay adds up to more than 1)
+		for (float fill : {0.5F, 2.0F})
+		{
+			std::vector<float> weights = windowWeights(decay);
+			for (float& weight : weights)
+			{
+				weight *= fill;
+			}
+
+			std::vector<float> refMeans(static_cast<size_t>(count));
+			reference::interpolate(frames, weights, refMeans);
+			std::vector<uint32_t> means(static_cast<size_t>(count));
+			interpolate(kernels, frames, weights, means);
+
+			std::vector<uint8_t> refAssembled(static_cast<size_t>(count));
+			reference::assemble(refMeans, refAssembled.data());
+			std::vector<uint8_t> assembled(static_cast<size_t>(count));
+			kernels.assemble(means.data(), count, assembled.data());
+			maxError = std::max(maxError, maxDifference(assembled, refAssembled));
+
+			// the dithered frames deviate by a rounding step at most, the residuals do not drift apart
+			std::vector<float> refResiduals(static_cast<size_t>(count), 0.0F);
+			std::vector<int32_t> residuals(static_cast<size_t>(count), 0);
+			for (int frame = 0; frame < 100; ++frame)
+			{
+				reference::dither(refMeans, refResiduals, refAssembled.data());
+				kernels.dither(means.data(), residuals.data(), count, assembled.data());
+				maxError = std::max(maxError, maxDifference(assembled, refAssembled));
+			}
+		}
+	}
+
+	for (float k : {0.01F, 0.1F, 0.3333F, 0.5F, 0.9F, 1.0F})
+	{
+		std::vector<uint8_t> refStepped = frames[0];
+		reference::step(frames[1], k, refStepped.data());
+		std::vector<uint8_t> stepped = frames[0];
+		kernels.step(frames[1].data(), count, stepFactor(k), stepped.data());
+		maxError = std::max(maxError, maxDifference(stepped, refStepped));
+	}
+
+	const bool isEquivalent = maxError <= 1;
+	std::cout << "Fixed point smoothing [" << kernels.name << "]: max. deviation " << maxError << (isEquivalent ? " (ok)" : " (MISMATCH)") << '\n';
+	return isEquivalent;
+}
+
+template <typename Func>
+void measure(const char* name, int ledCount, int frames, Func func)
+{
+	// Warm-up
+	func();
+
+	QElapsedTimer timer;
+	timer.start();
+	for (int frame = 0; frame < frames; ++frame)
+	{
+		func();
+	}
+	const double frameTime_us = static_cast<double>(timer.nsecsElapsed()) / 1000.0 / frames;
+
+	std::cout << name << " (" << ledCount << " LEDs): " << frameTime_us << " us/frame" << '\n';
+}
+
+void benchmark(int ledCount, int frameCount)
+{
+	const int count = 3 * ledCount;
+	std::vector<std::vector<uint8_t>> frames;
+	for (int frame = 0; frame < WINDOW_FRAMES; ++frame)
+	{
+		frames.push_back(createRandomComponents(ledCount, static_cast<unsigned>(frame)));
+	}
+	const std::vector<float> weights = windowWeights(2.0);
+
+	std::vector<float> refMeans(static_cast<size_t>(count));
+	std::vector<float> refResiduals(static_cast<size_t>(count), 0.0F);
+	std::vector<uint8_t> output(static_cast<size_t>(count));
+	measure("decay, float reference", ledCount, frameCount, [&]() {
+		reference::interpolate(frames, weights, refMeans);
+		reference::dither(refMeans, refResiduals, output.data());
+	});
+
+	std::vector<uint8_t> current = frames[0];
+	measure("linear, float reference", ledCount, frameCount, [&]() {
+		reference::step(frames[1], 0.1F, current.data());
+		current = frames[0];
+	});
+
+	for (const smoothing::SmoothingKernels* kernels : smoothing::availableKernels())
+	{
+		std::vector<uint32_t> means(static_cast<size_t>(count));
+		std::vector<int32_t> residuals(static_cast<size_t>(count), 0);
+		const std::string decayName = std::string("decay, ") + kernels->name;
+		measure(decayName.c_str(), ledCount, frameCount, [&]() {
+			interpolate(*kernels, frames, weights, means);
+			kernels->dither(means.data(), residuals.data(), count, output.data());
+		});
+
+		const std::string linearName = std::string("linear, ") + kernels->name;
+		measure(linearName.c_str(), ledCount, frameCount, [&]() {
+			kernels->step(frames[1].data(), count, stepFactor(0.1F), current.data());
+			current = frames[0];
+		});
+	}
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+	const int frameCount = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 1000;
+
+	if (!verifyKernels() || !verifyEquivalence())
+	{
+		return -1;
+	}
+
+	for (int ledCount : {1000, 10000})
+	{
+		benchmark(ledCount, frameCount);
+	}
+	return 0;
+}
@@ -0,0 +1,119 @@
+// STL includes
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+// Linux includes
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+// Hyperion includes
+#include <leddevice/dev_net/UdpBatchSender.h>
+
+// Test includes
+#include "TestCheck.h"
+
+namespace {
+
+// E1.31 sized packets, 170 RGB LEDs per universe
+constexpr size_t HEADER_SIZE = 126;
+constexpr size_t PAYLOAD_SIZE = 510;
+constexpr size_t UNIVERSES = 40;
+constexpr int FRAMES = 2000;
+
+} // namespace
+
+int main()
+{
+#if defined(__linux__)
+	bool isOk = true;
+
+	const int receiver = socket(AF_INET, SOCK_DGRAM, 0);
+	const int sender = socket(AF_INET, SOCK_DGRAM, 0);
+
+	sockaddr_in address {};
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	socklen_t addressSize = sizeof(address);
+	if (receiver < 0 || sender < 0
+		|| bind(receiver, reinterpret_cast<sockaddr*>(&address), addressSize) != 0
+		|| getsockname(receiver, reinterpret_cast<sockaddr*>(&address), &addressSize) != 0)
+	{
+		std::cout << "no loopback socket available, skipped\n";
+		return 0;
+	}
+
+	// One header per universe, the payloads are slices of a single color buffer
+	std::vector<std::vector<uint8_t>> headers(UNIVERSES, std::vector<uint8_t>(HEADER_SIZE));
+	std::vector<uint8_t> colors(UNIVERSES * PAYLOAD_SIZE);
+	std::vector<UdpBatchSender::Packet> packets(UNIVERSES);
+	for (size_t universe = 0; universe < UNIVERSES; ++universe)
+	{
+		memset(headers[universe].data(), static_cast<int>(universe), HEADER_SIZE);
+		memset(colors.data() + universe * PAYLOAD_SIZE, static_cast<int>(universe + 1), PAYLOAD_SIZE);
+		packets[universe] = { headers[universe].data(), HEADER_SIZE, colors.data() + universe * PAYLOAD_SIZE, PAYLOAD_SIZE };
+	}
+
+	UdpBatchSender batchSender;
+	isOk &= check(batchSender.setDestination(sender, &address, sizeof(address)) && batchSender.isReady(), "destination is set");
+
+	// A batch arrives as datagrams gathered from header and payload
+	isOk &= check(batchSender.send(packets) == UNIVERSES, "batch is sent");
+	std::vector<uint8_t> datagram(HEADER_SIZE + PAYLOAD_SIZE + 1);
+	bool isIntact = true;
+	for (size_t universe = 0; universe < UNIVERSES; ++universe)
+	{
+		const ssize_t size = recv(receiver, datagram.data(), datagram.size(), 0);
+		isIntact &= size == static_cast<ssize_t>(HEADER_SIZE + PAYLOAD_SIZE)
+					&& datagram.front() == universe && datagram[HEADER_SIZE - 1] == universe
+					&& datagram[HEADER_SIZE] == universe + 1 && datagram[HEADER_SIZE + PAYLOAD_SIZE - 1] == universe + 1;
+	}
+	isOk &= check(isIntact, "packets are gathered in order");
+
+	// Packets per second, the receiver drops what does not fit into its buffer
+	std::vector<uint8_t> packetBuffer(HEADER_SIZE + PAYLOAD_SIZE);
+	auto start = std::chrono::steady_clock::now();
+	size_t sentSingle = 0;
+	for (int frame = 0; frame < FRAMES; ++frame)
+	{
+		for (const UdpBatchSender::Packet& packet : packets)
+		{
+			memcpy(packetBuffer.data(), packet.header, packet.headerSize);
+			memcpy(packetBuffer.data() + packet.headerSize, packet.payload, packet.payloadSize);
+			if (sendto(sender, packetBuffer.data(), packetBuffer.size(), 0, reinterpret_cast<sockaddr*>(&address), sizeof(address)) > 0)
+			{
+				++sentSingle;
+			}
+		}
+	}
+	const double singleSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	start = std::chrono::steady_clock::now();
+	size_t sentBatch = 0;
+	for (int frame = 0; frame < FRAMES; ++frame)
+	{
+		sentBatch += batchSender.send(packets);
+	}
+	const double batchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << "sendto per packet: " << static_cast<long>(sentSingle / singleSeconds) << " packets/s\n";
+	std::cout << "sendmmsg per " << UNIVERSES << " universes: " << static_cast<long>(sentBatch / batchSeconds) << " packets/s\n";
+	isOk &= check(sentBatch == sentSingle && sentBatch == UNIVERSES * FRAMES, "all packets are sent");
+
+	batchSender.reset();
+	isOk &= check(!batchSender.isReady() && batchSender.send(packets) == 0, "no batches are sent after reset");
+
+	close(sender);
+	close(receiver);
+
+	return isOk ? 0 : -1;
+#else
+	std::cout << "batches are not supported on this platform, skipped\n";
+	return 0;
+#endif
+}